@@ -0,0 +1,219 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define _GNU_SOURCE
+
+#include "afd.h"
+#include "automates_expression.h"
+#include "bitset.h"
+#include "outils.h"
+
+#include <string.h>
+#include <sys/mman.h>
+
+/*
+ * En dessous de cette taille de table (en transitions), la table tient dans
+ * les caches et afd_reconnait_lot() lit les mots un par un : l'entrelacement
+ * coûte alors plus qu'il ne rapporte.
+ */
+#define TAILLE_MIN_AFD_LOT ( 1 << 18 )
+
+/*
+ * Numéro dense, dans l'Afd, d'un état de l'automate d'origine.
+ */
+int32_t numero_afd( const Afd * afd, int etat ){
+	return indice_dans_tableau( afd->etats, afd->nb_etats - 1, etat ) + 1;
+}
+
+void action_remplir_afd( int origine, char lettre, int fin, void* data ){
+	Afd * afd = (Afd*) data;
+	size_t q = numero_afd( afd, origine );
+	afd->suivant[
+		q * afd->nb_classes + afd->classe[ (unsigned char) lettre ]
+	] = numero_afd( afd, fin ) * afd->nb_classes;
+}
+
+Afd * creer_afd( const Automate * automate ){
+	if( ! est_deterministe( automate ) ) return NULL;
+
+	Afd * afd = xmalloc( sizeof(Afd) );
+	afd->projection = NULL;
+	afd->taille_projection = 0;
+	Ensemble_iterateur it;
+	int n;
+	afd->etats = ensemble_vers_tableau( get_etats( automate ), &n );
+	afd->nb_etats = n + 1;
+
+	// Les lettres équivalentes partagent une colonne ; la classe 0 est celle
+	// des octets qui ne sont pas dans l'alphabet.
+	int classes[256];
+	afd->nb_classes = classes_de_lettres( automate, classes ) + 1;
+	int i;
+	for( i = 0; i < 256; i++ ) afd->classe[i] = (uint16_t) ( classes[i] + 1 );
+
+	size_t taille = (size_t) afd->nb_etats * afd->nb_classes;
+	// Les débuts de ligne sont codés par des int32_t
+	if( taille > INT32_MAX ) ERREUR( "Afd trop grand" );
+	afd->suivant = xmalloc( taille * sizeof(int32_t) );
+	memset( afd->suivant, 0, taille * sizeof(int32_t) );
+	pour_toute_transition( automate, action_remplir_afd, afd );
+
+	size_t nb_mots = BITSET_NB_MOTS( afd->nb_etats );
+	afd->finaux = xmalloc( nb_mots * sizeof(uint64_t) );
+	memset( afd->finaux, 0, nb_mots * sizeof(uint64_t) );
+	for(
+		it = premier_iterateur_ensemble( get_finaux( automate ) );
+		! iterateur_ensemble_est_vide( it );
+		it = iterateur_suivant_ensemble( it )
+	){
+		BITSET_AJOUTER( afd->finaux, numero_afd( afd, get_element( it ) ) );
+	}
+
+	afd->initial = AFD_MORT;
+	it = premier_iterateur_ensemble( get_initiaux( automate ) );
+	if( ! iterateur_ensemble_est_vide( it ) ){
+		afd->initial = numero_afd( afd, get_element( it ) );
+	}
+	return afd;
+}
+
+Afd * creer_afd_expression( const char * expression ){
+	Rationnel * rat = expression_to_rationnel( expression );
+	if( ! rat ) return NULL;
+	Automate * automate = plus_petit_automate( rat, NULL );
+	Automate * deterministe = creer_automate_deterministe( automate );
+	Automate * minimal = creer_automate_minimal( deterministe );
+	Automate * emonde = automate_emonde( minimal );
+	Afd * afd = creer_afd( emonde );
+	liberer_automate( emonde );
+	liberer_automate( minimal );
+	liberer_automate( deterministe );
+	liberer_automate( automate );
+	return afd;
+}
+
+void liberer_afd( Afd * afd ){
+	if( afd->projection ){
+		munmap( afd->projection, afd->taille_projection );
+	}else{
+		xfree( afd->suivant );
+		xfree( afd->finaux );
+		xfree( afd->etats );
+	}
+	xfree( afd );
+}
+
+int32_t afd_lire( const Afd * afd, const char * mot, size_t longueur ){
+	return afd_lire_depuis( afd, afd->initial, mot, longueur );
+}
+
+int32_t afd_lire_depuis(
+	const Afd * afd, int32_t etat, const char * mot, size_t longueur
+){
+	const int32_t * suivant = afd->suivant;
+	const uint16_t * classe = afd->classe;
+	const unsigned char * p = (const unsigned char *) mot;
+	const unsigned char * fin = p + longueur;
+	int32_t ligne = etat * afd->nb_classes;
+	while( p < fin && ligne != AFD_MORT ){
+		ligne = suivant[ ligne + classe[ *p++ ] ];
+	}
+	return ligne / afd->nb_classes;
+}
+
+int afd_reconnait_tampon( const Afd * afd, const char * mot, size_t longueur ){
+	return afd_est_final( afd, afd_lire( afd, mot, longueur ) );
+}
+
+int afd_reconnait( const Afd * afd, const char * mot ){
+	const int32_t * suivant = afd->suivant;
+	const uint16_t * classe = afd->classe;
+	const unsigned char * p = (const unsigned char *) mot;
+	int32_t ligne = afd->initial * afd->nb_classes;
+	while( *p && ligne != AFD_MORT ){
+		ligne = suivant[ ligne + classe[ *p++ ] ];
+	}
+	return afd_est_final( afd, ligne / afd->nb_classes );
+}
+
+void afd_reconnait_lot(
+	const Afd * afd, const char * const * mots, const size_t * longueurs,
+	size_t nb_mots, uint64_t * resultats
+){
+	memset( resultats, 0, BITSET_NB_MOTS( nb_mots ) * sizeof(uint64_t) );
+	size_t i;
+	if( (size_t) afd->nb_etats * afd->nb_classes <= TAILLE_MIN_AFD_LOT ){
+		for( i = 0; i < nb_mots; i++ ){
+			if( afd_reconnait_tampon( afd, mots[i], longueurs[i] ) ){
+				BITSET_AJOUTER( resultats, i );
+			}
+		}
+		return;
+	}
+
+	const int32_t * suivant = afd->suivant;
+	const uint16_t * classe = afd->classe;
+	int32_t m = afd->nb_classes;
+
+	// Place j du lot : le mot indice[j] (ou SIZE_MAX si la place est libre),
+	// dont il reste à lire p[j] ... fin[j]-1, et la ligne de son état
+	const unsigned char * p[AFD_LOT];
+	const unsigned char * fin[AFD_LOT];
+	size_t indice[AFD_LOT];
+	int32_t ligne[AFD_LOT];
+	size_t prochain = 0;
+	int j, nb_occupees = 0;
+	for( j = 0; j < AFD_LOT; j++ ){
+		p[j] = fin[j] = NULL;
+		indice[j] = SIZE_MAX;
+		ligne[j] = AFD_MORT;
+		if( prochain < nb_mots ){
+			p[j] = (const unsigned char *) mots[ prochain ];
+			fin[j] = p[j] + longueurs[ prochain ];
+			indice[j] = prochain++;
+			ligne[j] = afd->initial * m;
+			nb_occupees++;
+		}
+	}
+
+	// Une lettre de chaque mot à tour de rôle
+	while( nb_occupees > 0 ){
+		for( j = 0; j < AFD_LOT; j++ ){
+			if( p[j] < fin[j] ){
+				ligne[j] = suivant[ ligne[j] + classe[ *p[j]++ ] ];
+				if( p[j] < fin[j] && ligne[j] != AFD_MORT ) continue;
+			}else if( indice[j] == SIZE_MAX ){
+				continue;
+			}
+			// Le mot est fini, ou arrivé à l'état mort : il cède sa place
+			if( p[j] == fin[j] && afd_est_final( afd, ligne[j] / m ) ){
+				BITSET_AJOUTER( resultats, indice[j] );
+			}
+			if( prochain < nb_mots ){
+				p[j] = (const unsigned char *) mots[ prochain ];
+				fin[j] = p[j] + longueurs[ prochain ];
+				indice[j] = prochain++;
+				ligne[j] = afd->initial * m;
+			}else{
+				p[j] = fin[j] = NULL;
+				indice[j] = SIZE_MAX;
+				nb_occupees--;
+			}
+		}
+	}
+}
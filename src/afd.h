@@ -0,0 +1,210 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file afd.h */
+
+#ifndef __AFD_H__
+#define __AFD_H__
+
+#include "automate.h"
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief Numéro de l'état mort d'un Afd.
+ *
+ * L'état mort n'est pas final et toutes ses transitions mènent à lui-même :
+ * une fois atteint, on peut arrêter la lecture du mot.
+ */
+#define AFD_MORT 0
+
+/**
+ * @brief Le type d'un automate fini déterministe rangé dans une table dense.
+ *
+ * Les états sont numérotés de 0 à nb_etats-1 : l'état 0 est l'état mort,
+ * et l'état i > 0 correspond à l'état etats[i-1] de l'automate d'origine
+ * (les états d'origine sont rangés dans l'ordre croissant).
+ *
+ * Chaque octet est associé à une classe de lettres par la table 'classe'
+ * (voir classes_de_lettres()) : les lettres de l'alphabet qui se comportent
+ * de la même manière depuis tous les états partagent une colonne de la 
+ * table. La classe 0 regroupe les octets qui ne sont pas dans l'alphabet et
+ * mène toujours à l'état mort. Pour éviter une multiplication par octet lu, la
+ * table 'suivant' contient des débuts de ligne : si la transition de l'état q
+ * par un octet de classe c mène à l'état r, alors
+ *     suivant[ q * nb_classes + c ] == r * nb_classes.
+ *
+ * Les tables d'un Afd chargé par projeter_afd() (voir sauvegarde.h) sont
+ * lues directement dans le fichier projeté en mémoire : 'projection' est
+ * alors l'adresse de la projection, et NULL sinon.
+ *
+ * Un Afd n'est jamais modifié après sa création : il peut être lu par
+ * plusieurs fils d'exécution à la fois.
+ */
+typedef struct Afd {
+	int nb_etats;
+	int nb_classes;
+	int32_t * suivant;
+	uint16_t classe[256];
+	int32_t initial;
+	uint64_t * finaux;
+	int * etats;
+	void * projection;		//!< le fichier projeté qui contient les tables, ou NULL
+	size_t taille_projection;
+} Afd;
+
+/**
+ * @brief Crée l'Afd d'un automate déterministe.
+ *
+ * Renvoie NULL si l'automate n'est pas déterministe (voir
+ * est_deterministe()). Un automate sans état initial donne un Afd dont
+ * l'état initial est l'état mort.
+ *
+ * @param automate Un automate déterministe.
+ * @return L'Afd, ou NULL.
+ */
+Afd * creer_afd( const Automate * automate );
+
+/**
+ * @brief Compile une expression rationnelle en Afd.
+ *
+ * L'expression est traduite par le plus petit des automates d'Antimirov et
+ * des suivants (voir plus_petit_automate()), déterminisée, minimisée puis
+ * émondée. Renvoie NULL si l'expression est mal formée.
+ *
+ * @param expression Une expression rationnelle.
+ * @return L'Afd, ou NULL.
+ */
+Afd * creer_afd_expression( const char * expression );
+
+/**
+ * @brief Libère la mémoire d'un Afd.
+ *
+ * @param afd Un Afd.
+ */
+void liberer_afd( Afd * afd );
+
+/**
+ * @brief Renvoie l'état atteint depuis 'etat' en lisant 'lettre'.
+ *
+ * @param afd Un Afd.
+ * @param etat Un état de l'Afd (numéro dense).
+ * @param lettre Une lettre.
+ */
+static inline int32_t afd_suivant( const Afd * afd, int32_t etat, char lettre ){
+	return afd->suivant[
+		(size_t) etat * afd->nb_classes + afd->classe[ (unsigned char) lettre ]
+	] / afd->nb_classes;
+}
+
+/**
+ * @brief Renvoie 1 si l'état de l'Afd est final et 0 sinon.
+ *
+ * @param afd Un Afd.
+ * @param etat Un état de l'Afd (numéro dense).
+ */
+static inline int afd_est_final( const Afd * afd, int32_t etat ){
+	return ( afd->finaux[ etat / 64 ] >> ( etat % 64 ) ) & 1;
+}
+
+/**
+ * @brief Renvoie l'état atteint depuis l'état initial en lisant les
+ *        'longueur' premiers octets de 'mot'.
+ *
+ * La fonction n'alloue pas de mémoire.
+ *
+ * @param afd Un Afd.
+ * @param mot Un tableau d'octets.
+ * @param longueur Le nombre d'octets à lire.
+ * @return L'état atteint, éventuellement AFD_MORT.
+ */
+int32_t afd_lire( const Afd * afd, const char * mot, size_t longueur );
+
+/**
+ * @brief Renvoie l'état atteint depuis 'etat' en lisant les 'longueur'
+ *        premiers octets de 'mot'.
+ *
+ * Un mot découpé en morceaux peut ainsi être lu morceau par morceau, en
+ * repartant à chaque fois de l'état atteint par le morceau précédent. La
+ * fonction n'alloue pas de mémoire.
+ *
+ * @param afd Un Afd.
+ * @param etat L'état de départ.
+ * @param mot Un tableau d'octets.
+ * @param longueur Le nombre d'octets à lire.
+ * @return L'état atteint, éventuellement AFD_MORT.
+ */
+int32_t afd_lire_depuis(
+	const Afd * afd, int32_t etat, const char * mot, size_t longueur
+);
+
+/**
+ * @brief Renvoie 1 si le mot (terminé par '\0') est reconnu par l'Afd et 0
+ *        sinon.
+ *
+ * La fonction n'alloue pas de mémoire.
+ *
+ * @param afd Un Afd.
+ * @param mot Un mot.
+ */
+int afd_reconnait( const Afd * afd, const char * mot );
+
+/**
+ * @brief Nombre de mots avancés ensemble par afd_reconnait_lot().
+ */
+#define AFD_LOT 16
+
+/**
+ * @brief Teste l'appartenance de chacun des mots d'un lot.
+ *
+ * Le mot i est formé des longueurs[i] premiers octets de mots[i] ; le bit i
+ * de 'resultats' (voir bitset.h) est mis à 1 si le mot i est reconnu et à 0
+ * sinon. 'resultats' doit pouvoir contenir BITSET_NB_MOTS( nb_mots ) mots
+ * de 64 bits.
+ *
+ * Les mots sont lus AFD_LOT à la fois, une lettre de chacun à tour de rôle :
+ * les accès à la table de transitions des différents mots ne dépendent pas
+ * les uns des autres et peuvent être faits en même temps par le processeur.
+ * Dès qu'un mot est fini, ou atteint l'état mort, le mot suivant du lot
+ * prend sa place. Pour les petites tables, qui tiennent dans le cache, les
+ * mots sont simplement lus l'un après l'autre. La fonction n'alloue pas de
+ * mémoire.
+ *
+ * @param afd Un Afd.
+ * @param mots Un tableau de nb_mots tableaux d'octets.
+ * @param longueurs Les longueurs des mots.
+ * @param nb_mots Le nombre de mots.
+ * @param resultats Le tableau de bits des résultats.
+ */
+void afd_reconnait_lot(
+	const Afd * afd, const char * const * mots, const size_t * longueurs,
+	size_t nb_mots, uint64_t * resultats
+);
+
+/**
+ * @brief Renvoie 1 si le mot formé des 'longueur' premiers octets de 'mot'
+ *        est reconnu par l'Afd et 0 sinon.
+ *
+ * @param afd Un Afd.
+ * @param mot Un tableau d'octets.
+ * @param longueur Le nombre d'octets du mot.
+ */
+int afd_reconnait_tampon( const Afd * afd, const char * mot, size_t longueur );
+
+#endif
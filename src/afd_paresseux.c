@@ -0,0 +1,237 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "afd_paresseux.h"
+#include "bitset.h"
+#include "outils.h"
+
+#include <string.h>
+
+#define CAPACITE_INITIALE_PARESSEUX 16
+
+/*
+ * Les ensembles d'états sont internés comme des n-uplets de 2 * nb_mots
+ * entiers : les mots sont d'abord recopiés dans 'nuplet', pour que la table
+ * ne lise jamais un tableau de uint64_t au travers d'un pointeur sur int.
+ */
+#define TAILLE_NUPLET( afd ) ( (int) ( 2 * (afd)->fige->nb_mots ) )
+
+const int * nuplet_paresseux( Afd_paresseux * afd, const uint64_t * ensemble ){
+	memcpy( afd->nuplet, ensemble, afd->fige->nb_mots * sizeof(uint64_t) );
+	return afd->nuplet;
+}
+
+/*
+ * Mémoire allouée pour les états : la table des ensembles et les tableaux
+ * 'suivant' et 'finaux', à leur capacité.
+ */
+size_t memoire_afd_paresseux( const Afd_paresseux * afd ){
+	return memoire_table_sous_ensembles( afd->ensembles )
+		+ (size_t) afd->capacite * ( afd->nb_classes * sizeof(int32_t) + 1 );
+}
+
+/*
+ * Mémoire que la création d'un nouvel état allouerait en plus : celle de la
+ * table, et le doublement de 'suivant' et 'finaux' s'ils sont pleins.
+ */
+size_t cout_etat_paresseux( const Afd_paresseux * afd ){
+	size_t res = memoire_ajout_sous_ensemble( afd->ensembles, TAILLE_NUPLET( afd ) );
+	if( afd->nb_etats == afd->capacite ){
+		res += (size_t) afd->capacite * ( afd->nb_classes * sizeof(int32_t) + 1 );
+	}
+	return res;
+}
+
+/*
+ * Interne l'ensemble d'états et renvoie l'état correspondant, en le créant
+ * s'il n'existait pas.
+ */
+int32_t etat_paresseux( Afd_paresseux * afd, const uint64_t * ensemble ){
+	int nouveau;
+	int32_t id = interner_sous_ensemble(
+		afd->ensembles, nuplet_paresseux( afd, ensemble ), TAILLE_NUPLET( afd ),
+		&nouveau
+	);
+	if( ! nouveau ) return id;
+
+	if( afd->nb_etats == afd->capacite ){
+		afd->capacite *= 2;
+		afd->suivant = xrealloc(
+			afd->suivant,
+			(size_t) afd->capacite * afd->nb_classes * sizeof(int32_t)
+		);
+		afd->finaux = xrealloc( afd->finaux, afd->capacite );
+	}
+	memset(
+		afd->suivant + (size_t) id * afd->nb_classes, 0xff,
+		afd->nb_classes * sizeof(int32_t)
+	);
+	size_t w = afd->fige->nb_mots;
+	size_t i;
+	int final = 0, vide = 1;
+	for( i = 0; i < w; i++ ){
+		if( ensemble[i] & afd->fige->finaux[i] ) final = 1;
+		if( ensemble[i] ) vide = 0;
+	}
+	afd->finaux[id] = final;
+	if( vide ) afd->mort = id;
+	afd->nb_etats++;
+	afd->memoire = memoire_afd_paresseux( afd );
+	return id;
+}
+
+/*
+ * Oublie tous les états et toutes les transitions, puis recrée l'état
+ * initial.
+ */
+void vider_afd_paresseux( Afd_paresseux * afd ){
+	liberer_table_sous_ensembles( afd->ensembles );
+	afd->ensembles = creer_table_sous_ensembles();
+	// Les tableaux reprennent leur capacité initiale
+	afd->capacite = CAPACITE_INITIALE_PARESSEUX;
+	afd->suivant = xrealloc(
+		afd->suivant,
+		(size_t) afd->capacite * afd->nb_classes * sizeof(int32_t)
+	);
+	afd->finaux = xrealloc( afd->finaux, afd->capacite );
+	afd->nb_etats = 0;
+	afd->memoire = memoire_afd_paresseux( afd );
+	afd->mort = -1;
+	afd->nb_vidages++;
+	afd->initial = etat_paresseux( afd, afd->fige->initiaux );
+}
+
+Afd_paresseux * creer_afd_paresseux(
+	const Automate * automate, size_t memoire_max
+){
+	Afd_paresseux * afd = xmalloc( sizeof(Afd_paresseux) );
+	afd->fige = figer_automate( automate );
+
+	// La classe 0 est celle des octets qui ne sont pas dans l'alphabet
+	afd->nb_classes = afd->fige->nb_classes + 1;
+	afd->representant = xmalloc( afd->nb_classes );
+	int i;
+	for( i = 255; i >= 0; i-- ){
+		afd->classe[i] = (uint16_t) ( afd->fige->classe[i] + 1 );
+		afd->representant[ afd->classe[i] ] = (char) i;
+	}
+
+	afd->capacite = CAPACITE_INITIALE_PARESSEUX;
+	afd->suivant = xmalloc(
+		(size_t) afd->capacite * afd->nb_classes * sizeof(int32_t)
+	);
+	afd->finaux = xmalloc( afd->capacite );
+	afd->tampon = xmalloc( ( 2 * afd->fige->nb_mots + 1 ) * sizeof(uint64_t) );
+	afd->nuplet = xmalloc( ( 2 * afd->fige->nb_mots + 1 ) * sizeof(int) );
+	afd->memoire_max = memoire_max;
+	afd->ensembles = creer_table_sous_ensembles();
+	afd->nb_etats = 0;
+	afd->memoire = memoire_afd_paresseux( afd );
+	afd->mort = -1;
+	afd->initial = etat_paresseux( afd, afd->fige->initiaux );
+	remettre_a_zero_compteurs_afd_paresseux( afd );
+	return afd;
+}
+
+void liberer_afd_paresseux( Afd_paresseux * afd ){
+	liberer_automate_fige( afd->fige );
+	liberer_table_sous_ensembles( afd->ensembles );
+	xfree( afd->representant );
+	xfree( afd->suivant );
+	xfree( afd->finaux );
+	xfree( afd->tampon );
+	xfree( afd->nuplet );
+	xfree( afd );
+}
+
+void remettre_a_zero_compteurs_afd_paresseux( Afd_paresseux * afd ){
+	afd->nb_succes = 0;
+	afd->nb_echecs = 0;
+	afd->nb_vidages = 0;
+}
+
+/*
+ * Calcule, sur l'automate figé, la transition de l'état q par la classe c
+ * et la range dans la table. Si le nouvel état dépasse la mémoire permise,
+ * la table est vidée et q est recréé avant d'ajouter la transition.
+ */
+int32_t calculer_transition_paresseuse( Afd_paresseux * afd, int32_t q, int c ){
+	size_t w = afd->fige->nb_mots;
+	uint64_t * depart = afd->tampon;
+	uint64_t * arrivee = afd->tampon + w;
+	int taille;
+
+	afd->nb_echecs++;
+	// get_sous_ensemble() n'est valable que jusqu'au prochain internement
+	memcpy( depart, get_sous_ensemble( afd->ensembles, q, &taille ), w * sizeof(uint64_t) );
+	if( c == 0 ){
+		memset( arrivee, 0, w * sizeof(uint64_t) );
+	}else{
+		delta_fige( afd->fige, depart, afd->representant[c], arrivee );
+	}
+
+	if(
+		afd->memoire + cout_etat_paresseux( afd ) > afd->memoire_max &&
+		trouver_sous_ensemble(
+			afd->ensembles, nuplet_paresseux( afd, arrivee ), TAILLE_NUPLET( afd )
+		) < 0
+	){
+		vider_afd_paresseux( afd );
+		q = etat_paresseux( afd, depart );
+	}
+	int32_t r = etat_paresseux( afd, arrivee );
+	afd->suivant[ (size_t) q * afd->nb_classes + c ] = r;
+	return r;
+}
+
+int32_t afd_paresseux_suivant( Afd_paresseux * afd, int32_t etat, char lettre ){
+	int c = afd->classe[ (unsigned char) lettre ];
+	int32_t r = afd->suivant[ (size_t) etat * afd->nb_classes + c ];
+	if( r == AFD_PARESSEUX_INCONNU ){
+		return calculer_transition_paresseuse( afd, etat, c );
+	}
+	afd->nb_succes++;
+	return r;
+}
+
+int afd_paresseux_est_final( const Afd_paresseux * afd, int32_t etat ){
+	return afd->finaux[etat];
+}
+
+int afd_paresseux_reconnait_tampon(
+	Afd_paresseux * afd, const char * mot, size_t longueur
+){
+	const unsigned char * p = (const unsigned char *) mot;
+	const unsigned char * fin = p + longueur;
+	int32_t q = afd->initial;
+	for( ; p < fin && q != afd->mort; p++ ){
+		int c = afd->classe[ *p ];
+		int32_t r = afd->suivant[ (size_t) q * afd->nb_classes + c ];
+		if( r == AFD_PARESSEUX_INCONNU ){
+			r = calculer_transition_paresseuse( afd, q, c );
+		}else{
+			afd->nb_succes++;
+		}
+		q = r;
+	}
+	return afd->finaux[q];
+}
+
+int afd_paresseux_reconnait( Afd_paresseux * afd, const char * mot ){
+	return afd_paresseux_reconnait_tampon( afd, mot, strlen( mot ) );
+}
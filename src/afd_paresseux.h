@@ -0,0 +1,157 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file afd_paresseux.h */
+
+#ifndef __AFD_PARESSEUX_H__
+#define __AFD_PARESSEUX_H__
+
+#include "automate.h"
+#include "automate_fige.h"
+#include "sous_ensembles.h"
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief Valeur d'une transition de l'Afd paresseux qui n'a pas encore été
+ *        calculée.
+ */
+#define AFD_PARESSEUX_INCONNU -1
+
+/**
+ * @brief Le type d'un automate déterministe construit à la demande.
+ *
+ * Les états de l'Afd paresseux sont des ensembles d'états de l'automate
+ * (figé) d'origine, internés dans une Table_sous_ensembles : l'état i est le
+ * i-ème ensemble interné. Un état n'est créé que lorsqu'un mot l'atteint
+ * pour la première fois, et chaque transition calculée est gardée dans la
+ * table 'suivant' :
+ *     suivant[ i * nb_classes + c ]
+ * est l'état atteint depuis i par une lettre de classe c, ou
+ * AFD_PARESSEUX_INCONNU. Comme pour un Afd, la classe 0 regroupe les octets
+ * qui ne sont pas dans l'alphabet.
+ *
+ * La mémoire des états est celle réellement allouée : la table des
+ * ensembles et les tableaux 'suivant' et 'finaux', à leur capacité. Avant
+ * chaque création d'état, on calcule ce qu'elle deviendrait (doublements
+ * compris) ; lorsqu'elle dépasserait 'memoire_max', toutes les transitions
+ * et tous les états sont oubliés, les tableaux reprennent leur taille
+ * initiale, et la construction reprend depuis l'état courant.
+ *
+ * Les compteurs nb_succes, nb_echecs et nb_vidages comptent respectivement
+ * les transitions trouvées dans la table, les transitions calculées sur
+ * l'automate d'origine et les vidages de la table.
+ *
+ * Un Afd paresseux est modifié par chaque lecture : il ne doit pas être lu
+ * par plusieurs fils d'exécution à la fois.
+ */
+typedef struct Afd_paresseux {
+	Automate_fige * fige;
+	int nb_classes;
+	uint16_t classe[256];
+	char * representant;		//!< une lettre de chaque classe
+	Table_sous_ensembles * ensembles;
+	int nb_etats;
+	int capacite;
+	int32_t * suivant;
+	char * finaux;
+	int32_t initial;
+	int32_t mort;				//!< l'ensemble vide, ou -1
+	uint64_t * tampon;
+	int * nuplet;				//!< copie en entiers d'un ensemble, pour la table
+	size_t memoire;
+	size_t memoire_max;
+	uint64_t nb_succes;
+	uint64_t nb_echecs;
+	uint64_t nb_vidages;
+} Afd_paresseux;
+
+/**
+ * @brief Crée un Afd paresseux qui reconnaît le langage de l'automate.
+ *
+ * Seul l'état initial est construit. L'Afd paresseux ne dépend pas de
+ * l'automate passé en paramètre, qui peut ensuite être modifié ou libéré.
+ *
+ * @param automate Un automate, déterministe ou non.
+ * @param memoire_max La mémoire, en octets, que peuvent occuper les états
+ *        avant que la table ne soit vidée.
+ * @return L'Afd paresseux.
+ */
+Afd_paresseux * creer_afd_paresseux(
+	const Automate * automate, size_t memoire_max
+);
+
+/**
+ * @brief Libère la mémoire d'un Afd paresseux.
+ *
+ * @param afd Un Afd paresseux.
+ */
+void liberer_afd_paresseux( Afd_paresseux * afd );
+
+/**
+ * @brief Renvoie 1 si le mot (terminé par '\0') est reconnu et 0 sinon.
+ *
+ * @param afd Un Afd paresseux.
+ * @param mot Un mot.
+ */
+int afd_paresseux_reconnait( Afd_paresseux * afd, const char * mot );
+
+/**
+ * @brief Renvoie 1 si le mot formé des 'longueur' premiers octets de 'mot'
+ *        est reconnu et 0 sinon.
+ *
+ * @param afd Un Afd paresseux.
+ * @param mot Un tableau d'octets.
+ * @param longueur Le nombre d'octets du mot.
+ */
+int afd_paresseux_reconnait_tampon(
+	Afd_paresseux * afd, const char * mot, size_t longueur
+);
+
+/**
+ * @brief Renvoie l'état atteint depuis 'etat' en lisant 'lettre', en
+ *        calculant la transition si elle n'est pas encore connue.
+ *
+ * Si la table est vidée pendant le calcul, les numéros des états changent :
+ * seul l'état renvoyé reste valable. Avec une mémoire maximale suffisante
+ * (par exemple SIZE_MAX), la table n'est jamais vidée et les numéros des
+ * états ne changent pas.
+ *
+ * @param afd Un Afd paresseux.
+ * @param etat Un état de l'Afd paresseux.
+ * @param lettre Une lettre.
+ */
+int32_t afd_paresseux_suivant( Afd_paresseux * afd, int32_t etat, char lettre );
+
+/**
+ * @brief Renvoie 1 si l'état de l'Afd paresseux est final et 0 sinon.
+ *
+ * @param afd Un Afd paresseux.
+ * @param etat Un état de l'Afd paresseux.
+ */
+int afd_paresseux_est_final( const Afd_paresseux * afd, int32_t etat );
+
+/**
+ * @brief Remet à zéro les compteurs de l'Afd paresseux.
+ *
+ * @param afd Un Afd paresseux.
+ */
+void remettre_a_zero_compteurs_afd_paresseux( Afd_paresseux * afd );
+
+#endif
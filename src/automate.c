@@ -22,7 +22,7 @@
 #include "table.h"
 #include "ensemble.h"
 #include "outils.h"
-#include "fifo.h"
+#include "sous_ensembles.h"
 
 #include <search.h>
 #include <stdio.h>
@@ -32,8 +32,6 @@
 
 #include <assert.h>
 
-#include <math.h>
-
 void action_get_max_etat( const intptr_t element, void* data ){
 	int * max = (int*) data;
 	if( *max < element ) *max = element;
@@ -61,65 +59,43 @@ int get_min_etat( const Automate* automate ){
 }
 
 
-int comparer_cle(const Cle *a, const Cle *b) {
-	if( a->origine < b->origine )
-		return -1;
-	if( a->origine > b->origine )
-		return 1;
-	if( a->lettre < b->lettre )
-		return -1;
-	if( a->lettre > b->lettre )
-		return 1;
-	return 0;
-}
-
-void print_cle( const Cle * a){
-	printf( "(%d, %c)" , a->origine, (char) (a->lettre) );
-}
-
-void supprimer_cle( Cle* cle ){
-	xfree( cle );
-}
-
-void initialiser_cle( Cle* cle, int origine, char lettre ){
-	cle->origine = origine;
-	cle->lettre = (int) lettre;
-}
-
-Cle * creer_cle( int origine, char lettre ){
-	Cle * result = xmalloc( sizeof(Cle) );
-	initialiser_cle( result, origine, lettre );
-	return result;
-}
-
-Cle * copier_cle( const Cle* cle ){
-	return creer_cle( cle->origine, cle->lettre );
-}
-
 Automate * creer_automate(){
 	Automate * automate = xmalloc( sizeof(Automate) );
 	automate->etats = creer_ensemble( NULL, NULL, NULL );
 	automate->alphabet = creer_ensemble( NULL, NULL, NULL );
-	automate->transitions = creer_table(
-		( int(*)(const intptr_t, const intptr_t) ) comparer_cle , 
-		( intptr_t (*)( const intptr_t ) ) copier_cle,
-		( void(*)(intptr_t) ) supprimer_cle
+	automate->numeros = creer_table_sous_ensembles();
+	automate->capacite_adjacences = 16;
+	automate->adjacences = xmalloc(
+		automate->capacite_adjacences * sizeof(Adjacence)
 	);
+	automate->adjacences_en_ordre = 1;
+	automate->index_inverse = 0;
 	automate->initiaux = creer_ensemble( NULL, NULL, NULL );
 	automate->finaux = creer_ensemble( NULL, NULL, NULL );
 	automate->vide = creer_ensemble( NULL, NULL, NULL ); 
 	return automate;
 }
 
+void liberer_liste_transitions( Liste_transitions * liste ){
+	int i;
+	for( i = 0; i < liste->nb; i++ ){
+		liberer_ensemble( liste->transitions[i].etats );
+	}
+	xfree( liste->transitions );
+}
+
 void liberer_automate( Automate * automate ){
 	assert( automate );
 	liberer_ensemble( automate->vide );
 	liberer_ensemble( automate->finaux );
 	liberer_ensemble( automate->initiaux );
-	pour_toute_valeur_table(
-		automate->transitions, ( void(*)(intptr_t) ) liberer_ensemble
-	);
-	liberer_table( automate->transitions );
+	int i;
+	for( i = 0; i < nombre_de_sous_ensembles( automate->numeros ); i++ ){
+		liberer_liste_transitions( &( automate->adjacences[i].sortantes ) );
+		liberer_liste_transitions( &( automate->adjacences[i].entrantes ) );
+	}
+	xfree( automate->adjacences );
+	liberer_table_sous_ensembles( automate->numeros );
 	liberer_ensemble( automate->alphabet );
 	liberer_ensemble( automate->etats );
 	xfree(automate);
@@ -149,6 +125,83 @@ void ajouter_lettre( Automate * automate, char lettre ){
 	ajouter_element( automate->alphabet, lettre );
 }
 
+/*
+ * Renvoie l'adjacence de l'état, ou NULL si l'état n'en a pas encore.
+ */
+Adjacence * trouver_adjacence( const Automate * automate, int etat ){
+	int id = trouver_sous_ensemble( automate->numeros, &etat, 1 );
+	if( id < 0 ) return NULL;
+	return &( automate->adjacences[id] );
+}
+
+/*
+ * Renvoie l'adjacence de l'état, en la créant si besoin.
+ */
+Adjacence * adjacence( Automate * automate, int etat ){
+	int nouveau;
+	int id = interner_sous_ensemble( automate->numeros, &etat, 1, &nouveau );
+	if( nouveau ){
+		if( id == automate->capacite_adjacences ){
+			automate->capacite_adjacences *= 2;
+			automate->adjacences = xrealloc(
+				automate->adjacences,
+				automate->capacite_adjacences * sizeof(Adjacence)
+			);
+		}
+		if( id > 0 && automate->adjacences[id-1].etat > etat ){
+			automate->adjacences_en_ordre = 0;
+		}
+		Adjacence * adj = &( automate->adjacences[id] );
+		adj->etat = etat;
+		adj->sortantes.transitions = NULL;
+		adj->sortantes.nb = 0;
+		adj->sortantes.capacite = 0;
+		adj->entrantes = adj->sortantes;
+	}
+	return &( automate->adjacences[id] );
+}
+
+/*
+ * Renvoie la position de la lettre dans la liste si elle y est, et sinon
+ * -1 - p, où p est la position où il faudrait l'insérer.
+ */
+int chercher_lettre( const Liste_transitions * liste, int lettre ){
+	int debut = 0, fin = liste->nb;
+	while( debut < fin ){
+		int milieu = ( debut + fin ) / 2;
+		int l = liste->transitions[milieu].lettre;
+		if( l == lettre ) return milieu;
+		if( l < lettre ) debut = milieu + 1;
+		else fin = milieu;
+	}
+	return -1 - debut;
+}
+
+/*
+ * Ajoute 'etat' à l'ensemble associé à 'lettre' dans la liste.
+ */
+void ajouter_dans_liste( Liste_transitions * liste, int lettre, int etat ){
+	int i = chercher_lettre( liste, lettre );
+	if( i < 0 ){
+		i = -1 - i;
+		if( liste->nb == liste->capacite ){
+			liste->capacite = liste->capacite ? 2 * liste->capacite : 2;
+			liste->transitions = xrealloc(
+				liste->transitions,
+				liste->capacite * sizeof(Transitions_lettre)
+			);
+		}
+		memmove(
+			liste->transitions + i + 1, liste->transitions + i,
+			( liste->nb - i ) * sizeof(Transitions_lettre)
+		);
+		liste->transitions[i].lettre = lettre;
+		liste->transitions[i].etats = creer_ensemble( NULL, NULL, NULL );
+		liste->nb++;
+	}
+	ajouter_element( liste->transitions[i].etats, etat );
+}
+
 void ajouter_transition(
 	Automate * automate, int origine, char lettre, int fin
 ){
@@ -156,23 +209,20 @@ void ajouter_transition(
 	ajouter_etat( automate, fin );
 	ajouter_lettre( automate, lettre );
 
-	Cle cle;
-	initialiser_cle( &cle, origine, lettre );
-	Table_iterateur it = trouver_table( automate->transitions, (intptr_t) &cle );
-	Ensemble * ens;
-	if( iterateur_est_vide( it ) ){
-		ens = creer_ensemble( NULL, NULL, NULL );
-		add_table( automate->transitions, (intptr_t) &cle, (intptr_t) ens );
-	}else{
-		ens = (Ensemble*) get_valeur( it );
+	ajouter_dans_liste(
+		&( adjacence( automate, origine )->sortantes ), lettre, fin
+	);
+	Adjacence * arrivee = adjacence( automate, fin );
+	if( automate->index_inverse ){
+		ajouter_dans_liste( &( arrivee->entrantes ), lettre, origine );
 	}
-	ajouter_element( ens, fin );
 }
 
 void ajouter_etat_final(
 	Automate * automate, int etat_final
 ){
 	ajouter_etat( automate, etat_final );
+	adjacence( automate, etat_final );
 	ajouter_element( automate->finaux, etat_final );
 }
 
@@ -180,18 +230,90 @@ void ajouter_etat_initial(
 	Automate * automate, int etat_initial
 ){
 	ajouter_etat( automate, etat_initial );
+	adjacence( automate, etat_initial );
 	ajouter_element( automate->initiaux, etat_initial );
 }
 
+const Ensemble * chercher_dans_liste(
+	const Automate * automate, const Liste_transitions * liste, char lettre
+){
+	int i = chercher_lettre( liste, lettre );
+	if( i < 0 ) return automate->vide;
+	return liste->transitions[i].etats;
+}
+
 const Ensemble * voisins( const Automate* automate, int origine, char lettre ){
-	Cle cle;
-	initialiser_cle( &cle, origine, lettre );
-	Table_iterateur it = trouver_table( automate->transitions, (intptr_t) &cle );
-	if( ! iterateur_est_vide( it ) ){
-		return (Ensemble*) get_valeur( it );
-	}else{
-		return automate->vide;
+	const Adjacence * adj = trouver_adjacence( automate, origine );
+	if( ! adj ) return automate->vide;
+	return chercher_dans_liste( automate, &( adj->sortantes ), lettre );
+}
+
+void activer_index_inverse( Automate * automate ){
+	if( automate->index_inverse ) return;
+	automate->index_inverse = 1;
+	int n = nombre_de_sous_ensembles( automate->numeros );
+	int id, i;
+	// Les adjacences créées pendant le parcours sont ajoutées à la fin et
+	// n'ont pas de transitions sortantes.
+	for( id = 0; id < n; id++ ){
+		int origine = automate->adjacences[id].etat;
+		for( i = 0; i < automate->adjacences[id].sortantes.nb; i++ ){
+			Transitions_lettre tl = automate->adjacences[id].sortantes.transitions[i];
+			Ensemble_iterateur it;
+			for(
+				it = premier_iterateur_ensemble( tl.etats );
+				! iterateur_ensemble_est_vide( it );
+				it = iterateur_suivant_ensemble( it )
+			){
+				ajouter_dans_liste(
+					&( adjacence( automate, get_element( it ) )->entrantes ),
+					tl.lettre, origine
+				);
+			}
+		}
+	}
+}
+
+Automate * creer_automate_etats_consecutifs( int nb_etats ){
+	Automate * automate = creer_automate();
+	if( nb_etats > automate->capacite_adjacences ){
+		automate->capacite_adjacences = nb_etats;
+		automate->adjacences = xrealloc(
+			automate->adjacences,
+			automate->capacite_adjacences * sizeof(Adjacence)
+		);
+	}
+	int q;
+	for( q = 0; q < nb_etats; q++ ){
+		ajouter_etat( automate, q );
+		adjacence( automate, q );
+	}
+	return automate;
+}
+
+void remplir_etat_automate(
+	Automate * automate, int etat, int nb, const char * lettres, const int * fins
+){
+	Liste_transitions * liste = &( automate->adjacences[etat].sortantes );
+	assert( liste->nb == 0 && ! automate->index_inverse );
+	liste->transitions = xrealloc(
+		liste->transitions, ( nb + 1 ) * sizeof(Transitions_lettre)
+	);
+	liste->capacite = nb + 1;
+	int i;
+	for( i = 0; i < nb; i++ ){
+		liste->transitions[i].lettre = lettres[i];
+		liste->transitions[i].etats = creer_ensemble( NULL, NULL, NULL );
+		ajouter_element( liste->transitions[i].etats, fins[i] );
 	}
+	liste->nb = nb;
+}
+
+const Ensemble * predecesseurs( const Automate* automate, int fin, char lettre ){
+	assert( automate->index_inverse );
+	const Adjacence * adj = trouver_adjacence( automate, fin );
+	if( ! adj ) return automate->vide;
+	return chercher_dans_liste( automate, &( adj->entrantes ), lettre );
 }
 
 Ensemble * delta(
@@ -229,29 +351,76 @@ Ensemble * delta_star(
 	return new;
 }
 
+/*
+ * Un état et le numéro de son adjacence.
+ */
+typedef struct {
+	int etat;
+	int id;
+} Etat_numerote;
+
+int comparer_etats_numerotes( const void * a, const void * b ){
+	const Etat_numerote * x = (const Etat_numerote *) a;
+	const Etat_numerote * y = (const Etat_numerote *) b;
+	if( x->etat != y->etat ) return ( x->etat > y->etat ) ? 1 : -1;
+	return ( x->id > y->id ) - ( x->id < y->id );
+}
+
+/*
+ * Renvoie le tableau des numéros d'adjacence, rangés par état croissant.
+ */
+int * adjacences_triees( const Automate * automate ){
+	int n = nombre_de_sous_ensembles( automate->numeros );
+	int * ordre = xmalloc( ( n + 1 ) * sizeof(int) );
+	int id;
+	for( id = 0; id < n; id++ ) ordre[id] = id;
+	if( ! automate->adjacences_en_ordre ){
+		// On trie les couples (état, numéro) puis on garde les numéros.
+		Etat_numerote * couples = xmalloc( ( n + 1 ) * sizeof(Etat_numerote) );
+		for( id = 0; id < n; id++ ){
+			couples[id].etat = automate->adjacences[id].etat;
+			couples[id].id = id;
+		}
+		qsort( couples, n, sizeof(Etat_numerote), comparer_etats_numerotes );
+		for( id = 0; id < n; id++ ) ordre[id] = couples[id].id;
+		xfree( couples );
+	}
+	return ordre;
+}
+
 void pour_toute_transition(
 	const Automate* automate,
 	void (* action )( int origine, char lettre, int fin, void* data ),
 	void* data
 ){
-	Table_iterateur it1;
-	Ensemble_iterateur it2;
-	for(
-		it1 = premier_iterateur_table( automate->transitions );
-		! iterateur_est_vide( it1 );
-		it1 = iterateur_suivant_table( it1 )
-	){
-		Cle * cle = (Cle*) get_cle( it1 );
-		Ensemble * fins = (Ensemble*) get_valeur( it1 );
-		for(
-			it2 = premier_iterateur_ensemble( fins );
-			! iterateur_ensemble_est_vide( it2 );
-			it2 = iterateur_suivant_ensemble( it2 )
-		){
-			int fin = get_element( it2 );
-			action( cle->origine, cle->lettre, fin, data );
+	Ensemble_iterateur it;
+	int * ordre = adjacences_triees( automate );
+	int n = nombre_de_sous_ensembles( automate->numeros );
+	int k, i;
+	for( k = 0; k < n; k++ ){
+		const Adjacence * adj = &( automate->adjacences[ ordre[k] ] );
+		for( i = 0; i < adj->sortantes.nb; i++ ){
+			const Transitions_lettre * tl = &( adj->sortantes.transitions[i] );
+			for(
+				it = premier_iterateur_ensemble( tl->etats );
+				! iterateur_ensemble_est_vide( it );
+				it = iterateur_suivant_ensemble( it )
+			){
+				action( adj->etat, (char) tl->lettre, get_element( it ), data );
+			}
 		}
-	};
+	}
+	xfree( ordre );
+}
+
+void action_copier_transition( int origine, char lettre, int fin, void* data ){
+	ajouter_transition( (Automate*) data, origine, lettre, fin );
+}
+
+void action_copier_transition_miroir(
+	int origine, char lettre, int fin, void* data
+){
+	ajouter_transition( (Automate*) data, fin, lettre, origine );
 }
 
 Automate* copier_automate( const Automate* automate ){
@@ -290,209 +459,506 @@ Automate* copier_automate( const Automate* automate ){
 		ajouter_lettre( res, (char) get_element( it1 ) );
 	}
 	// On ajoute les transitions
-	Table_iterateur it2;
-	for(
-		it2 = premier_iterateur_table( automate->transitions );
-		! iterateur_est_vide( it2 );
-		it2 = iterateur_suivant_table( it2 )
-	){
-		Cle * cle = (Cle*) get_cle( it2 );
-		Ensemble * fins = (Ensemble*) get_valeur( it2 );
-		for(
-			it1 = premier_iterateur_ensemble( fins );
-			! iterateur_ensemble_est_vide( it1 );
-			it1 = iterateur_suivant_ensemble( it1 )
-		){
-			int fin = get_element( it1 );
-			ajouter_transition( res, cle->origine, cle->lettre, fin );
-		}
-	}
+	pour_toute_transition( automate, action_copier_transition, res );
 	return res;
 }
 
 /*
- *                         x = 0
- *                          |
- *                          V
- * 
- * 283 237 195 157 123  93  67  91 119 151 187 227 271 
- * 238 196 158 124  94  68  46  66  90 118 150 186 226 
- * 197 159 125  95  69  47  29  45  65  89 117 149 185 
- * 160 126  96  70  48  30  16  28  44  64  88 116 148 
- * 127  97  71  49  31  17   7  15  27  43  63  87 115 
- *  98  72  50  32  18   8   2   6  14  26  42  62  86 
- *  73  51  33  19   9   3   0   1   5  13  25  41  61  <- y = 0
- * 100  74  52  34  20  10   4  12  24  40  60  84 112 
- * 131 101  75  53  35  21  11  23  39  59  83 111 143 
- * 166 132 102  76  54  36  22  38  58  82 110 142 178 
- * 205 167 133 103  77  55  37  57  81 109 141 177 217 
- * 248 206 168 134 104  78  56  80 108 140 176 216 260 
- * 295 249 207 169 135 105  79 107 139 175 215 259 307
- * 
+ * Transitions d'un automate dont les états sont renumérotés de 0 à n-1 (dans
+ * l'ordre croissant) et les lettres de 0 à m-1.
+ * Les transitions de l'état q sont rangées, par lettre croissante, aux 
+ * indices debut[q] ... debut[q+1]-1 des tableaux 'lettre' et 'fin'.
  */
-int couple_to_int( int q1, int q2 ){
-	if(q1==0 && q2==0) return 0;
-	int sum = abs(q1) + abs(q2);
-	int prev = 2*sum*(sum-1);
-	if( q1 > 0 && q2 >= 0 ) return prev + 1 + q2;
-	if( q1 <= 0 && q2 > 0 ) return prev + sum+1 + (-q1);
-	if( q1 < 0 && q2 <= 0 ) return prev + 2*sum+ 1 + (-q2);
-	return prev + 3*sum+ 1 + q1; //cas q1>=0 && q2<0 
-}
-
-void int_to_couple( int entree, int * q1, int * q2 ){
-	if( entree == 0 ){
-		*q1 = 0;
-		*q2 = 0;
-		return;
-	}
-	entree -= 1;
-	int sum = (int) floor( ( 1+ sqrt( 1 + 2.0*entree ) )/2.0 );
-	int couche = entree - 2*sum*(sum-1);
-	int r = couche % sum;
-	int s = sum-r;
-	switch( couche/sum ){ 
-		case 0:
-			*q2=r;
-			*q1=s;
-			break;
-		case 1:
-			*q1=-r;
-			*q2=s;
-			break;
-		case 2:
-			*q2 = -r;
-			*q1=-s;
-			break;
-		case 3:
-			*q1 = r;
-			*q2=-s;
-			break;
-		default:
-			ERREUR("Impossible !");
-	}
+typedef struct {
+	int nb_etats;
+	int * etats;
+	int nb_lettres;
+	int * lettres;
+	int indice_lettre[256];
+	int nb_transitions;
+	int * debut;
+	int * lettre;
+	int * fin;
+	char * final;
+} Transitions_denses;
+
+void action_compter_transitions_denses(
+	int origine, char lettre, int fin, void* data
+){
+	Transitions_denses * t = (Transitions_denses*) data;
+	t->debut[ indice_dans_tableau( t->etats, t->nb_etats, origine ) + 1 ]++;
 }
 
-Automate * creer_intersection_des_automates(
-	const Automate * automate_1, const Automate * automate_2
+void action_remplir_transitions_denses(
+	int origine, char lettre, int fin, void* data
 ){
-	Automate * res = creer_automate();
+	Transitions_denses * t = (Transitions_denses*) data;
+	int q = indice_dans_tableau( t->etats, t->nb_etats, origine );
+	// pour_toute_transition() parcourt les transitions par origine, puis
+	// par lettre croissante : debut[q] sert de curseur de remplissage.
+	int k = t->debut[q]++;
+	t->lettre[k] = t->indice_lettre[ (unsigned char) lettre ];
+	t->fin[k] = indice_dans_tableau( t->etats, t->nb_etats, fin );
+}
 
-	// On engendre tous les couples et on les ajoute dans l'automate
-	Ensemble_iterateur it_etat_1;
-	Ensemble_iterateur it_etat_2;
-	Ensemble_iterateur it_lettre;
-	for(
-		it_etat_1 = premier_iterateur_ensemble( get_etats( automate_1 ) );
-		! iterateur_ensemble_est_vide( it_etat_1 );
-		it_etat_1 = iterateur_suivant_ensemble( it_etat_1 )
-	){
-		int q1 = get_element( it_etat_1 );
-		for(
-			it_etat_2 = premier_iterateur_ensemble( get_etats( automate_2 ) );
-			! iterateur_ensemble_est_vide( it_etat_2 );
-			it_etat_2 = iterateur_suivant_ensemble( it_etat_2 )
-		){
-			int q2 = get_element( it_etat_2 );
-			ajouter_etat( res, couple_to_int( q1, q2 ) );
-		}
+Transitions_denses * creer_transitions_denses( const Automate* automate ){
+	Transitions_denses * t = xmalloc( sizeof(Transitions_denses) );
+	int i;
+	t->etats = ensemble_vers_tableau( get_etats( automate ), &t->nb_etats );
+	t->lettres = ensemble_vers_tableau( get_alphabet( automate ), &t->nb_lettres );
+	for( i = 0; i < 256; i++ ) t->indice_lettre[i] = -1;
+	for( i = 0; i < t->nb_lettres; i++ ){
+		t->indice_lettre[ (unsigned char) t->lettres[i] ] = i;
+	}
+	t->final = xmalloc( t->nb_etats + 1 );
+	for( i = 0; i < t->nb_etats; i++ ){
+		t->final[i] = est_un_etat_final_de_l_automate( automate, t->etats[i] );
 	}
 
-	// On engendre tous les couples d'états initiaux :
-	for(
-		it_etat_1 = premier_iterateur_ensemble( get_initiaux( automate_1 ) );
-		! iterateur_ensemble_est_vide( it_etat_1 );
-		it_etat_1 = iterateur_suivant_ensemble( it_etat_1 )
-	){
-		int q1 = get_element( it_etat_1 );
-		for(
-			it_etat_2 = premier_iterateur_ensemble( get_initiaux( automate_2 ) );
-			! iterateur_ensemble_est_vide( it_etat_2 );
-			it_etat_2 = iterateur_suivant_ensemble( it_etat_2 )
-		){
-			int q2 = get_element( it_etat_2 );
-			ajouter_etat_initial( 
-				res, couple_to_int( q1, q2 )
+	t->debut = xmalloc( ( t->nb_etats + 2 ) * sizeof(int) );
+	for( i = 0; i < t->nb_etats + 2; i++ ) t->debut[i] = 0;
+	pour_toute_transition( automate, action_compter_transitions_denses, t );
+	for( i = 0; i < t->nb_etats; i++ ) t->debut[i+1] += t->debut[i];
+	t->nb_transitions = t->debut[ t->nb_etats ];
+	t->lettre = xmalloc( ( t->nb_transitions + 1 ) * sizeof(int) );
+	t->fin = xmalloc( ( t->nb_transitions + 1 ) * sizeof(int) );
+	pour_toute_transition( automate, action_remplir_transitions_denses, t );
+	// Les curseurs ont avancé d'un cran : on décale les débuts.
+	for( i = t->nb_etats; i > 0; i-- ) t->debut[i] = t->debut[i-1];
+	t->debut[0] = 0;
+	return t;
+}
+
+void liberer_transitions_denses( Transitions_denses * t ){
+	xfree( t->etats );
+	xfree( t->lettres );
+	xfree( t->final );
+	xfree( t->debut );
+	xfree( t->lettre );
+	xfree( t->fin );
+	xfree( t );
+}
+
+/*
+ * Classes de lettres d'un automate.
+ *
+ * Deux lettres sont équivalentes si, depuis chaque état, elles mènent au même
+ * ensemble d'états. Les classes sont obtenues en raffinant la partition 
+ * triviale de l'alphabet état par état : depuis l'état q, les lettres d'une
+ * même classe sont séparées selon l'ensemble (interné) de leurs fins ; une
+ * lettre sans transition depuis q garde sa classe.
+ *
+ * Les classes sont ensuite numérotées dans l'ordre de leur plus petite 
+ * lettre, qui est leur représentant. Les lettres de la classe c sont les
+ * lettres[ debut[c] ] ... lettres[ debut[c+1]-1 ] (indices de lettres de 
+ * Transitions_denses, dans l'ordre croissant).
+ */
+typedef struct {
+	int nb_classes;
+	int * classe;
+	int * debut;
+	int * lettres;
+} Classes_de_lettres;
+
+typedef struct {
+	int classe;
+	int ensemble;
+	int lettre;
+} Lettre_touchee;
+
+int comparer_lettres_touchees( const void * a, const void * b ){
+	const Lettre_touchee * x = (const Lettre_touchee *) a;
+	const Lettre_touchee * y = (const Lettre_touchee *) b;
+	if( x->classe != y->classe ) return ( x->classe > y->classe ) ? 1 : -1;
+	if( x->ensemble != y->ensemble ) return ( x->ensemble > y->ensemble ) ? 1 : -1;
+	return ( x->lettre > y->lettre ) - ( x->lettre < y->lettre );
+}
+
+Classes_de_lettres * creer_classes_de_lettres( const Transitions_denses * t ){
+	int m = t->nb_lettres;
+	int q, i, j, g, h, a;
+	Classes_de_lettres * c = xmalloc( sizeof(Classes_de_lettres) );
+	c->classe = xmalloc( ( m + 1 ) * sizeof(int) );
+	for( a = 0; a < m; a++ ) c->classe[a] = 0;
+
+	// taille[k] : nombre de lettres de la classe provisoire k
+	int nb = 1, capacite = m + 1;
+	int * taille = xmalloc( capacite * sizeof(int) );
+	taille[0] = m;
+	Table_sous_ensembles * ensembles = creer_table_sous_ensembles();
+	Lettre_touchee * touchees = xmalloc( ( m + 1 ) * sizeof(Lettre_touchee) );
+
+	for( q = 0; q < t->nb_etats; q++ ){
+		int nb_touchees = 0;
+		int k = t->debut[q];
+		while( k < t->debut[q+1] ){
+			int d = k;
+			a = t->lettre[k];
+			while( k < t->debut[q+1] && t->lettre[k] == a ) k++;
+			touchees[ nb_touchees ].classe = c->classe[a];
+			touchees[ nb_touchees ].ensemble = interner_sous_ensemble(
+				ensembles, t->fin + d, k - d, NULL
 			);
+			touchees[ nb_touchees ].lettre = a;
+			nb_touchees++;
+		}
+		qsort( 
+			touchees, nb_touchees, sizeof(Lettre_touchee),
+			comparer_lettres_touchees
+		);
+		for( i = 0; i < nb_touchees; i = j ){
+			int cl = touchees[i].classe;
+			for( j = i; j < nb_touchees && touchees[j].classe == cl; j++ );
+			// Toute la classe mène au même ensemble : rien à séparer
+			if( 
+				j - i == taille[cl] &&
+				touchees[i].ensemble == touchees[j-1].ensemble
+			) continue;
+			for( g = i; g < j; g = h ){
+				for( h = g; h < j && touchees[h].ensemble == touchees[g].ensemble; h++ );
+				if( nb == capacite ){
+					capacite *= 2;
+					taille = xrealloc( taille, capacite * sizeof(int) );
+				}
+				taille[nb] = h - g;
+				taille[cl] -= h - g;
+				for( ; g < h; g++ ) c->classe[ touchees[g].lettre ] = nb;
+				nb++;
+			}
 		}
 	}
+	xfree( touchees );
+	liberer_table_sous_ensembles( ensembles );
+
+	// Renumérotation dans l'ordre des représentants
+	int * numero = taille;
+	for( i = 0; i < nb; i++ ) numero[i] = -1;
+	c->nb_classes = 0;
+	for( a = 0; a < m; a++ ){
+		if( numero[ c->classe[a] ] < 0 ) numero[ c->classe[a] ] = c->nb_classes++;
+		c->classe[a] = numero[ c->classe[a] ];
+	}
+	xfree( numero );
+
+	c->debut = xmalloc( ( c->nb_classes + 2 ) * sizeof(int) );
+	c->lettres = xmalloc( ( m + 1 ) * sizeof(int) );
+	for( i = 0; i < c->nb_classes + 2; i++ ) c->debut[i] = 0;
+	for( a = 0; a < m; a++ ) c->debut[ c->classe[a] + 2 ]++;
+	for( i = 0; i < c->nb_classes; i++ ) c->debut[i+2] += c->debut[i+1];
+	for( a = 0; a < m; a++ ) c->lettres[ c->debut[ c->classe[a] + 1 ]++ ] = a;
+	return c;
+}
 
-	// On engendre tous les couples d'états finaux :
-	for(
-		it_etat_1 = premier_iterateur_ensemble( get_finaux( automate_1 ) );
-		! iterateur_ensemble_est_vide( it_etat_1 );
-		it_etat_1 = iterateur_suivant_ensemble( it_etat_1 )
-	){
-		int q1 = get_element( it_etat_1 );
-		for(
-			it_etat_2 = premier_iterateur_ensemble( get_finaux( automate_2 ) );
-			! iterateur_ensemble_est_vide( it_etat_2 );
-			it_etat_2 = iterateur_suivant_ensemble( it_etat_2 )
-		){
-			int q2 = get_element( it_etat_2 );
-			ajouter_etat_final( 
-				res, couple_to_int( q1, q2 )
-			);			
+void liberer_classes_de_lettres( Classes_de_lettres * c ){
+	xfree( c->classe );
+	xfree( c->debut );
+	xfree( c->lettres );
+	xfree( c );
+}
+
+int est_representant( const Classes_de_lettres * c, int a ){
+	return c->lettres[ c->debut[ c->classe[a] ] ] == a;
+}
+
+int classes_de_lettres( const Automate * automate, int classes[256] ){
+	Transitions_denses * t = creer_transitions_denses( automate );
+	Classes_de_lettres * c = creer_classes_de_lettres( t );
+	int i;
+	for( i = 0; i < 256; i++ ) classes[i] = -1;
+	for( i = 0; i < t->nb_lettres; i++ ){
+		classes[ (unsigned char) t->lettres[i] ] = c->classe[i];
+	}
+	int nb_classes = c->nb_classes;
+	liberer_classes_de_lettres( c );
+	liberer_transitions_denses( t );
+	return nb_classes;
+}
+
+int classes_de_lettres_entrees(
+	const Ensemble * alphabet, int nb_etats, const int * debut,
+	const char * lettre, const int * debut_fins, const int * fins,
+	int classes[256]
+){
+	// Transitions_denses sans numéros d'états, lue directement dans les
+	// entrées : une transition par fin, rangées comme les entrées.
+	Transitions_denses t;
+	int i, q, e, k;
+	t.etats = NULL;
+	t.nb_etats = nb_etats;
+	t.lettres = ensemble_vers_tableau( alphabet, &t.nb_lettres );
+	for( i = 0; i < 256; i++ ) t.indice_lettre[i] = -1;
+	for( i = 0; i < t.nb_lettres; i++ ){
+		t.indice_lettre[ (unsigned char) t.lettres[i] ] = i;
+	}
+	t.nb_transitions = debut_fins[ debut[nb_etats] ];
+	t.debut = xmalloc( ( nb_etats + 1 ) * sizeof(int) );
+	t.lettre = xmalloc( ( t.nb_transitions + 1 ) * sizeof(int) );
+	t.fin = (int*) fins;
+	t.final = NULL;
+	for( q = 0; q < nb_etats; q++ ){
+		t.debut[q] = debut_fins[ debut[q] ];
+		for( e = debut[q]; e < debut[q+1]; e++ ){
+			for( k = debut_fins[e]; k < debut_fins[e+1]; k++ ){
+				t.lettre[k] = t.indice_lettre[ (unsigned char) lettre[e] ];
+			}
 		}
 	}
+	t.debut[nb_etats] = t.nb_transitions;
 
-	// On engendre l'alphabet :
-	for(
-		it_lettre = premier_iterateur_ensemble( get_alphabet( automate_1 ) );
-		! iterateur_ensemble_est_vide( it_lettre );
-		it_lettre = iterateur_suivant_ensemble( it_lettre )
+	Classes_de_lettres * c = creer_classes_de_lettres( &t );
+	for( i = 0; i < 256; i++ ) classes[i] = -1;
+	for( i = 0; i < t.nb_lettres; i++ ){
+		classes[ (unsigned char) t.lettres[i] ] = c->classe[i];
+	}
+	int nb_classes = c->nb_classes;
+	liberer_classes_de_lettres( c );
+	xfree( t.lettres );
+	xfree( t.debut );
+	xfree( t.lettre );
+	return nb_classes;
+}
+
+/*
+ * Produit de deux automates.
+ *
+ * Les états du produit sont des couples (q1, q2) d'états renumérotés de 
+ * manière dense ; l'indice n1 (resp. n2) code l'absence d'état, c'est-à-dire
+ * l'état puits implicite, dans le premier (resp. le second) automate.
+ * Seuls les couples accessibles sont créés : ils sont numérotés dans l'ordre
+ * de découverte grâce à une Table_sous_ensembles de couples.
+ *
+ * Les lettres sont regroupées en classes communes aux deux automates (deux
+ * lettres sont dans la même classe si elles le sont dans chaque automate) :
+ * les successeurs d'un couple sont calculés une seule fois par classe.
+ */
+typedef struct {
+	const Transitions_denses * t1;
+	const Transitions_denses * t2;
+	Operation_produit operation;
+	Table_sous_ensembles * couples;
+	Automate * res;
+} Donnees_produit;
+
+/*
+ * Renvoie 1 si, pour l'opération considérée, aucun mot ne peut être accepté
+ * depuis un couple ayant un état puits dans une ou deux composantes.
+ */
+int couple_est_mort( const Donnees_produit * d, int q1, int q2 ){
+	int puits1 = ( q1 == d->t1->nb_etats );
+	int puits2 = ( q2 == d->t2->nb_etats );
+	switch( d->operation ){
+		case PRODUIT_INTERSECTION :
+			return puits1 || puits2;
+		case PRODUIT_DIFFERENCE :
+			return puits1;
+		default :
+			return puits1 && puits2;
+	}
+}
+
+int couple_est_final( const Donnees_produit * d, int q1, int q2 ){
+	int f1 = ( q1 < d->t1->nb_etats ) && d->t1->final[q1];
+	int f2 = ( q2 < d->t2->nb_etats ) && d->t2->final[q2];
+	switch( d->operation ){
+		case PRODUIT_INTERSECTION : return f1 && f2;
+		case PRODUIT_UNION : return f1 || f2;
+		case PRODUIT_DIFFERENCE : return f1 && ! f2;
+		default : return f1 != f2;
+	}
+}
+
+int ajouter_couple( Donnees_produit * d, int q1, int q2 ){
+	int couple[2] = { q1, q2 };
+	int nouveau;
+	int id = interner_sous_ensemble( d->couples, couple, 2, &nouveau );
+	if( nouveau ){
+		ajouter_etat( d->res, id );
+		if( couple_est_final( d, q1, q2 ) ) ajouter_etat_final( d->res, id );
+	}
+	return id;
+}
+
+/*
+ * Ajoute les transitions du couple 'id' = (q1, q2) étiquetées par les 
+ * lettres lettres[0..nb_lettres-1], qui sont dans la même classe.
+ * Les fins possibles dans chaque composante sont fins1[0..n1-1] et
+ * fins2[0..n2-1] ; une liste vide désigne l'état puits.
+ */
+void ajouter_transitions_couple(
+	Donnees_produit * d, int id, const char * lettres, int nb_lettres,
+	const int * fins1, int n1, const int * fins2, int n2
+){
+	int puits1 = d->t1->nb_etats, puits2 = d->t2->nb_etats;
+	int i, j, l;
+	for( i = 0; i < ( n1 ? n1 : 1 ); i++ ){
+		int e1 = n1 ? fins1[i] : puits1;
+		for( j = 0; j < ( n2 ? n2 : 1 ); j++ ){
+			int e2 = n2 ? fins2[j] : puits2;
+			if( couple_est_mort( d, e1, e2 ) ) continue;
+			int fin = ajouter_couple( d, e1, e2 );
+			for( l = 0; l < nb_lettres; l++ ){
+				ajouter_transition( d->res, id, lettres[l], fin );
+			}
+		}
+	}
+}
+
+/*
+ * Calcule les classes de lettres communes aux deux automates.
+ * classe[octet] reçoit la classe commune de chaque lettre d'un des deux
+ * alphabets ; les lettres de la classe c sont lettres[ debut[c] ] ...
+ * lettres[ debut[c+1]-1 ], la première étant le représentant.
+ */
+void classes_communes(
+	const Transitions_denses * t1, const Transitions_denses * t2,
+	int classe[256], int * debut, char * lettres
+){
+	Classes_de_lettres * c1 = creer_classes_de_lettres( t1 );
+	Classes_de_lettres * c2 = creer_classes_de_lettres( t2 );
+	Table_sous_ensembles * paires = creer_table_sous_ensembles();
+	int i1 = 0, i2 = 0, nb = 0, l = 0, c;
+	char alphabet[256];
+	// Union des alphabets, dans l'ordre croissant
+	while( i1 < t1->nb_lettres || i2 < t2->nb_lettres ){
+		int l1 = ( i1 < t1->nb_lettres ) ? t1->lettres[i1] : INT_MAX;
+		int l2 = ( i2 < t2->nb_lettres ) ? t2->lettres[i2] : INT_MAX;
+		int lettre = ( l1 < l2 ) ? l1 : l2;
+		int paire[2] = { -1, -1 };
+		if( l1 == lettre ) paire[0] = c1->classe[ i1++ ];
+		if( l2 == lettre ) paire[1] = c2->classe[ i2++ ];
+		classe[ (unsigned char) lettre ] = interner_sous_ensemble(
+			paires, paire, 2, NULL
+		);
+		alphabet[ nb++ ] = (char) lettre;
+	}
+	int nb_classes = nombre_de_sous_ensembles( paires );
+	for( c = 0; c <= nb_classes + 1; c++ ) debut[c] = 0;
+	for( l = 0; l < nb; l++ ) debut[ classe[ (unsigned char) alphabet[l] ] + 2 ]++;
+	for( c = 0; c < nb_classes; c++ ) debut[c+2] += debut[c+1];
+	for( l = 0; l < nb; l++ ){
+		lettres[ debut[ classe[ (unsigned char) alphabet[l] ] + 1 ]++ ] = alphabet[l];
+	}
+	liberer_table_sous_ensembles( paires );
+	liberer_classes_de_lettres( c1 );
+	liberer_classes_de_lettres( c2 );
+}
+
+Automate * creer_produit_des_automates(
+	const Automate * automate_1, const Automate * automate_2,
+	Operation_produit operation
+){
+	// La différence et la différence symétrique complémentent un des 
+	// automates : ceux-ci doivent être déterministes.
+	Automate * det_1 = NULL, * det_2 = NULL;
+	if( 
+		operation == PRODUIT_DIFFERENCE_SYMETRIQUE &&
+		! est_deterministe( automate_1 )
 	){
-		char lettre = get_element( it_lettre );
-		ajouter_lettre( res, lettre );
+		det_1 = creer_automate_deterministe( automate_1 );
+		automate_1 = det_1;
 	}
-	for(
-		it_lettre = premier_iterateur_ensemble( get_alphabet( automate_2 ) );
-		! iterateur_ensemble_est_vide( it_lettre );
-		it_lettre = iterateur_suivant_ensemble( it_lettre )
+	if(
+		( operation == PRODUIT_DIFFERENCE || 
+		  operation == PRODUIT_DIFFERENCE_SYMETRIQUE ) &&
+		! est_deterministe( automate_2 )
 	){
-		char lettre = get_element( it_lettre );
-		ajouter_lettre( res, lettre );
+		det_2 = creer_automate_deterministe( automate_2 );
+		automate_2 = det_2;
 	}
 
-	// On engendre les transitions :
-	Ensemble_iterateur it_etat;
-	for(
-		it_etat = premier_iterateur_ensemble( get_etats( res ) );
-		! iterateur_ensemble_est_vide( it_etat );
-		it_etat = iterateur_suivant_ensemble( it_etat )
-	){
-		int q = get_element( it_etat );
-		int o1 , o2, e1, e2;
-		int_to_couple( q, &o1, &o2 );
-		for(
-			it_lettre = premier_iterateur_ensemble( get_alphabet( res ) );
-			! iterateur_ensemble_est_vide( it_lettre );
-			it_lettre = iterateur_suivant_ensemble( it_lettre )
-		){
-			char lettre = get_element( it_lettre );
-			const Ensemble * v1 = voisins( automate_1, o1, lettre );
-			const Ensemble * v2 = voisins( automate_2, o2, lettre );
-			for(
-				it_etat_1 = premier_iterateur_ensemble( v1 );
-				! iterateur_ensemble_est_vide( it_etat_1 );
-				it_etat_1 = iterateur_suivant_ensemble( it_etat_1 )
-			){
-				e1 = get_element( it_etat_1 );
-				for(
-					it_etat_2 = premier_iterateur_ensemble( v2 );
-					! iterateur_ensemble_est_vide( it_etat_2 );
-					it_etat_2 = iterateur_suivant_ensemble( it_etat_2 )
-				){
-					e2 = get_element( it_etat_2 );
-					ajouter_transition( res, q, lettre, couple_to_int(e1,e2) );
-				}
+	Donnees_produit d;
+	Transitions_denses * t1 = creer_transitions_denses( automate_1 );
+	Transitions_denses * t2 = creer_transitions_denses( automate_2 );
+	d.t1 = t1;
+	d.t2 = t2;
+	d.operation = operation;
+	d.couples = creer_table_sous_ensembles();
+	d.res = creer_automate();
+	int puits1 = t1->nb_etats, puits2 = t2->nb_etats;
+	int i, j;
+
+	// L'alphabet du produit est l'union des alphabets
+	for( i = 0; i < t1->nb_lettres; i++ ) ajouter_lettre( d.res, t1->lettres[i] );
+	for( i = 0; i < t2->nb_lettres; i++ ) ajouter_lettre( d.res, t2->lettres[i] );
+	int classe[256], debut_classe[258];
+	char lettres_classe[256];
+	classes_communes( t1, t2, classe, debut_classe, lettres_classe );
+
+	// Couples initiaux
+	int ni1, ni2;
+	int * initiaux1 = ensemble_vers_tableau( get_initiaux( automate_1 ), &ni1 );
+	int * initiaux2 = ensemble_vers_tableau( get_initiaux( automate_2 ), &ni2 );
+	for( i = 0; i < ni1; i++ ){
+		initiaux1[i] = indice_dans_tableau( t1->etats, t1->nb_etats, initiaux1[i] );
+	}
+	for( i = 0; i < ni2; i++ ){
+		initiaux2[i] = indice_dans_tableau( t2->etats, t2->nb_etats, initiaux2[i] );
+	}
+	for( i = 0; i < ( ni1 ? ni1 : 1 ); i++ ){
+		int q1 = ni1 ? initiaux1[i] : puits1;
+		for( j = 0; j < ( ni2 ? ni2 : 1 ); j++ ){
+			int q2 = ni2 ? initiaux2[j] : puits2;
+			if( couple_est_mort( &d, q1, q2 ) ) continue;
+			ajouter_etat_initial( d.res, ajouter_couple( &d, q1, q2 ) );
+		}
+	}
+	xfree( initiaux1 );
+	xfree( initiaux2 );
+
+	// Parcours en largeur : les couples sont numérotés dans l'ordre de 
+	// découverte, il suffit donc de les traiter dans l'ordre des numéros.
+	int id;
+	for( id = 0; id < nombre_de_sous_ensembles( d.couples ); id++ ){
+		int taille;
+		const int * couple = get_sous_ensemble( d.couples, id, &taille );
+		int q1 = couple[0], q2 = couple[1];
+		// Transitions de chaque composante, triées par lettre
+		int k1 = 0, f1 = 0, k2 = 0, f2 = 0;
+		if( q1 < puits1 ){ k1 = t1->debut[q1]; f1 = t1->debut[q1+1]; }
+		if( q2 < puits2 ){ k2 = t2->debut[q2]; f2 = t2->debut[q2+1]; }
+		// Fusion des deux listes de transitions par lettre
+		while( k1 < f1 || k2 < f2 ){
+			int l1 = ( k1 < f1 ) ? t1->lettres[ t1->lettre[k1] ] : INT_MAX;
+			int l2 = ( k2 < f2 ) ? t2->lettres[ t2->lettre[k2] ] : INT_MAX;
+			int lettre = ( l1 < l2 ) ? l1 : l2;
+			int d1 = k1, d2 = k2;
+			while( k1 < f1 && t1->lettres[ t1->lettre[k1] ] == lettre ) k1++;
+			while( k2 < f2 && t2->lettres[ t2->lettre[k2] ] == lettre ) k2++;
+			if( operation == PRODUIT_INTERSECTION && ( d1 == k1 || d2 == k2 ) ){
+				continue;
 			}
+			if( operation == PRODUIT_DIFFERENCE && d1 == k1 ){
+				continue;
+			}
+			// Les autres lettres de la classe sont traitées avec son
+			// représentant
+			int c = classe[ (unsigned char) lettre ];
+			if( lettres_classe[ debut_classe[c] ] != (char) lettre ) continue;
+			ajouter_transitions_couple(
+				&d, id, lettres_classe + debut_classe[c],
+				debut_classe[c+1] - debut_classe[c],
+				t1->fin + d1, k1 - d1, t2->fin + d2, k2 - d2
+			);
 		}
 	}
 
+	Automate * res = d.res;
+	liberer_table_sous_ensembles( d.couples );
+	liberer_transitions_denses( t1 );
+	liberer_transitions_denses( t2 );
+	if( det_1 ) liberer_automate( det_1 );
+	if( det_2 ) liberer_automate( det_2 );
 	return res;
 }
 
+Automate * creer_intersection_des_automates(
+	const Automate * automate_1, const Automate * automate_2
+){
+	return creer_produit_des_automates(
+		automate_1, automate_2, PRODUIT_INTERSECTION
+	);
+}
+
 
 int etat_minimal( const Automate * automate ){
 	int min = INT_MAX;
@@ -520,122 +986,274 @@ int etat_maximal( const Automate * automate ){
 	return max;
 }
 
-Ensemble* etats_accessibles( const Automate * automate, int etat ){
-	Ensemble * resultat = creer_ensemble( NULL, NULL, NULL );
-	Ensemble * courants = creer_ensemble( NULL, NULL, NULL );
-	ajouter_element( resultat, etat );
-	ajouter_elements( courants, resultat );
+/*
+ * Renvoie le numéro d'adjacence de l'état, ou -1 s'il n'en a pas. Les états
+ * initiaux, les états finaux et les extrémités des transitions en ont tous
+ * un.
+ */
+int numero_adjacence( const Automate * automate, int etat ){
+	return trouver_sous_ensemble( automate->numeros, &etat, 1 );
+}
 
-	int n = taille_ensemble( get_etats( automate ) );
-	int i;
+/*
+ * Marque dans 'vu' tous les numéros d'adjacence atteignables depuis ceux de
+ * la pile, en suivant les transitions sortantes.
+ *
+ * Chaque numéro est empilé au plus une fois et chaque transition est lue au
+ * plus une fois ; l'état d'arrivée est retrouvé dans la table 'numeros', en
+ * temps constant en moyenne. La pile doit pouvoir contenir tous les numéros.
+ */
+void marquer_successeurs(
+	const Automate * automate, char * vu, int * pile, int taille_pile
+){
+	while( taille_pile > 0 ){
+		const Adjacence * adj = &( automate->adjacences[ pile[ --taille_pile ] ] );
+		int i;
+		for( i = 0; i < adj->sortantes.nb; i++ ){
+			Ensemble_iterateur it;
+			for(
+				it = premier_iterateur_ensemble( adj->sortantes.transitions[i].etats );
+				! iterateur_ensemble_est_vide( it );
+				it = iterateur_suivant_ensemble( it )
+			){
+				int r = numero_adjacence( automate, get_element( it ) );
+				if( ! vu[r] ){
+					vu[r] = 1;
+					pile[ taille_pile++ ] = r;
+				}
+			}
+		}
+	}
+}
 
-	Ensemble* tmp;
-	Ensemble* next;
+/*
+ * Marque dans 'vu' tous les numéros d'adjacence atteignables depuis ceux de
+ * la pile, en suivant le graphe codé par 'debut' et 'voisin' : les voisins
+ * de q sont voisin[ debut[q] ] ... voisin[ debut[q+1]-1 ].
+ */
+void marquer_atteignables(
+	const int * debut, const int * voisin, char * vu,
+	int * pile, int taille_pile
+){
+	while( taille_pile > 0 ){
+		int q = pile[ --taille_pile ];
+		int k;
+		for( k = debut[q]; k < debut[q+1]; k++ ){
+			int r = voisin[k];
+			if( ! vu[r] ){
+				vu[r] = 1;
+				pile[ taille_pile++ ] = r;
+			}
+		}
+	}
+}
 
-	for( i=0; i< n-1; i++ ){
+/*
+ * Renvoie un tableau 'vu' indexé par les numéros d'adjacence, où sont marqués
+ * les états accessibles depuis les états de 'sources'. Les états de
+ * 'sources' qui n'ont pas de numéro sont ignorés.
+ */
+char * marquer_accessibles( const Automate * automate, const Ensemble * sources ){
+	int n = nombre_de_sous_ensembles( automate->numeros );
+	char * vu = xmalloc( n + 1 );
+	memset( vu, 0, n + 1 );
+	int * pile = xmalloc( ( n + 1 ) * sizeof(int) );
+	int taille_pile = 0;
+	Ensemble_iterateur it;
+	for(
+		it = premier_iterateur_ensemble( sources );
+		! iterateur_ensemble_est_vide( it );
+		it = iterateur_suivant_ensemble( it )
+	){
+		int q = numero_adjacence( automate, get_element( it ) );
+		if( q >= 0 && ! vu[q] ){
+			vu[q] = 1;
+			pile[ taille_pile++ ] = q;
+		}
+	}
+	marquer_successeurs( automate, vu, pile, taille_pile );
+	xfree( pile );
+	return vu;
+}
 
-		next = creer_ensemble( NULL, NULL, NULL );
+/*
+ * Renvoie un tableau 'vu' indexé par les numéros d'adjacence, où sont marqués
+ * les états co-accessibles, c'est-à-dire ceux depuis lesquels on peut
+ * atteindre un état final. Le parcours se fait sur les transitions inversées,
+ * rangées par état d'arrivée grâce à un tri par dénombrement.
+ */
+char * marquer_co_accessibles( const Automate * automate ){
+	int n = nombre_de_sous_ensembles( automate->numeros );
+	int * debut = xmalloc( ( n + 2 ) * sizeof(int) );
+	int q, i, k;
+	for( q = 0; q < n + 2; q++ ) debut[q] = 0;
+
+	// Numéros des extrémités de chaque transition
+	int nb_transitions = 0, capacite = 16;
+	int * depart = xmalloc( capacite * sizeof(int) );
+	int * arrivee = xmalloc( capacite * sizeof(int) );
+	for( q = 0; q < n; q++ ){
+		const Liste_transitions * liste = &( automate->adjacences[q].sortantes );
+		for( i = 0; i < liste->nb; i++ ){
+			Ensemble_iterateur it;
+			for(
+				it = premier_iterateur_ensemble( liste->transitions[i].etats );
+				! iterateur_ensemble_est_vide( it );
+				it = iterateur_suivant_ensemble( it )
+			){
+				if( nb_transitions == capacite ){
+					capacite *= 2;
+					depart = xrealloc( depart, capacite * sizeof(int) );
+					arrivee = xrealloc( arrivee, capacite * sizeof(int) );
+				}
+				int r = numero_adjacence( automate, get_element( it ) );
+				depart[ nb_transitions ] = q;
+				arrivee[ nb_transitions++ ] = r;
+				debut[ r + 2 ]++;
+			}
+		}
+	}
+	for( q = 0; q < n; q++ ) debut[q+2] += debut[q+1];
+	int * origine = xmalloc( ( nb_transitions + 1 ) * sizeof(int) );
+	for( k = 0; k < nb_transitions; k++ ){
+		origine[ debut[ arrivee[k] + 1 ]++ ] = depart[k];
+	}
+	xfree( depart );
+	xfree( arrivee );
 
-		Ensemble_iterateur it;
-		for( 
-			it = premier_iterateur_ensemble( get_alphabet( automate ) );
-			! iterateur_ensemble_est_vide( it );
-			it = iterateur_suivant_ensemble( it )
-		){
-			tmp = delta( automate, courants, get_element(it) );
-			ajouter_elements( next, tmp );
-			liberer_ensemble( tmp );
+	char * vu = xmalloc( n + 1 );
+	memset( vu, 0, n + 1 );
+	int * pile = xmalloc( ( n + 1 ) * sizeof(int) );
+	int taille_pile = 0;
+	Ensemble_iterateur it;
+	for(
+		it = premier_iterateur_ensemble( get_finaux( automate ) );
+		! iterateur_ensemble_est_vide( it );
+		it = iterateur_suivant_ensemble( it )
+	){
+		q = numero_adjacence( automate, get_element( it ) );
+		if( ! vu[q] ){
+			vu[q] = 1;
+			pile[ taille_pile++ ] = q;
 		}
+	}
+	marquer_atteignables( debut, origine, vu, pile, taille_pile );
+	xfree( pile );
+	xfree( debut );
+	xfree( origine );
+	return vu;
+}
 
-		ajouter_elements( resultat, next );
-		liberer_ensemble( courants );
-		courants = next;
+Ensemble * etats_marques( const Automate * automate, const char * vu ){
+	Ensemble * res = creer_ensemble( NULL, NULL, NULL );
+	int q;
+	for( q = 0; q < nombre_de_sous_ensembles( automate->numeros ); q++ ){
+		if( vu[q] ) ajouter_element( res, automate->adjacences[q].etat );
 	}
-	
-	liberer_ensemble( courants );
+	return res;
+}
 
+Ensemble* etats_accessibles( const Automate * automate, int etat ){
+	Ensemble * depart = creer_ensemble( NULL, NULL, NULL );
+	ajouter_element( depart, etat );
+	char * vu = marquer_accessibles( automate, depart );
+	liberer_ensemble( depart );
+
+	Ensemble * resultat = etats_marques( automate, vu );
+	// L'état de départ est toujours accessible, même s'il n'est pas un état de
+	// l'automate.
+	ajouter_element( resultat, etat );
+	xfree( vu );
 	return resultat;
 }
 
 Ensemble* accessibles( const Automate * automate ){
-	Ensemble_iterateur it1;
-	Ensemble * access = creer_ensemble( NULL, NULL, NULL );
-	for(
-		it1 = premier_iterateur_ensemble( get_initiaux( automate ) );
-		! iterateur_ensemble_est_vide( it1 );
-		it1 = iterateur_suivant_ensemble( it1 )
-	){
-		Ensemble * ens = etats_accessibles( automate, get_element(it1) );
-		ajouter_elements( access, ens );
-		liberer_ensemble( ens );
-	}
+	char * vu = marquer_accessibles( automate, get_initiaux( automate ) );
+	Ensemble * access = etats_marques( automate, vu );
+	xfree( vu );
 	return access;
 }
 
-Automate *automate_accessible( const Automate * automate ){
-	Automate * res = creer_automate();
-	Ensemble_iterateur it1;
+Ensemble* co_accessibles( const Automate * automate ){
+	char * vu = marquer_co_accessibles( automate );
+	Ensemble * res = etats_marques( automate, vu );
+	xfree( vu );
+	return res;
+}
 
-	Ensemble * access = accessibles( automate );
+/*
+ * Renvoie la restriction de l'automate aux états de numéro d'adjacence q
+ * tels que garde[q] est non nul. Les transitions sont lues en un seul
+ * passage ; l'alphabet est conservé en entier.
+ */
+Automate * restreindre_automate( const Automate * automate, const char * garde ){
+	Automate * res = creer_automate();
+	int n = nombre_de_sous_ensembles( automate->numeros );
+	int q, i;
+	Ensemble_iterateur it;
 
-	// On ajoute les états de l'automate
-	for(
-		it1 = premier_iterateur_ensemble( access );
-		! iterateur_ensemble_est_vide( it1 );
-		it1 = iterateur_suivant_ensemble( it1 )
-	){
-		ajouter_etat( res, get_element( it1 ) );
-	}
-	// On ajoute les états initiaux
-	for(
-		it1 = premier_iterateur_ensemble( get_initiaux( automate ) );
-		! iterateur_ensemble_est_vide( it1 );
-		it1 = iterateur_suivant_ensemble( it1 )
-	){
-		ajouter_etat_initial( res, get_element( it1 ) );
-	}
-	// On ajoute les états finaux
-	for(
-		it1 = premier_iterateur_ensemble( access );
-		! iterateur_ensemble_est_vide( it1 );
-		it1 = iterateur_suivant_ensemble( it1 )
-	){
-		int etat = get_element( it1 );
-		if( est_un_etat_final_de_l_automate( automate, etat ) ){
-			ajouter_etat_final( res, etat );
-		}
-	}
 	// On ajoute les lettres
 	for(
-		it1 = premier_iterateur_ensemble( get_alphabet( automate ) );
-		! iterateur_ensemble_est_vide( it1 );
-		it1 = iterateur_suivant_ensemble( it1 )
+		it = premier_iterateur_ensemble( get_alphabet( automate ) );
+		! iterateur_ensemble_est_vide( it );
+		it = iterateur_suivant_ensemble( it )
 	){
-		ajouter_lettre( res, (char) get_element( it1 ) );
+		ajouter_lettre( res, (char) get_element( it ) );
 	}
-	// On ajoute les transitions
-	Table_iterateur it2;
-	for(
-		it2 = premier_iterateur_table( automate->transitions );
-		! iterateur_est_vide( it2 );
-		it2 = iterateur_suivant_table( it2 )
-	){
-		Cle * cle = (Cle*) get_cle( it2 );
-		int origine = cle->origine; 
-		char lettre = cle->lettre;
-		if( est_dans_l_ensemble( access, origine ) ){ 
-			Ensemble * fins = (Ensemble*) get_valeur( it2 );
+	for( q = 0; q < n; q++ ){
+		if( ! garde[q] ) continue;
+		const Adjacence * adj = &( automate->adjacences[q] );
+		// On ajoute l'état, initial et final compris
+		ajouter_etat( res, adj->etat );
+		if( est_dans_l_ensemble( get_initiaux( automate ), adj->etat ) ){
+			ajouter_etat_initial( res, adj->etat );
+		}
+		if( est_un_etat_final_de_l_automate( automate, adj->etat ) ){
+			ajouter_etat_final( res, adj->etat );
+		}
+		// On ajoute les transitions vers un état conservé
+		for( i = 0; i < adj->sortantes.nb; i++ ){
+			const Transitions_lettre * tl = &( adj->sortantes.transitions[i] );
 			for(
-				it1 = premier_iterateur_ensemble( fins );
-				! iterateur_ensemble_est_vide( it1 );
-				it1 = iterateur_suivant_ensemble( it1 )
+				it = premier_iterateur_ensemble( tl->etats );
+				! iterateur_ensemble_est_vide( it );
+				it = iterateur_suivant_ensemble( it )
 			){
-				int fin = get_element( it1 );
-				ajouter_transition( res, origine, lettre, fin );
+				if( garde[ numero_adjacence( automate, get_element( it ) ) ] ){
+					ajouter_transition(
+						res, adj->etat, (char) tl->lettre, get_element( it )
+					);
+				}
 			}
 		}
-	};
-	liberer_ensemble( access );
+	}
+	return res;
+}
+
+Automate *automate_accessible( const Automate * automate ){
+	char * vu = marquer_accessibles( automate, get_initiaux( automate ) );
+	Automate * res = restreindre_automate( automate, vu );
+	xfree( vu );
+	return res;
+}
+
+Automate *automate_co_accessible( const Automate * automate ){
+	char * vu = marquer_co_accessibles( automate );
+	Automate * res = restreindre_automate( automate, vu );
+	xfree( vu );
+	return res;
+}
+
+Automate *automate_emonde( const Automate * automate ){
+	char * accessible = marquer_accessibles( automate, get_initiaux( automate ) );
+	char * co_accessible = marquer_co_accessibles( automate );
+	int q;
+	for( q = 0; q < nombre_de_sous_ensembles( automate->numeros ); q++ ){
+		accessible[q] = accessible[q] && co_accessible[q];
+	}
+	Automate * res = restreindre_automate( automate, accessible );
+	xfree( accessible );
+	xfree( co_accessible );
 	return res;
 }
 
@@ -676,23 +1294,7 @@ Automate* miroir( const Automate* automate ){
 		ajouter_lettre( res, (char) get_element( it1 ) );
 	}
 	// On ajoute les transitions en inversant l'état de départ et l'état d'arrivée
-	Table_iterateur it2;
-	for(
-		it2 = premier_iterateur_table( automate->transitions );
-		! iterateur_est_vide( it2 );
-		it2 = iterateur_suivant_table( it2 )
-	){
-		Cle * cle = (Cle*) get_cle( it2 );
-		Ensemble * fins = (Ensemble*) get_valeur( it2 );
-		for(
-			it1 = premier_iterateur_ensemble( fins );
-			! iterateur_ensemble_est_vide( it1 );
-			it1 = iterateur_suivant_ensemble( it1 )
-		){
-			int fin = get_element( it1 );
-			ajouter_transition( res, fin, cle->lettre, cle->origine );
-		}
-	}
+	pour_toute_transition( automate, action_copier_transition_miroir, res );
 	return res;
 }
 
@@ -709,13 +1311,6 @@ int nombre_de_transitions( const Automate* automate ){
 	return res;
 }
 
-void action_creer_intersection_des_automates(
-	int origine, char lettre, int fin, void* data
-){
-	Automate * res = (Automate*) data;
-	ajouter_transition( res, origine, lettre, fin );
-}
-
 
 int est_une_transition_de_l_automate(
 	const Automate* automate,
@@ -740,10 +1335,6 @@ int est_une_lettre_de_l_automate( const Automate* automate, char lettre ){
 	return est_dans_l_ensemble( get_alphabet( automate ), lettre );
 }
 
-void print_ensemble_2( const intptr_t ens ){
-	print_ensemble( (Ensemble*) ens, NULL );
-}
-
 void print_lettre( intptr_t c ){
 	printf("%c", (char) c );
 }
@@ -757,14 +1348,22 @@ void print_automate( const Automate * automate ){
 	print_ensemble( get_finaux( automate ), NULL );
 	printf("\n- Alphabet : ");
 	print_ensemble( get_alphabet( automate ), print_lettre );
-	printf("\n- Transitions : ");
-	print_table( 
-		automate->transitions,
-		( void (*)( const intptr_t ) ) print_cle, 
-		( void (*)( const intptr_t ) ) print_ensemble_2,
-		""
-	);
-	printf("\n");
+	printf("\n- Transitions : { ");
+	int * ordre = adjacences_triees( automate );
+	int k, i;
+	for( k = 0; k < nombre_de_sous_ensembles( automate->numeros ); k++ ){
+		const Adjacence * adj = &( automate->adjacences[ ordre[k] ] );
+		for( i = 0; i < adj->sortantes.nb; i++ ){
+			printf(
+				"(%d, %c) --> ", adj->etat,
+				(char) adj->sortantes.transitions[i].lettre
+			);
+			print_ensemble( adj->sortantes.transitions[i].etats, NULL );
+			printf(", ");
+		}
+	}
+	xfree( ordre );
+	printf(" }\n");
 }
 
 int le_mot_est_reconnu( const Automate* automate, const char* mot ){
@@ -787,98 +1386,430 @@ int le_mot_est_reconnu( const Automate* automate, const char* mot ){
 	return result;
 }
 
-int ajouter_ensemble( 
-	const Ensemble* ens,
-	Table* ensemble_to_id, Table* id_to_ensemble, Fifo* f, 
-	Automate * aut, int next_id
-){
-	
-	Table_iterateur it = trouver_table( ensemble_to_id, (intptr_t) ens );
-	if( iterateur_est_vide( it ) ){
-		add_table( ensemble_to_id, (intptr_t) ens, next_id );
-		add_table( id_to_ensemble, next_id, (intptr_t) ens );
-		ajouter_fifo( f, (intptr_t) ens );
-		ajouter_etat( aut, next_id );
-		return next_id+1;
-	}else{
-		return next_id;
-	}
-}
-
+/*
+ * Construction des sous-ensembles.
+ *
+ * Chaque sous-ensemble d'états (renumérotés de manière dense) est interné
+ * une seule fois dans une Table_sous_ensembles, sous la forme d'un tableau
+ * trié ; son numéro dans la table est son numéro dans l'automate 
+ * déterministe. Les images d'un sous-ensemble par toutes les lettres sont
+ * calculées en un seul parcours de ses transitions, et une seule fois par
+ * classe de lettres : seules les transitions étiquetées par le représentant
+ * d'une classe sont lues.
+ */
 Automate * creer_automate_deterministe( const Automate* automate ){
 	Automate * res = creer_automate();
-
-	Fifo* f = creer_fifo();
-	Table* ensemble_to_id = creer_table(
-		( int(*)(const intptr_t, const intptr_t) ) comparer_ensemble, 
-		( intptr_t (*)( const intptr_t ) ) copier_ensemble,
-		( void(*)(intptr_t) ) liberer_ensemble
-	);
-	Table* id_to_ensemble = creer_table( NULL, NULL, NULL );
-	
-	int next_id = ajouter_ensemble(
-		copier_ensemble( get_initiaux( automate ) ), 
-		ensemble_to_id, id_to_ensemble, f, res, 0
-	);
-	ajouter_etat_initial( res, 0 );
-
-	while( ! est_vide( f ) ){
-		Ensemble* e = (Ensemble*) retirer_fifo( f );
-		int id_e = get_valeur( trouver_table( ensemble_to_id, (intptr_t) e ) );
-
-		Ensemble_iterateur it_lettre;
-		for(
-			it_lettre = premier_iterateur_ensemble( get_alphabet( automate ) );
-			! iterateur_ensemble_est_vide( it_lettre );
-			it_lettre = iterateur_suivant_ensemble( it_lettre )
-		){
-			char lettre = (char) get_element( it_lettre );
-			Ensemble * img = delta( automate, e, lettre );
-			int id = ajouter_ensemble(
-				img, ensemble_to_id, id_to_ensemble, f, res, next_id
+	Transitions_denses * t = creer_transitions_denses( automate );
+	Classes_de_lettres * classes = creer_classes_de_lettres( t );
+	Table_sous_ensembles * sous_ensembles = creer_table_sous_ensembles();
+	int n = t->nb_etats;
+	int m = classes->nb_classes;
+	int i, a, l;
+
+	int * courant = xmalloc( ( n + 1 ) * sizeof(int) );
+	int * cibles = xmalloc( ( t->nb_transitions + 1 ) * sizeof(int) );
+	int * position = xmalloc( ( m + 1 ) * sizeof(int) );
+	int capacite_pile = 64, taille_pile = 0;
+	int * pile = xmalloc( capacite_pile * sizeof(int) );
+
+	int taille;
+	int * initiaux = ensemble_vers_tableau( get_initiaux( automate ), &taille );
+	for( i = 0; i < taille; i++ ){
+		initiaux[i] = indice_dans_tableau( t->etats, n, initiaux[i] );
+	}
+	int id = interner_sous_ensemble( sous_ensembles, initiaux, taille, NULL );
+	xfree( initiaux );
+	ajouter_etat( res, id );
+	ajouter_etat_initial( res, id );
+	pile[ taille_pile++ ] = id;
+
+	while( taille_pile > 0 ){
+		int id_e = pile[ --taille_pile ];
+		const int * e = get_sous_ensemble( sous_ensembles, id_e, &taille );
+		memcpy( courant, e, taille * sizeof(int) );
+
+		// Tri par classe des fins des transitions issues du sous-ensemble
+		for( a = 0; a <= m; a++ ) position[a] = 0;
+		for( i = 0; i < taille; i++ ){
+			int k;
+			for( k = t->debut[ courant[i] ]; k < t->debut[ courant[i] + 1 ]; k++ ){
+				if( ! est_representant( classes, t->lettre[k] ) ) continue;
+				position[ classes->classe[ t->lettre[k] ] + 1 ]++;
+			}
+		}
+		for( a = 0; a < m; a++ ) position[a+1] += position[a];
+		for( i = 0; i < taille; i++ ){
+			int k;
+			for( k = t->debut[ courant[i] ]; k < t->debut[ courant[i] + 1 ]; k++ ){
+				if( ! est_representant( classes, t->lettre[k] ) ) continue;
+				cibles[ position[ classes->classe[ t->lettre[k] ] ]++ ] = t->fin[k];
+			}
+		}
+		// position[a] est maintenant la fin du bloc de la classe a
+		int debut_bloc = 0;
+		for( a = 0; a < m; a++ ){
+			int taille_img = normaliser_sous_ensemble(
+				cibles + debut_bloc, position[a] - debut_bloc
 			);
-			ajouter_transition(
-				res, id_e, lettre, get_valeur(
-					trouver_table( ensemble_to_id, (intptr_t) img ) 
-				)
+			int nouveau;
+			id = interner_sous_ensemble(
+				sous_ensembles, cibles + debut_bloc, taille_img, &nouveau
 			);
-			if( next_id == id ){
-				liberer_ensemble(img);
-			}else{
-				next_id = id;
+			if( nouveau ){
+				ajouter_etat( res, id );
+				if( taille_pile == capacite_pile ){
+					capacite_pile *= 2;
+					pile = xrealloc( pile, capacite_pile * sizeof(int) );
+				}
+				pile[ taille_pile++ ] = id;
+			}
+			for( l = classes->debut[a]; l < classes->debut[a+1]; l++ ){
+				ajouter_transition(
+					res, id_e, (char) t->lettres[ classes->lettres[l] ], id
+				);
 			}
+			debut_bloc = position[a];
 		}
 
-		Ensemble_iterateur it_e;
-		for(
-			it_e = premier_iterateur_ensemble( e );
-			! iterateur_ensemble_est_vide( it_e );
-			it_e = iterateur_suivant_ensemble( it_e )
-		){
-			int elmt = get_element( it_e );
-			if(  est_un_etat_final_de_l_automate( automate, elmt ) ){
+		for( i = 0; i < taille; i++ ){
+			if( t->final[ courant[i] ] ){
 				ajouter_etat_final( res, id_e );	
 				break;
 			}
 		}
-		
 	}
 
-	pour_toute_valeur_table(
-		id_to_ensemble,
-		( void (*)(intptr_t valeur ) ) liberer_ensemble
-	);
-	liberer_table( id_to_ensemble );
-	liberer_table( ensemble_to_id );
-	 
-	liberer_fifo( f );
+	xfree( pile );
+	xfree( position );
+	xfree( cibles );
+	xfree( courant );
+	liberer_table_sous_ensembles( sous_ensembles );
+	liberer_classes_de_lettres( classes );
+	liberer_transitions_denses( t );
+	return res;
+}
+
+int est_deterministe( const Automate* automate ){
+	if( taille_ensemble( get_initiaux( automate ) ) > 1 ) return 0;
+	int id, i;
+	for( id = 0; id < nombre_de_sous_ensembles( automate->numeros ); id++ ){
+		const Liste_transitions * liste = &( automate->adjacences[id].sortantes );
+		for( i = 0; i < liste->nb; i++ ){
+			Ensemble_iterateur fins = premier_iterateur_ensemble(
+				liste->transitions[i].etats
+			);
+			if(
+				! iterateur_ensemble_est_vide( fins ) &&
+				! iterateur_ensemble_est_vide( iterateur_suivant_ensemble( fins ) )
+			) return 0;
+		}
+	}
+	return 1;
+}
+
+/*
+ * Données de l'algorithme de Hopcroft.
+ *
+ * Les états sont numérotés de 0 à nb_etats-1. Les blocs de la partition
+ * sont stockés de manière contigüe dans 'elements' : le bloc b occupe les cases 
+ * elements[debut[b]] ... elements[fin[b]-1].
+ * Les 'marques[b]' premiers éléments d'un bloc sont ceux marqués lors du
+ * traitement du séparateur courant.
+ */
+typedef struct {
+	int nb_etats;
+	int nb_lettres;
+	int nb_blocs;
+	int * elements;
+	int * position;
+	int * bloc;
+	int * debut;
+	int * fin;
+	int * marques;
+	char * en_attente;	// en_attente[ b*nb_lettres + a ]
+	int * attente;		// pile des couples (bloc, lettre) à traiter
+	int nb_attente;
+} Partition_hopcroft;
+
+void hopcroft_mettre_en_attente( Partition_hopcroft* p, int b, int a ){
+	if( p->en_attente[ b*p->nb_lettres + a ] ) return;
+	p->en_attente[ b*p->nb_lettres + a ] = 1;
+	p->attente[ 2*p->nb_attente ] = b;
+	p->attente[ 2*p->nb_attente + 1 ] = a;
+	p->nb_attente++;
+}
+
+void hopcroft_marquer_etat( Partition_hopcroft* p, int q, int * touches, int * nb_touches ){
+	int b = p->bloc[q];
+	int i = p->position[q];
+	int j = p->debut[b] + p->marques[b];
+	if( i < j ) return;
+	// On échange q avec le premier élément non marqué du bloc
+	int r = p->elements[j];
+	p->elements[j] = q;
+	p->position[q] = j;
+	p->elements[i] = r;
+	p->position[r] = i;
+	if( p->marques[b] == 0 ) touches[ (*nb_touches)++ ] = b;
+	p->marques[b]++;
+}
+
+void hopcroft_scinder_bloc( Partition_hopcroft* p, int b ){
+	int taille = p->fin[b] - p->debut[b];
+	int nb_marques = p->marques[b];
+	p->marques[b] = 0;
+	if( nb_marques == taille ) return;
+	// Les éléments marqués forment un nouveau bloc
+	int nouveau = p->nb_blocs++;
+	p->debut[nouveau] = p->debut[b];
+	p->fin[nouveau] = p->debut[b] + nb_marques;
+	p->marques[nouveau] = 0;
+	p->debut[b] = p->fin[nouveau];
+	int i;
+	for( i = p->debut[nouveau]; i < p->fin[nouveau]; i++ ){
+		p->bloc[ p->elements[i] ] = nouveau;
+	}
+	int plus_petit = ( nb_marques <= taille - nb_marques ) ? nouveau : b;
+	int a;
+	for( a = 0; a < p->nb_lettres; a++ ){
+		if( p->en_attente[ b*p->nb_lettres + a ] ){
+			hopcroft_mettre_en_attente( p, nouveau, a );
+		}else{
+			hopcroft_mettre_en_attente( p, plus_petit, a );
+		}
+	}
+}
+
+/*
+ * Données du remplissage de la table de transitions de
+ * creer_automate_minimal_hopcroft().
+ */
+typedef struct {
+	const int * etats;
+	int nb_etats;
+	const int * indice_lettre;
+	int nb_lettres;
+	int * table;
+} Table_hopcroft;
+
+void hopcroft_remplir_table( int origine, char lettre, int fin, void* data ){
+	Table_hopcroft * t = (Table_hopcroft*) data;
+	int q = indice_dans_tableau( t->etats, t->nb_etats, origine );
+	t->table[ q*t->nb_lettres + t->indice_lettre[ (unsigned char) lettre ] ] =
+		indice_dans_tableau( t->etats, t->nb_etats, fin );
+}
+
+/*
+ * Raffine la partition initiale des états d'une table de transitions 
+ * complète jusqu'à la plus grossière partition compatible avec les
+ * transitions (algorithme de Hopcroft, en O( n.m.log n )).
+ */
+int raffiner_partition_hopcroft(
+	const int * table, int nb_etats, int nb_lettres, 
+	const int * etiquette, int nb_etiquettes, int * bloc
+){
+	int N = nb_etats;
+	int m = nb_lettres;
+	int i, a, q, k;
+
+	// Transitions inverses, rangées par (lettre, fin)
+	int * debut_inverse = xmalloc( ( N*m + 1 ) * sizeof(int) );
+	int * inverse = xmalloc( ( N*m > 0 ? N*m : 1 ) * sizeof(int) );
+	for( i = 0; i <= N*m; i++ ) debut_inverse[i] = 0;
+	for( q = 0; q < N; q++ ){
+		for( a = 0; a < m; a++ ){
+			debut_inverse[ a*N + table[ q*m + a ] + 1 ]++;
+		}
+	}
+	for( i = 0; i < N*m; i++ ) debut_inverse[i+1] += debut_inverse[i];
+	int * remplissage = xmalloc( ( N*m > 0 ? N*m : 1 ) * sizeof(int) );
+	for( i = 0; i < N*m; i++ ) remplissage[i] = debut_inverse[i];
+	for( q = 0; q < N; q++ ){
+		for( a = 0; a < m; a++ ){
+			inverse[ remplissage[ a*N + table[ q*m + a ] ]++ ] = q;
+		}
+	}
+	xfree( remplissage );
+
+	// Partition initiale : un bloc par étiquette utilisée, les états étant
+	// rangés par étiquette (tri par dénombrement)
+	Partition_hopcroft p;
+	p.nb_etats = N;
+	p.nb_lettres = m;
+	p.elements = xmalloc( ( N + 1 ) * sizeof(int) );
+	p.position = xmalloc( ( N + 1 ) * sizeof(int) );
+	p.bloc = bloc;
+	p.debut = xmalloc( ( N + 1 ) * sizeof(int) );
+	p.fin = xmalloc( ( N + 1 ) * sizeof(int) );
+	p.marques = xmalloc( ( N + 1 ) * sizeof(int) );
+	p.en_attente = xmalloc( ( N*m > 0 ? N*m : 1 ) );
+	p.attente = xmalloc( ( N*m > 0 ? 2*N*m : 1 ) * sizeof(int) );
+	p.nb_attente = 0;
+	for( i = 0; i < N*m; i++ ) p.en_attente[i] = 0;
+
+	int * taille = xmalloc( ( nb_etiquettes + 1 ) * sizeof(int) );
+	for( i = 0; i <= nb_etiquettes; i++ ) taille[i] = 0;
+	for( q = 0; q < N; q++ ) taille[ etiquette[q] + 1 ]++;
+	for( i = 0; i < nb_etiquettes; i++ ) taille[i+1] += taille[i];
+	for( q = 0; q < N; q++ ) p.elements[ taille[ etiquette[q] ]++ ] = q;
+	xfree( taille );
+
+	p.nb_blocs = 0;
+	int plus_grand = 0;
+	for( i = 0; i < N; i = k ){
+		for( k = i; k < N && etiquette[ p.elements[k] ] == etiquette[ p.elements[i] ]; k++ );
+		p.debut[ p.nb_blocs ] = i;
+		p.fin[ p.nb_blocs ] = k;
+		p.marques[ p.nb_blocs ] = 0;
+		if( k - i > p.fin[ plus_grand ] - p.debut[ plus_grand ] ){
+			plus_grand = p.nb_blocs;
+		}
+		p.nb_blocs++;
+	}
+	for( i = 0; i < p.nb_blocs; i++ ){
+		for( k = p.debut[i]; k < p.fin[i]; k++ ){
+			p.bloc[ p.elements[k] ] = i;
+			p.position[ p.elements[k] ] = k;
+		}
+	}
+	// Tous les blocs sauf le plus grand servent de séparateurs
+	for( i = 0; i < p.nb_blocs; i++ ){
+		if( i == plus_grand ) continue;
+		for( a = 0; a < m; a++ ) hopcroft_mettre_en_attente( &p, i, a );
+	}
+
+	// Raffinement
+	int * touches = xmalloc( ( N + 1 ) * sizeof(int) );
+	int * predecesseurs = xmalloc( ( N + 1 ) * sizeof(int) );
+	while( p.nb_attente > 0 ){
+		p.nb_attente--;
+		int b = p.attente[ 2*p.nb_attente ];
+		a = p.attente[ 2*p.nb_attente + 1 ];
+		p.en_attente[ b*m + a ] = 0;
+
+		// On relève d'abord les prédécesseurs, car le marquage déplace 
+		// les éléments à l'intérieur des blocs (y compris du bloc b).
+		int nb_predecesseurs = 0;
+		for( i = p.debut[b]; i < p.fin[b]; i++ ){
+			int f = p.elements[i];
+			int j;
+			for( j = debut_inverse[ a*N + f ]; j < debut_inverse[ a*N + f + 1 ]; j++ ){
+				predecesseurs[ nb_predecesseurs++ ] = inverse[j];
+			}
+		}
+		int nb_touches = 0;
+		for( i = 0; i < nb_predecesseurs; i++ ){
+			hopcroft_marquer_etat( &p, predecesseurs[i], touches, &nb_touches );
+		}
+		for( i = 0; i < nb_touches; i++ ){
+			hopcroft_scinder_bloc( &p, touches[i] );
+		}
+	}
+	xfree( predecesseurs );
+	xfree( touches );
+
+	xfree( p.elements );
+	xfree( p.position );
+	xfree( p.debut );
+	xfree( p.fin );
+	xfree( p.marques );
+	xfree( p.en_attente );
+	xfree( p.attente );
+	xfree( inverse );
+	xfree( debut_inverse );
+	return p.nb_blocs;
+}
+
+/*
+ * Minimise un automate déterministe par l'algorithme de Hopcroft en 
+ * O( n.|Σ|.log n ).
+ */
+Automate * creer_automate_minimal_hopcroft( const Automate* automate ){
+	int n, m;
+	int * etats = ensemble_vers_tableau( get_etats( automate ), &n );
+	int * lettres = ensemble_vers_tableau( get_alphabet( automate ), &m );
+	int indice_lettre[256];
+	int i, a, q;
+	for( a = 0; a < m; a++ ){
+		indice_lettre[ (unsigned char) lettres[a] ] = a;
+	}
+
+	// Table de transitions complétée par l'état puits n
+	int N = n+1;
+	int * table = xmalloc( ( N*m > 0 ? N*m : 1 ) * sizeof(int) );
+	for( i = 0; i < N*m; i++ ) table[i] = n;
+	Table_hopcroft donnees = { etats, n, indice_lettre, m, table };
+	pour_toute_transition( automate, hopcroft_remplir_table, &donnees );
+
+	// Partition initiale : états finaux / états non finaux
+	int * etiquette = xmalloc( N * sizeof(int) );
+	for( q = 0; q < N; q++ ){
+		etiquette[q] = 
+			q != n && est_un_etat_final_de_l_automate( automate, etats[q] );
+	}
+	int * bloc = xmalloc( N * sizeof(int) );
+	int nb_blocs = raffiner_partition_hopcroft( table, N, m, etiquette, 2, bloc );
+	xfree( etiquette );
+
+	int * representant = xmalloc( nb_blocs * sizeof(int) );
+	for( i = 0; i < nb_blocs; i++ ) representant[i] = -1;
+	for( q = 0; q < N; q++ ){
+		if( representant[ bloc[q] ] == -1 ) representant[ bloc[q] ] = q;
+	}
+
+	// Construction de l'automate quotient, en numérotant les blocs dans
+	// l'ordre d'un parcours en largeur depuis le bloc initial.
+	Automate * res = creer_automate();
+	for( a = 0; a < m; a++ ) ajouter_lettre( res, (char) lettres[a] );
+
+	int initial = n;
+	if( taille_ensemble( get_initiaux( automate ) ) == 1 ){
+		initial = indice_dans_tableau(
+			etats, n, get_element(
+				premier_iterateur_ensemble( get_initiaux( automate ) )
+			)
+		);
+	}
+	int * numero = xmalloc( nb_blocs * sizeof(int) );
+	int * file = xmalloc( nb_blocs * sizeof(int) );
+	for( i = 0; i < nb_blocs; i++ ) numero[i] = -1;
+	int nb_numeros = 0, tete = 0;
+	numero[ bloc[initial] ] = nb_numeros++;
+	file[0] = bloc[initial];
+	ajouter_etat_initial( res, 0 );
+	while( tete < nb_numeros ){
+		int b = file[ tete++ ];
+		int r = representant[b];
+		if( r != n && est_un_etat_final_de_l_automate( automate, etats[r] ) ){
+			ajouter_etat_final( res, numero[b] );
+		}
+		for( a = 0; a < m; a++ ){
+			int c = bloc[ table[ r*m + a ] ];
+			if( numero[c] == -1 ){
+				numero[c] = nb_numeros;
+				file[ nb_numeros++ ] = c;
+			}
+			ajouter_transition( res, numero[b], (char) lettres[a], numero[c] );
+		}
+	}
+
+	xfree( numero );
+	xfree( file );
+	xfree( representant );
+	xfree( bloc );
+	xfree( table );
+	xfree( lettres );
+	xfree( etats );
 	return res;
 }
 
 /*  Renvoie l'automate donné minimalisé.
-*Pour cela, on déterminise l'automate miroir et
-* on le fait deux fois. */
+* Si l'automate est déterministe, on utilise l'algorithme de Hopcroft.
+* Sinon, on déterminise l'automate miroir et on le fait deux fois. */
 Automate * creer_automate_minimal( const Automate* automate ){
+   if( est_deterministe( automate ) ){
+      return creer_automate_minimal_hopcroft( automate );
+   }
 	
    Automate * a = miroir(automate);
    Automate * a1 = creer_automate_deterministe(a); 
@@ -24,6 +24,37 @@
 #define __AUTOMATE_H__
 
 #include "ensemble.h"
+#include "sous_ensembles.h"
+
+/**
+ * @brief Les transitions d'un état étiquetées par une même lettre.
+ *
+ * 'etats' contient les états d'arrivée des transitions (ou les états de
+ * départ, dans l'index inverse).
+ */
+typedef struct Transitions_lettre {
+	int lettre;
+	Ensemble * etats;
+} Transitions_lettre;
+
+/**
+ * @brief Un tableau de Transitions_lettre, trié par lettre croissante.
+ */
+typedef struct Liste_transitions {
+	Transitions_lettre * transitions;
+	int nb;
+	int capacite;
+} Liste_transitions;
+
+/**
+ * @brief Les transitions qui partent d'un état et, si l'index inverse est
+ *        activé, celles qui y arrivent.
+ */
+typedef struct Adjacence {
+	int etat;
+	Liste_transitions sortantes;
+	Liste_transitions entrantes;
+} Adjacence;
 
 /**
  * @brief Le type d'un automate.
@@ -33,6 +64,12 @@
  * type int. Les lettres sont codées par le type char, et l'automate n'accepte 
  * pas d'epsilon transition.
  * L'automate codé peut avoir plusieurs états initiaux.
+ *
+ * Les transitions sont rangées par état de départ : chaque état extrémité
+ * d'une transition, initial ou final reçoit un numéro dense (dans la table
+ * 'numeros') qui indexe son Adjacence dans le tableau 'adjacences'. Les
+ * parcours (accessibles(), automate_emonde(), ...) travaillent directement
+ * sur ces numéros.
  * 
  */
 
@@ -40,18 +77,17 @@ struct Automate {
    	Ensemble * vide; //!<
 	Ensemble * etats;
 	Ensemble * alphabet;
-	Table* transitions;
+	Table_sous_ensembles * numeros; //!< Numéro de l'adjacence de chaque état.
+	Adjacence * adjacences;
+	int capacite_adjacences;
+	int adjacences_en_ordre; //!< Vrai si les adjacences sont rangées par état croissant.
+	int index_inverse;
 	Ensemble * initiaux;
 	Ensemble * finaux;
 };
 
 typedef struct Automate Automate;
 
-typedef struct Cle {
-	int origine;
-	int lettre;
-} Cle;
-
 /**
  * @brief Crée un automate vide, sans états, sans lettres et sans transitions.
  *
@@ -275,6 +311,9 @@ int le_mot_est_reconnu( const Automate* automate, const char* mot );
  * Le paramètre 'data' est un pointeur qui sera identique à celui passé par le
  * paramètre 'data' de la fonction pour_toute_transition().
  *
+ * Les transitions sont parcourues par origine croissante, puis par lettre
+ * croissante, puis par fin croissante.
+ *
  * @param automate Un automate.
  * @param action La fonction à exécuter.
  * @param data La donnée supplémentaire à passer en paramètre à la fonction 
@@ -286,6 +325,123 @@ void pour_toute_transition(
 	void* data
 );
 
+/**
+ * @brief Renvoie l'ensemble des états atteints depuis 'origine' en lisant
+ *        'lettre'.
+ *
+ * L'ensemble renvoyé appartient à l'automate et ne doit pas être libéré.
+ *
+ * @param automate Un automate.
+ * @param origine Un état.
+ * @param lettre Une lettre.
+ * @return L'ensemble des fins des transitions (origine, lettre, .).
+ */ 
+const Ensemble * voisins( const Automate* automate, int origine, char lettre );
+
+/**
+ * @brief Active l'index inverse de l'automate : pour chaque état, les
+ *        transitions qui y arrivent sont rangées par lettre.
+ *
+ * L'index est construit à partir des transitions existantes, puis tenu à
+ * jour par ajouter_transition(), qui coûte alors deux insertions.
+ *
+ * @param automate Un automate.
+ */ 
+void activer_index_inverse( Automate * automate );
+
+/**
+ * @brief Renvoie l'ensemble des états depuis lesquels on atteint 'fin' en
+ *        lisant 'lettre'.
+ *
+ * L'index inverse doit avoir été activé par activer_index_inverse().
+ * L'ensemble renvoyé appartient à l'automate et ne doit pas être libéré.
+ *
+ * @param automate Un automate.
+ * @param fin Un état.
+ * @param lettre Une lettre.
+ * @return L'ensemble des origines des transitions (., lettre, fin).
+ */ 
+const Ensemble * predecesseurs( const Automate* automate, int fin, char lettre );
+
+/**
+ * @brief Crée un automate dont les états sont 0, 1, ..., nb_etats-1, sans
+ *        transition, prêt à être rempli état par état par
+ *        remplir_etat_automate().
+ *
+ * Le numéro d'adjacence de chaque état est l'état lui-même, et le tableau
+ * des adjacences a déjà sa taille définitive.
+ *
+ * @param nb_etats Le nombre d'états.
+ * @return L'automate.
+ */
+Automate * creer_automate_etats_consecutifs( int nb_etats );
+
+/**
+ * @brief Range d'un coup toutes les transitions sortantes d'un état d'un
+ *        automate créé par creer_automate_etats_consecutifs().
+ *
+ * Les lettres doivent être distinctes, triées par ordre croissant (comme
+ * des char) et déjà dans l'alphabet ; les fins doivent être des états de
+ * l'automate ; l'état ne doit pas encore avoir de transition, et l'index
+ * inverse ne doit pas être activé.
+ *
+ * Seule l'adjacence de l'état est modifiée : plusieurs fils d'exécution
+ * peuvent remplir des états différents en même temps.
+ *
+ * @param automate Un automate créé par creer_automate_etats_consecutifs().
+ * @param etat L'état.
+ * @param nb Le nombre de transitions.
+ * @param lettres Les lettres des transitions.
+ * @param fins Les fins des transitions.
+ */
+void remplir_etat_automate(
+	Automate * automate, int etat, int nb, const char * lettres, const int * fins
+);
+
+/**
+ * @brief Calcule les classes de lettres de l'automate.
+ *
+ * Deux lettres sont dans la même classe si, depuis chaque état, elles mènent
+ * au même ensemble d'états : on peut alors les traiter comme une seule
+ * lettre. La partition calculée est la moins fine ayant cette propriété.
+ *
+ * Les classes sont numérotées de 0 à n-1 dans l'ordre de leur plus petite 
+ * lettre. classes[ (unsigned char) lettre ] reçoit la classe de chaque lettre
+ * de l'alphabet, et -1 pour les octets qui ne sont pas dans l'alphabet.
+ *
+ * @param automate Un automate.
+ * @param classes Un tableau de 256 entiers, rempli par la fonction.
+ * @return Le nombre n de classes.
+ */ 
+int classes_de_lettres( const Automate * automate, int classes[256] );
+
+/**
+ * @brief Calcule les classes de lettres (voir classes_de_lettres()) d'un
+ *        graphe de transitions déjà rangé par état, sans repasser par
+ *        l'automate.
+ *
+ * Les états sont numérotés de 0 à nb_etats-1. Les entrées de l'état q sont
+ * les indices debut[q] ... debut[q+1]-1 ; l'entrée e porte la lettre
+ * lettre[e] et les fins fins[ debut_fins[e] ] ... fins[ debut_fins[e+1]-1 ],
+ * triées par ordre croissant. Les entrées d'un état ont des lettres
+ * distinctes. Le temps de calcul est linéaire en le nombre de transitions,
+ * au tri près des lettres de chaque état.
+ *
+ * @param alphabet L'alphabet.
+ * @param nb_etats Le nombre d'états.
+ * @param debut Le début des entrées de chaque état (nb_etats+1 entiers).
+ * @param lettre La lettre de chaque entrée.
+ * @param debut_fins Le début des fins de chaque entrée.
+ * @param fins Les fins.
+ * @param classes Un tableau de 256 entiers, rempli par la fonction.
+ * @return Le nombre de classes.
+ */
+int classes_de_lettres_entrees(
+	const Ensemble * alphabet, int nb_etats, const int * debut,
+	const char * lettre, const int * debut_fins, const int * fins,
+	int classes[256]
+);
+
 /**
  * @brief Renvoie l'état ayant le numéro le plus grand de l'automate passé en 
  *        paramètre.
@@ -348,6 +504,36 @@ Ensemble* accessibles( const Automate * automate );
  */ 
 Automate *automate_accessible( const Automate * automate );
 
+/**
+ * @brief Renvoie l'ensemble des états co-accessibles, c'est-à-dire des états
+ *        à partir desquels on peut atteindre un état final.
+ *
+ * @param automate Un automate.
+ * @return L'ensemble des états co-accessibles.
+ */ 
+Ensemble* co_accessibles( const Automate * automate );
+
+/**
+ * @brief Renvoie l'automate passé en paramètre dont les états non 
+ *        co-accessibles ont été supprimés.
+ *
+ * @param automate Un automate.
+ * @return L'automate co-accessible.
+ */ 
+Automate *automate_co_accessible( const Automate * automate );
+
+/**
+ * @brief Renvoie l'automate émondé : seuls les états à la fois accessibles et
+ *        co-accessibles sont conservés.
+ *
+ * L'automate émondé reconnaît le même langage que l'automate passé en 
+ * paramètre.
+ *
+ * @param automate Un automate.
+ * @return L'automate émondé.
+ */ 
+Automate *automate_emonde( const Automate * automate );
+
 /**
  * @brief @todo Renvoie l'automate miroir d'un automate.
  *
@@ -367,9 +553,43 @@ Automate *miroir( const Automate * automate);
 void print_automate( const Automate * automate );
 
 
+/**
+ * @brief Opérations booléennes réalisables par creer_produit_des_automates().
+ */
+typedef enum Operation_produit {
+	PRODUIT_INTERSECTION,			//!< L1 ∩ L2
+	PRODUIT_UNION,					//!< L1 ∪ L2
+	PRODUIT_DIFFERENCE,				//!< L1 \ L2
+	PRODUIT_DIFFERENCE_SYMETRIQUE	//!< L1 ⊕ L2
+} Operation_produit;
+
+/**
+ * @brief Crée l'automate produit de deux automates, reconnaissant le langage
+ *        obtenu par l'opération booléenne passée en paramètre.
+ *
+ * Seuls les couples d'états accessibles depuis les couples initiaux sont 
+ * construits, et, pour chaque couple, seules les lettres qui sortent des 
+ * composantes utiles sont parcourues. Les états de l'automate produit sont
+ * numérotés à partir de 0 dans l'ordre d'un parcours en largeur.
+ *
+ * Pour PRODUIT_DIFFERENCE, le second automate est déterminisé s'il ne l'est
+ * pas ; pour PRODUIT_DIFFERENCE_SYMETRIQUE, les deux automates le sont.
+ * Les automates n'ont pas besoin d'être complets.
+ *
+ * @param automate_1 Le premier automate.
+ * @param automate_2 Le second automate.
+ * @param operation L'opération booléenne.
+ * @return L'automate produit.
+ */
+Automate * creer_produit_des_automates(
+	const Automate * automate_1, const Automate * automate_2,
+	Operation_produit operation
+);
+
 /**
  * @brief Crée l'intersection de deux automates.
  *
+ * Équivalent à creer_produit_des_automates() avec PRODUIT_INTERSECTION.
  */
 Automate * creer_intersection_des_automates(
 	const Automate * automate_1, const Automate * automate_2
@@ -384,13 +604,71 @@ Automate * creer_intersection_des_automates(
 Automate * creer_automate_deterministe( const Automate* automate );
 
 /**
- * @brief @todo Renvoie l'automate minimal.
+ * @brief Renvoie l'automate minimal.
+ *
+ * Si l'automate est déterministe, la minimisation est faite par 
+ * l'algorithme de Hopcroft (voir creer_automate_minimal_hopcroft()).
+ * Sinon, on utilise l'algorithme de Brzozowski (double déterminisation de
+ * l'automate miroir).
+ *
+ * Dans les deux cas, l'automate renvoyé est déterministe, accessible et
+ * complet sur l'alphabet de l'automate passé en paramètre : il contient un
+ * état puits lorsque le langage en a besoin, et son nombre d'états ne
+ * dépend donc pas du chemin suivi.
  *
  * @param automate L'automate à minimiser.
  * @return L'automate minimal correspondant.
  */ 
 Automate * creer_automate_minimal( const Automate* automate );
 
+/**
+ * @brief Renvoie 1 si l'automate est déterministe et 0 sinon.
+ *
+ * Un automate est déterministe s'il possède au plus un état initial et si,
+ * pour tout état et toute lettre, il existe au plus une transition.
+ * L'automate n'a pas besoin d'être complet.
+ *
+ * @param automate Un automate.
+ * @return 1 ou 0.
+ */
+int est_deterministe( const Automate* automate );
+
+/**
+ * @brief Renvoie l'automate minimal d'un automate déterministe, calculé par
+ *        l'algorithme de Hopcroft en O( n.|Σ|.log n ).
+ *
+ * L'automate renvoyé est complet sur l'alphabet de l'automate passé en 
+ * paramètre. Ses états sont numérotés à partir de 0, l'état initial.
+ *
+ * @param automate L'automate déterministe à minimiser.
+ * @return L'automate minimal correspondant.
+ */
+Automate * creer_automate_minimal_hopcroft( const Automate* automate );
+
+/**
+ * @brief Calcule, par l'algorithme de Hopcroft, l'équivalence de Nerode 
+ *        d'une table de transitions complète dont les états sont étiquetés.
+ *
+ * Les états sont numérotés de 0 à nb_etats-1 et les lettres de 0 à
+ * nb_lettres-1 ; table[ q*nb_lettres + a ] est l'état atteint depuis q par
+ * la lettre a. Deux états sont dans le même bloc si et seulement si tout
+ * mot mène depuis ces deux états à des états de même étiquette. Avec les
+ * étiquettes final / non final, c'est la minimisation habituelle.
+ *
+ * @param table La table de transitions.
+ * @param nb_etats Le nombre d'états.
+ * @param nb_lettres Le nombre de lettres.
+ * @param etiquette L'étiquette de chaque état, entre 0 et nb_etiquettes-1.
+ * @param nb_etiquettes Le nombre d'étiquettes.
+ * @param bloc Un tableau de nb_etats entiers, qui reçoit le bloc de chaque
+ *        état.
+ * @return Le nombre de blocs, numérotés à partir de 0.
+ */
+int raffiner_partition_hopcroft(
+	const int * table, int nb_etats, int nb_lettres, 
+	const int * etiquette, int nb_etiquettes, int * bloc
+);
+
 /**
  * @brief Renvoie le nombre de transitions d'un automate.
  *
@@ -2,23 +2,40 @@
 #define __AUTOMATE_H__
 
 #include "ensemble.h"
+#include "sous_ensembles.h"
+
+typedef struct Transitions_lettre {
+	int lettre;
+	Ensemble * etats;
+} Transitions_lettre;
+
+typedef struct Liste_transitions {
+	Transitions_lettre * transitions;
+	int nb;
+	int capacite;
+} Liste_transitions;
+
+typedef struct Adjacence {
+	int etat;
+	Liste_transitions sortantes;
+	Liste_transitions entrantes;
+} Adjacence;
 
 struct Automate {
    	Ensemble * vide;
 	Ensemble * etats;
 	Ensemble * alphabet;
-	Table* transitions;
+	Table_sous_ensembles * numeros;
+	Adjacence * adjacences;
+	int capacite_adjacences;
+	int adjacences_en_ordre;
+	int index_inverse;
 	Ensemble * initiaux;
 	Ensemble * finaux;
 };
 
 typedef struct Automate Automate;
 
-typedef struct Cle {
-	int origine;
-	int lettre;
-} Cle;
-
 Automate * creer_automate();
 void liberer_automate( Automate * automate);
 
@@ -43,17 +60,31 @@ Ensemble * delta( const Automate* automate, const Ensemble * etats_courants, cha
 Ensemble * delta_star( const Automate* automate, const Ensemble * etats_courants, const char* mot );
 int le_mot_est_reconnu( const Automate* automate, const char* mot );
 void pour_toute_transition( const Automate* automate, void (* action )( int origine, char lettre, int fin, void* data ), void* data );
+const Ensemble * voisins( const Automate* automate, int origine, char lettre );
+void activer_index_inverse( Automate * automate );
+const Ensemble * predecesseurs( const Automate* automate, int fin, char lettre );
+Automate * creer_automate_etats_consecutifs( int nb_etats );
+void remplir_etat_automate( Automate * automate, int etat, int nb, const char * lettres, const int * fins );
+int classes_de_lettres( const Automate * automate, int classes[256] );
+int classes_de_lettres_entrees( const Ensemble * alphabet, int nb_etats, const int * debut, const char * lettre, const int * debut_fins, const int * fins, int classes[256] );
 int get_max_etat( const Automate* automate );
 int get_min_etat( const Automate* automate );
 Automate* copier_automate( const Automate* automate );
 Ensemble* etats_accessibles( const Automate * automate, int etat );
 Ensemble* accessibles( const Automate * automate );
 Automate *automate_accessible( const Automate * automate );
+Ensemble* co_accessibles( const Automate * automate );
+Automate *automate_co_accessible( const Automate * automate );
+Automate *automate_emonde( const Automate * automate );
 Automate *miroir( const Automate * automate);
 void print_automate( const Automate * automate );
+typedef enum Operation_produit { PRODUIT_INTERSECTION, PRODUIT_UNION, PRODUIT_DIFFERENCE, PRODUIT_DIFFERENCE_SYMETRIQUE } Operation_produit;
+Automate * creer_produit_des_automates( const Automate * automate_1, const Automate * automate_2, Operation_produit operation );
 Automate * creer_intersection_des_automates( const Automate * automate_1, const Automate * automate_2 );
 Automate * creer_automate_deterministe( const Automate* automate );
 Automate * creer_automate_minimal( const Automate* automate );
+int est_deterministe( const Automate* automate );
+Automate * creer_automate_minimal_hopcroft( const Automate* automate );
 int nombre_de_transitions( const Automate* automate );
 
 #endif
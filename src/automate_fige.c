@@ -0,0 +1,306 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "automate_fige.h"
+#include "bitset.h"
+#include "sous_ensembles.h"
+#include "outils.h"
+
+#include <string.h>
+
+/*
+ * Taille maximale, en mots, des masques de successeurs. Au-delà, ou si les
+ * ensembles d'états occupent plus de MOTS_MAX_MASQUES mots (un « ou » de
+ * nb_mots mots coûte alors plus cher que d'ajouter les fins une à une),
+ * delta_fige() utilise les entrées.
+ */
+#define TAILLE_MAX_MASQUES ( (size_t) 1 << 22 )
+#define MOTS_MAX_MASQUES 8
+
+/*
+ * Données du remplissage des tableaux par pour_toute_transition(), qui
+ * parcourt les transitions par origine, puis lettre, puis fin croissantes.
+ */
+typedef struct {
+	Automate_fige * res;
+	Table_sous_ensembles * numeros;
+	int capacite_entrees;
+	int capacite_transitions;
+	int origine;	// numéro dense de l'origine de la dernière entrée
+} Donnees_figer;
+
+int numero_dense( const Table_sous_ensembles * numeros, int etat ){
+	return trouver_sous_ensemble( numeros, &etat, 1 );
+}
+
+void action_figer_transition( int origine, char lettre, int fin, void* data ){
+	Donnees_figer * d = (Donnees_figer*) data;
+	Automate_fige * res = d->res;
+	int q = numero_dense( d->numeros, origine );
+
+	// Nouvelle entrée si l'origine ou la lettre change
+	if(
+		res->nb_entrees == 0 || d->origine != q ||
+		res->lettre[ res->nb_entrees - 1 ] != lettre
+	){
+		if( res->nb_entrees + 1 >= d->capacite_entrees ){
+			d->capacite_entrees *= 2;
+			res->lettre = xrealloc( res->lettre, d->capacite_entrees );
+			res->debut_fins = xrealloc(
+				res->debut_fins, d->capacite_entrees * sizeof(int)
+			);
+		}
+		// Les états sans transition entre d->origine et q ont 0 entrée
+		while( d->origine < q ){
+			d->origine++;
+			res->debut[ d->origine ] = res->nb_entrees;
+		}
+		res->lettre[ res->nb_entrees ] = lettre;
+		res->debut_fins[ res->nb_entrees ] = res->nb_transitions;
+		res->nb_entrees++;
+	}
+
+	if( res->nb_transitions == d->capacite_transitions ){
+		d->capacite_transitions *= 2;
+		res->fins = xrealloc(
+			res->fins, d->capacite_transitions * sizeof(int)
+		);
+	}
+	res->fins[ res->nb_transitions++ ] = numero_dense( d->numeros, fin );
+}
+
+Automate_fige * figer_automate( const Automate * automate ){
+	Automate_fige * res = xmalloc( sizeof(Automate_fige) );
+	Ensemble_iterateur it;
+	int i;
+
+	res->etats = ensemble_vers_tableau( get_etats( automate ), &res->nb_etats );
+	int n = res->nb_etats;
+	Donnees_figer d;
+	d.res = res;
+	d.numeros = creer_table_sous_ensembles();
+	for( i = 0; i < n; i++ ){
+		interner_sous_ensemble( d.numeros, res->etats + i, 1, NULL );
+	}
+
+	d.capacite_entrees = 16;
+	d.capacite_transitions = 16;
+	d.origine = -1;
+	res->nb_entrees = 0;
+	res->nb_transitions = 0;
+	res->debut = xmalloc( ( n + 1 ) * sizeof(int) );
+	res->lettre = xmalloc( d.capacite_entrees );
+	res->debut_fins = xmalloc( d.capacite_entrees * sizeof(int) );
+	res->fins = xmalloc( d.capacite_transitions * sizeof(int) );
+	pour_toute_transition( automate, action_figer_transition, &d );
+	while( d.origine < n ){
+		d.origine++;
+		res->debut[ d.origine ] = res->nb_entrees;
+	}
+	res->debut_fins[ res->nb_entrees ] = res->nb_transitions;
+
+	res->nb_mots = BITSET_NB_MOTS( n );
+	res->initiaux = xmalloc( ( res->nb_mots + 1 ) * sizeof(uint64_t) );
+	res->finaux = xmalloc( ( res->nb_mots + 1 ) * sizeof(uint64_t) );
+	memset( res->initiaux, 0, ( res->nb_mots + 1 ) * sizeof(uint64_t) );
+	memset( res->finaux, 0, ( res->nb_mots + 1 ) * sizeof(uint64_t) );
+	for(
+		it = premier_iterateur_ensemble( get_initiaux( automate ) );
+		! iterateur_ensemble_est_vide( it );
+		it = iterateur_suivant_ensemble( it )
+	){
+		BITSET_AJOUTER( res->initiaux, numero_dense( d.numeros, get_element( it ) ) );
+	}
+	for(
+		it = premier_iterateur_ensemble( get_finaux( automate ) );
+		! iterateur_ensemble_est_vide( it );
+		it = iterateur_suivant_ensemble( it )
+	){
+		BITSET_AJOUTER( res->finaux, numero_dense( d.numeros, get_element( it ) ) );
+	}
+
+	liberer_table_sous_ensembles( d.numeros );
+
+	res->masques = NULL;
+	// Les classes sont calculées sur les tableaux qui viennent d'être remplis
+	res->nb_classes = classes_de_lettres_entrees(
+		get_alphabet( automate ), n, res->debut, res->lettre,
+		res->debut_fins, res->fins, res->classe
+	);
+	size_t w = res->nb_mots;
+	size_t taille = (size_t) res->nb_classes * n * w;
+	if( w <= MOTS_MAX_MASQUES && taille <= TAILLE_MAX_MASQUES ){
+		res->masques = xmalloc( ( taille + 1 ) * sizeof(uint64_t) );
+		memset( res->masques, 0, ( taille + 1 ) * sizeof(uint64_t) );
+		int q, e, k;
+		for( q = 0; q < n; q++ ){
+			for( e = res->debut[q]; e < res->debut[q+1]; e++ ){
+				int c = res->classe[ (unsigned char) res->lettre[e] ];
+				uint64_t * masque =
+					res->masques + ( (size_t) c * n + q ) * w;
+				for( k = res->debut_fins[e]; k < res->debut_fins[e+1]; k++ ){
+					BITSET_AJOUTER( masque, res->fins[k] );
+				}
+			}
+		}
+	}
+	return res;
+}
+
+void liberer_automate_fige( Automate_fige * automate ){
+	xfree( automate->etats );
+	xfree( automate->debut );
+	xfree( automate->lettre );
+	xfree( automate->debut_fins );
+	xfree( automate->fins );
+	xfree( automate->initiaux );
+	xfree( automate->finaux );
+	xfree( automate->masques );
+	xfree( automate );
+}
+
+size_t nombre_de_mots_fige( const Automate_fige * automate ){
+	return automate->nb_mots;
+}
+
+int numero_etat_fige( const Automate_fige * automate, int etat ){
+	return indice_dans_tableau( automate->etats, automate->nb_etats, etat );
+}
+
+/*
+ * Renvoie l'indice de l'entrée de l'état q étiquetée par 'lettre', ou -1.
+ * Les entrées d'un état sont peu nombreuses et triées par lettre.
+ */
+int entree_fige( const Automate_fige * automate, int q, char lettre ){
+	int e;
+	for( e = automate->debut[q]; e < automate->debut[q+1]; e++ ){
+		if( automate->lettre[e] == lettre ) return e;
+		if( automate->lettre[e] > lettre ) break;
+	}
+	return -1;
+}
+
+void delta_fige(
+	const Automate_fige * automate, const uint64_t * etats_courants,
+	char lettre, uint64_t * resultat
+){
+	size_t w = automate->nb_mots;
+	size_t i, j;
+	int k;
+	memset( resultat, 0, w * sizeof(uint64_t) );
+	if( automate->masques ){
+		int c = automate->classe[ (unsigned char) lettre ];
+		if( c < 0 ) return;
+		const uint64_t * masques =
+			automate->masques + (size_t) c * automate->nb_etats * w;
+		for( i = 0; i < w; i++ ){
+			uint64_t mot = etats_courants[i];
+			while( mot ){
+				size_t q = i * BITSET_BITS + __builtin_ctzll( mot );
+				mot &= mot - 1;
+				const uint64_t * masque = masques + q * w;
+				for( j = 0; j < w; j++ ) resultat[j] |= masque[j];
+			}
+		}
+		return;
+	}
+	for( i = 0; i < w; i++ ){
+		uint64_t mot = etats_courants[i];
+		while( mot ){
+			int q = (int) ( i * BITSET_BITS ) + __builtin_ctzll( mot );
+			mot &= mot - 1;
+			int e = entree_fige( automate, q, lettre );
+			if( e < 0 ) continue;
+			for( k = automate->debut_fins[e]; k < automate->debut_fins[e+1]; k++ ){
+				BITSET_AJOUTER( resultat, automate->fins[k] );
+			}
+		}
+	}
+}
+
+/*
+ * Lit le mot depuis 'etats_courants' en alternant entre 'resultat' et
+ * 'tampon' ; renvoie celui des deux qui contient l'ensemble atteint.
+ */
+uint64_t * lire_mot_fige(
+	const Automate_fige * automate, const uint64_t * etats_courants,
+	const char * mot, uint64_t * resultat, uint64_t * tampon
+){
+	size_t nb_mots = automate->nb_mots;
+	uint64_t * courant = tampon;
+	uint64_t * suivant = resultat;
+	memcpy( courant, etats_courants, nb_mots * sizeof(uint64_t) );
+	for( ; *mot; mot++ ){
+		delta_fige( automate, courant, *mot, suivant );
+		uint64_t * tmp = courant;
+		courant = suivant;
+		suivant = tmp;
+		if( bitset_est_vide( courant, nb_mots ) ) break;
+	}
+	return courant;
+}
+
+/*
+ * Au-delà de cette taille (en mots), les tampons sont alloués sur le tas.
+ */
+#define TAMPON_PILE_FIGE 64
+
+void delta_star_fige(
+	const Automate_fige * automate, const uint64_t * etats_courants,
+	const char * mot, uint64_t * resultat
+){
+	size_t nb_mots = automate->nb_mots;
+	uint64_t pile[ TAMPON_PILE_FIGE ];
+	uint64_t * tampon = nb_mots <= TAMPON_PILE_FIGE ?
+		pile : xmalloc( nb_mots * sizeof(uint64_t) );
+	uint64_t * fin = lire_mot_fige(
+		automate, etats_courants, mot, resultat, tampon
+	);
+	if( fin != resultat ){
+		memcpy( resultat, fin, nb_mots * sizeof(uint64_t) );
+	}
+	if( tampon != pile ) xfree( tampon );
+}
+
+int le_mot_est_reconnu_fige( const Automate_fige * automate, const char * mot ){
+	size_t nb_mots = automate->nb_mots;
+	uint64_t pile[ 2 * TAMPON_PILE_FIGE ];
+	uint64_t * tampon = nb_mots <= TAMPON_PILE_FIGE ?
+		pile : xmalloc( 2 * nb_mots * sizeof(uint64_t) );
+	uint64_t * fin = lire_mot_fige(
+		automate, automate->initiaux, mot, tampon, tampon + nb_mots
+	);
+	bitset_intersection( fin, automate->finaux, nb_mots );
+	int res = ! bitset_est_vide( fin, nb_mots );
+	if( tampon != pile ) xfree( tampon );
+	return res;
+}
+
+int est_une_transition_de_l_automate_fige(
+	const Automate_fige * automate, int origine, char lettre, int fin
+){
+	int q = numero_etat_fige( automate, origine );
+	int r = numero_etat_fige( automate, fin );
+	if( q < 0 || r < 0 ) return 0;
+	int e = entree_fige( automate, q, lettre );
+	if( e < 0 ) return 0;
+	return indice_dans_tableau(
+		automate->fins + automate->debut_fins[e],
+		automate->debut_fins[e+1] - automate->debut_fins[e], r
+	) >= 0;
+}
@@ -0,0 +1,170 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file automate_fige.h */
+
+#ifndef __AUTOMATE_FIGE_H__
+#define __AUTOMATE_FIGE_H__
+
+#include "automate.h"
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief Le type d'un automate figé.
+ *
+ * Un automate figé est une copie en lecture seule d'un Automate, rangée dans
+ * des tableaux contigus (format « compressed sparse row ») :
+ *  - les états sont renumérotés de 0 à nb_etats-1, dans l'ordre croissant ;
+ *    etats[i] est l'état d'origine de numéro i ;
+ *  - les transitions de l'état q sont regroupées par lettre dans les entrées
+ *    debut[q] ... debut[q+1]-1 ; l'entrée e porte la lettre lettre[e] et
+ *    ses fins sont fins[ debut_fins[e] ] ... fins[ debut_fins[e+1]-1 ] ;
+ *  - les états initiaux et finaux sont codés par des tableaux de bits ;
+ *  - classe[ octet ] est la classe de lettres de l'octet (voir
+ *    classes_de_lettres()), ou -1 s'il n'est pas dans l'alphabet ;
+ *  - lorsque les ensembles d'états sont petits, masques contient, pour
+ *    chaque classe de lettres c et chaque état q, l'ensemble des
+ *    successeurs de q par les lettres de c, codé par un tableau de bits
+ *    (masques[ ( c * nb_etats + q ) * nb_mots ... ]) ;
+ *    delta_fige() calcule alors les successeurs par des « ou » mot à mot,
+ *    sans chercher les entrées. Sinon, masques vaut NULL.
+ *
+ * Les fonctions de ce fichier manipulent des ensembles d'états codés par des
+ * tableaux de nombre_de_mots_fige() mots de 64 bits (voir bitset.h), indexés
+ * par les numéros denses des états.
+ *
+ * Un automate figé n'est jamais modifié après sa création : il peut être lu
+ * par plusieurs fils d'exécution à la fois sans verrou.
+ */
+typedef struct Automate_fige {
+	int nb_etats;
+	int * etats;
+	int nb_entrees;
+	int * debut;
+	char * lettre;
+	int * debut_fins;
+	int nb_transitions;
+	int * fins;
+	size_t nb_mots;
+	uint64_t * initiaux;
+	uint64_t * finaux;
+	int nb_classes;
+	int classe[256];
+	uint64_t * masques;
+} Automate_fige;
+
+/**
+ * @brief Fige un automate.
+ *
+ * Les transitions sont lues en un seul passage, et les classes de lettres
+ * sont calculées sur les tableaux ainsi remplis (voir
+ * classes_de_lettres_entrees()). Le temps de calcul est linéaire en la
+ * taille de l'automate, au tri près des états (s'ils n'ont pas été créés
+ * dans l'ordre croissant) et des lettres sortant de chaque état. L'automate
+ * figé ne dépend pas de l'automate passé en paramètre, qui peut ensuite être
+ * modifié ou libéré.
+ *
+ * @param automate Un automate.
+ * @return L'automate figé.
+ */
+Automate_fige * figer_automate( const Automate * automate );
+
+/**
+ * @brief Libère la mémoire d'un automate figé.
+ *
+ * @param automate Un automate figé.
+ */
+void liberer_automate_fige( Automate_fige * automate );
+
+/**
+ * @brief Renvoie le nombre de mots de 64 bits d'un ensemble d'états de
+ *        l'automate figé.
+ *
+ * @param automate Un automate figé.
+ */
+size_t nombre_de_mots_fige( const Automate_fige * automate );
+
+/**
+ * @brief Renvoie le numéro dense d'un état de l'automate d'origine, ou -1 si
+ *        l'état n'est pas dans l'automate.
+ *
+ * @param automate Un automate figé.
+ * @param etat Un état de l'automate d'origine.
+ */
+int numero_etat_fige( const Automate_fige * automate, int etat );
+
+/**
+ * @brief Calcule l'ensemble des états atteints depuis 'etats_courants' en
+ *        lisant 'lettre'.
+ *
+ * 'resultat' doit pouvoir contenir nombre_de_mots_fige() mots, et ne doit
+ * pas être le même tableau que 'etats_courants'.
+ *
+ * @param automate Un automate figé.
+ * @param etats_courants L'ensemble des états origines.
+ * @param lettre Une lettre.
+ * @param resultat L'ensemble des états atteints.
+ */
+void delta_fige(
+	const Automate_fige * automate, const uint64_t * etats_courants,
+	char lettre, uint64_t * resultat
+);
+
+/**
+ * @brief Calcule l'ensemble des états atteints depuis 'etats_courants' en
+ *        lisant le mot 'mot'.
+ *
+ * 'resultat' doit pouvoir contenir nombre_de_mots_fige() mots ; il peut être
+ * le même tableau que 'etats_courants'.
+ *
+ * @param automate Un automate figé.
+ * @param etats_courants L'ensemble des états origines.
+ * @param mot Le mot à lire.
+ * @param resultat L'ensemble des états atteints.
+ */
+void delta_star_fige(
+	const Automate_fige * automate, const uint64_t * etats_courants,
+	const char * mot, uint64_t * resultat
+);
+
+/**
+ * @brief Renvoie 1 si le mot est reconnu par l'automate figé et 0 sinon.
+ *
+ * @param automate Un automate figé.
+ * @param mot Un mot.
+ */
+int le_mot_est_reconnu_fige( const Automate_fige * automate, const char * mot );
+
+/**
+ * @brief Renvoie 1 si (origine, lettre, fin) est une transition de
+ *        l'automate et 0 sinon.
+ *
+ * Les états sont ceux de l'automate d'origine.
+ *
+ * @param automate Un automate figé.
+ * @param origine Un état.
+ * @param lettre Une lettre.
+ * @param fin Un état.
+ */
+int est_une_transition_de_l_automate_fige(
+	const Automate_fige * automate, int origine, char lettre, int fin
+);
+
+#endif
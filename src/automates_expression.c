@@ -0,0 +1,400 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "automates_expression.h"
+#include "bitset.h"
+#include "outils.h"
+#include "sous_ensembles.h"
+
+#include <string.h>
+
+/*
+ * Les termes sont internés sous forme de n-uplets dans une
+ * Table_sous_ensembles ; le premier élément du n-uplet en donne la sorte.
+ * Une concaténation est représentée par la liste aplatie de ses facteurs,
+ * qui ne sont jamais des concaténations, ni le mot vide.
+ */
+#define TERME_LETTRE 0			// ( 0, lettre )
+#define TERME_EPSILON 1			// ( 1 )
+#define TERME_ETOILE 2			// ( 2, fils )
+#define TERME_UNION 3			// ( 3, plus petit fils, plus grand fils )
+#define TERME_CONCAT 4			// ( 4, liste des facteurs )
+#define TERME_LISTE 5			// ( 5, tête, queue )
+#define LISTE_VIDE -1
+
+/*
+ * Les données de l'automate des positions d'une expression. Les noeuds de
+ * l'expression sont numérotés dans l'ordre préfixe, les positions de 1 à
+ * nb_positions de gauche à droite (comme numeroter_rationnel()). La
+ * position 0 est l'état initial.
+ */
+typedef struct {
+	Table_sous_ensembles * termes;
+	int nb_noeuds;
+	int * terme;				// terme[k] : terme du noeud k
+	int * liste;				// liste[k] : facteurs du noeud k
+	int * taille;				// taille[k] : nombre de noeuds du sous-arbre k
+
+	int nb_positions;
+	char * lettre;				// lettre[p] pour 1 <= p <= nb_positions
+	size_t w;
+	uint64_t * suivants;		// suivants + p * w ; la ligne 0 est premier()
+	uint64_t * finaux;
+	int * continuation;			// liste de la c-continuation de p
+} Positions_expression;
+
+int interner_terme(
+	Table_sous_ensembles * termes, int sorte, int a, int b, int n
+){
+	int t[3] = { sorte, a, b };
+	return interner_sous_ensemble( termes, t, n, NULL );
+}
+
+int cons_terme( Table_sous_ensembles * termes, int tete, int queue ){
+	return interner_terme( termes, TERME_LISTE, tete, queue, 3 );
+}
+
+/*
+ * Renvoie la liste des éléments de 'liste' suivis de ceux de 'queue'.
+ */
+int concatener_listes( Table_sous_ensembles * termes, int liste, int queue ){
+	int n = 0, l, taille;
+	const int * t;
+	for( l = liste; l != LISTE_VIDE; l = t[2] ){
+		t = get_sous_ensemble( termes, l, &taille );
+		n++;
+	}
+	int * elements = xmalloc( ( n + 1 ) * sizeof(int) );
+	int i = 0;
+	for( l = liste; l != LISTE_VIDE; l = t[2] ){
+		t = get_sous_ensemble( termes, l, &taille );
+		elements[ i++ ] = t[1];
+	}
+	while( i > 0 ) queue = cons_terme( termes, elements[ --i ], queue );
+	xfree( elements );
+	return queue;
+}
+
+int compter_noeuds( const Rationnel * rat, int * nb_lettres ){
+	switch( rat->etiquette ){
+		case LETTRE:
+			(*nb_lettres)++;
+			return 1;
+		case STAR:
+			return 1 + compter_noeuds( rat->gauche, nb_lettres );
+		case UNION:
+		case CONCAT:
+			return 1 + compter_noeuds( rat->gauche, nb_lettres )
+				+ compter_noeuds( rat->droit, nb_lettres );
+		default:
+			return 1;
+	}
+}
+
+/*
+ * Calcule le terme et la liste des facteurs de chaque noeud ; renvoie le
+ * numéro du noeud 'rat'.
+ */
+int analyser_termes( Positions_expression * d, const Rationnel * rat ){
+	int k = d->nb_noeuds++, g, dr, a, b;
+	switch( rat->etiquette ){
+		case LETTRE:
+			d->terme[k] = interner_terme(
+				d->termes, TERME_LETTRE, (unsigned char) rat->lettre, 0, 2
+			);
+			break;
+		case STAR:
+			g = analyser_termes( d, rat->gauche );
+			d->terme[k] = interner_terme( d->termes, TERME_ETOILE, d->terme[g], 0, 2 );
+			break;
+		case UNION:
+			g = analyser_termes( d, rat->gauche );
+			dr = analyser_termes( d, rat->droit );
+			a = d->terme[g];
+			b = d->terme[dr];
+			d->terme[k] = interner_terme(
+				d->termes, TERME_UNION, a < b ? a : b, a < b ? b : a, 3
+			);
+			break;
+		case CONCAT:
+			g = analyser_termes( d, rat->gauche );
+			dr = analyser_termes( d, rat->droit );
+			d->liste[k] = concatener_listes( d->termes, d->liste[g], d->liste[dr] );
+			d->taille[k] = d->nb_noeuds - k;
+			// Une liste d'au plus un facteur est ce facteur
+			if( d->liste[k] == LISTE_VIDE ){
+				d->terme[k] = interner_terme( d->termes, TERME_EPSILON, 0, 0, 1 );
+			}else{
+				int taille;
+				const int * t = get_sous_ensemble( d->termes, d->liste[k], &taille );
+				d->terme[k] = t[2] == LISTE_VIDE ? t[1] :
+					interner_terme( d->termes, TERME_CONCAT, d->liste[k], 0, 2 );
+			}
+			return k;
+		default:
+			d->terme[k] = interner_terme( d->termes, TERME_EPSILON, 0, 0, 1 );
+			d->liste[k] = LISTE_VIDE;
+			d->taille[k] = 1;
+			return k;
+	}
+	d->liste[k] = cons_terme( d->termes, d->terme[k], LISTE_VIDE );
+	d->taille[k] = d->nb_noeuds - k;
+	return k;
+}
+
+/*
+ * Numérote les positions du sous-arbre k et calcule leurs suivants et leurs
+ * c-continuations ; 'continuation' est la liste des facteurs qui suivent le
+ * sous-arbre. Écrit dans 'premiers' et 'derniers' (mis à zéro par
+ * l'appelant) les premières et dernières positions du sous-arbre, et
+ * renvoie 1 s'il reconnaît le mot vide.
+ */
+int analyser_positions(
+	Positions_expression * d, const Rationnel * rat, int k, int continuation,
+	uint64_t * premiers, uint64_t * derniers
+){
+	size_t w = d->w;
+	int g = k + 1, dr, vide_g, vide_d, p;
+	uint64_t * premiers_d, * derniers_d;
+	switch( rat->etiquette ){
+		case LETTRE:
+			p = ++d->nb_positions;
+			d->lettre[p] = rat->lettre;
+			d->continuation[p] = continuation;
+			BITSET_AJOUTER( premiers, p );
+			BITSET_AJOUTER( derniers, p );
+			return 0;
+		case STAR:
+			analyser_positions(
+				d, rat->gauche, g,
+				cons_terme( d->termes, d->terme[k], continuation ),
+				premiers, derniers
+			);
+			for(
+				p = bitset_suivant( derniers, w, 0 ); p >= 0;
+				p = bitset_suivant( derniers, w, p + 1 )
+			){
+				bitset_union( d->suivants + p * w, premiers, w );
+			}
+			return 1;
+		case UNION:
+		case CONCAT:
+			dr = g + d->taille[g];
+			premiers_d = xmalloc( 2 * w * sizeof(uint64_t) );
+			derniers_d = premiers_d + w;
+			memset( premiers_d, 0, 2 * w * sizeof(uint64_t) );
+			if( rat->etiquette == UNION ){
+				vide_g = analyser_positions(
+					d, rat->gauche, g, continuation, premiers, derniers
+				);
+				vide_d = analyser_positions(
+					d, rat->droit, dr, continuation, premiers_d, derniers_d
+				);
+				bitset_union( premiers, premiers_d, w );
+				bitset_union( derniers, derniers_d, w );
+				xfree( premiers_d );
+				return vide_g || vide_d;
+			}
+			vide_g = analyser_positions(
+				d, rat->gauche, g,
+				concatener_listes( d->termes, d->liste[dr], continuation ),
+				premiers, derniers
+			);
+			vide_d = analyser_positions(
+				d, rat->droit, dr, continuation, premiers_d, derniers_d
+			);
+			for(
+				p = bitset_suivant( derniers, w, 0 ); p >= 0;
+				p = bitset_suivant( derniers, w, p + 1 )
+			){
+				bitset_union( d->suivants + p * w, premiers_d, w );
+			}
+			if( vide_g ) bitset_union( premiers, premiers_d, w );
+			if( vide_d ){
+				bitset_union( derniers, derniers_d, w );
+			}else{
+				memcpy( derniers, derniers_d, w * sizeof(uint64_t) );
+			}
+			xfree( premiers_d );
+			return vide_g && vide_d;
+		default:
+			return 1;
+	}
+}
+
+Positions_expression * creer_positions_expression( const Rationnel * rat ){
+	Positions_expression * d = xmalloc( sizeof(Positions_expression) );
+	int nb_lettres = 0;
+	int nb_noeuds = compter_noeuds( rat, &nb_lettres );
+	d->termes = creer_table_sous_ensembles();
+	d->nb_noeuds = 0;
+	d->terme = xmalloc( 3 * nb_noeuds * sizeof(int) );
+	d->liste = d->terme + nb_noeuds;
+	d->taille = d->liste + nb_noeuds;
+	analyser_termes( d, rat );
+
+	d->nb_positions = 0;
+	d->lettre = xmalloc( nb_lettres + 1 );
+	d->continuation = xmalloc( ( nb_lettres + 1 ) * sizeof(int) );
+	d->w = BITSET_NB_MOTS( nb_lettres + 1 );
+	size_t taille = ( nb_lettres + 2 ) * d->w * sizeof(uint64_t);
+	d->suivants = xmalloc( taille );
+	memset( d->suivants, 0, taille );
+	// La dernière ligne reçoit les dernières positions
+	d->finaux = d->suivants + ( nb_lettres + 1 ) * d->w;
+	d->continuation[0] = d->liste[0];
+	if( analyser_positions( d, rat, 0, LISTE_VIDE, d->suivants, d->finaux ) ){
+		BITSET_AJOUTER( d->finaux, 0 );
+	}
+	return d;
+}
+
+void liberer_positions_expression( Positions_expression * d ){
+	liberer_table_sous_ensembles( d->termes );
+	xfree( d->terme );
+	xfree( d->lettre );
+	xfree( d->continuation );
+	xfree( d->suivants );
+	xfree( d );
+}
+
+/*
+ * Renvoie, pour chaque position, le numéro de l'état qui la représente
+ * dans le quotient : la plus petite position de même clé. Les clés sont
+ * des entiers de 0 à nb_cles-1.
+ */
+int * representants(
+	const Positions_expression * d, const int * cles, int nb_cles
+){
+	int * representant_cle = xmalloc( ( nb_cles + 1 ) * sizeof(int) );
+	int * representant = xmalloc( ( d->nb_positions + 1 ) * sizeof(int) );
+	int p;
+	for( p = 0; p < nb_cles; p++ ) representant_cle[p] = -1;
+	for( p = 0; p <= d->nb_positions; p++ ){
+		if( representant_cle[ cles[p] ] < 0 ) representant_cle[ cles[p] ] = p;
+		representant[p] = representant_cle[ cles[p] ];
+	}
+	xfree( representant_cle );
+	return representant;
+}
+
+Automate * automate_quotient(
+	const Positions_expression * d, const int * representant
+){
+	Automate * automate = creer_automate();
+	size_t w = d->w;
+	int p, q;
+	ajouter_etat_initial( automate, 0 );
+	for( p = 0; p <= d->nb_positions; p++ ){
+		ajouter_etat( automate, representant[p] );
+		if( BITSET_TEST( d->finaux, p ) ){
+			ajouter_etat_final( automate, representant[p] );
+		}
+		const uint64_t * suivants = d->suivants + p * w;
+		for(
+			q = bitset_suivant( suivants, w, 0 ); q >= 0;
+			q = bitset_suivant( suivants, w, q + 1 )
+		){
+			ajouter_transition(
+				automate, representant[p], d->lettre[q], representant[q]
+			);
+		}
+	}
+	return automate;
+}
+
+Automate * quotient_antimirov( const Positions_expression * d ){
+	// Les clés sont décalées de 1 pour la liste vide
+	int * cles = xmalloc( ( d->nb_positions + 1 ) * sizeof(int) );
+	int p;
+	for( p = 0; p <= d->nb_positions; p++ ) cles[p] = d->continuation[p] + 1;
+	int * representant = representants(
+		d, cles, nombre_de_sous_ensembles( d->termes ) + 1
+	);
+	Automate * automate = automate_quotient( d, representant );
+	xfree( representant );
+	xfree( cles );
+	return automate;
+}
+
+Automate * quotient_suivants( const Positions_expression * d ){
+	Table_sous_ensembles * table = creer_table_sous_ensembles();
+	int * cles = xmalloc( ( d->nb_positions + 1 ) * sizeof(int) );
+	int * elements = xmalloc( ( d->nb_positions + 2 ) * sizeof(int) );
+	size_t w = d->w;
+	int p, q;
+	for( p = 0; p <= d->nb_positions; p++ ){
+		int n = 0;
+		const uint64_t * suivants = d->suivants + p * w;
+		elements[ n++ ] = BITSET_TEST( d->finaux, p ) ? 1 : 0;
+		for(
+			q = bitset_suivant( suivants, w, 0 ); q >= 0;
+			q = bitset_suivant( suivants, w, q + 1 )
+		){
+			elements[ n++ ] = q;
+		}
+		cles[p] = interner_sous_ensemble( table, elements, n, NULL );
+	}
+	int * representant = representants(
+		d, cles, nombre_de_sous_ensembles( table )
+	);
+	Automate * automate = automate_quotient( d, representant );
+	xfree( representant );
+	xfree( elements );
+	xfree( cles );
+	liberer_table_sous_ensembles( table );
+	return automate;
+}
+
+Automate * Antimirov( Rationnel * rat ){
+	Positions_expression * d = creer_positions_expression( rat );
+	Automate * automate = quotient_antimirov( d );
+	liberer_positions_expression( d );
+	return automate;
+}
+
+Automate * automate_des_suivants( Rationnel * rat ){
+	Positions_expression * d = creer_positions_expression( rat );
+	Automate * automate = quotient_suivants( d );
+	liberer_positions_expression( d );
+	return automate;
+}
+
+Automate * plus_petit_automate( Rationnel * rat, Construction * construction ){
+	Positions_expression * d = creer_positions_expression( rat );
+	Automate * antimirov = quotient_antimirov( d );
+	Automate * suivants = quotient_suivants( d );
+	liberer_positions_expression( d );
+
+	int n_a = taille_ensemble( get_etats( antimirov ) );
+	int n_s = taille_ensemble( get_etats( suivants ) );
+	int antimirov_choisi = n_a < n_s || (
+		n_a == n_s
+		&& nombre_de_transitions( antimirov ) <= nombre_de_transitions( suivants )
+	);
+	if( construction ){
+		*construction =
+			antimirov_choisi ? CONSTRUCTION_ANTIMIROV : CONSTRUCTION_SUIVANTS;
+	}
+	if( antimirov_choisi ){
+		liberer_automate( suivants );
+		return antimirov;
+	}
+	liberer_automate( antimirov );
+	return suivants;
+}
@@ -0,0 +1,93 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file automates_expression.h */
+
+#ifndef __AUTOMATES_EXPRESSION_H__
+#define __AUTOMATES_EXPRESSION_H__
+
+#include "automate.h"
+#include "rationnel.h"
+
+/*
+ * Les deux constructions de ce fichier sont des quotients de l'automate
+ * des positions (l'automate de Glushkov, voir Glushkov()) : on y fusionne
+ * des positions dont les langages à droite sont égaux. Elles n'ont donc
+ * jamais plus d'états ni de transitions que l'automate de Glushkov, et
+ * elles reconnaissent le même langage.
+ *
+ * Un état fusionné porte le numéro de la plus petite position de sa
+ * classe ; l'état initial est 0, comme dans Glushkov(). Les positions sont
+ * calculées par ces fonctions : il n'est pas nécessaire d'appeler
+ * numeroter_rationnel() avant.
+ */
+
+/**
+ * @brief Les constructions parmi lesquelles choisit plus_petit_automate().
+ */
+typedef enum Construction {
+	CONSTRUCTION_ANTIMIROV,		//!< voir Antimirov()
+	CONSTRUCTION_SUIVANTS		//!< voir automate_des_suivants()
+} Construction;
+
+/**
+ * @brief Renvoie l'automate des dérivées partielles (automate
+ *        d'Antimirov) d'une expression rationnelle.
+ *
+ * Ses états sont les dérivées partielles de l'expression. On les obtient
+ * sans calculer de dérivées : la dérivée atteinte en lisant la lettre d'une
+ * position p est la c-continuation de p, produit des sous-expressions que
+ * l'on rencontre en remontant de p à la racine (le fils droit de chaque
+ * concaténation dont p est à gauche, et chaque étoile). Deux positions sont
+ * fusionnées si leurs c-continuations sont le même terme. Les termes sont
+ * comparés à l'associativité de la concaténation et à la commutativité de
+ * l'union près.
+ *
+ * @param rat Une expression rationnelle.
+ * @return L'automate d'Antimirov.
+ */
+Automate * Antimirov( Rationnel * rat );
+
+/**
+ * @brief Renvoie l'automate des suivants (« follow automaton ») d'une
+ *        expression rationnelle.
+ *
+ * Deux positions sont fusionnées si elles ont le même ensemble de suivants
+ * (voir suivant()) et si elles sont toutes les deux finales ou toutes les
+ * deux non finales. L'état initial a pour suivants les premières positions
+ * (voir premier()).
+ *
+ * @param rat Une expression rationnelle.
+ * @return L'automate des suivants.
+ */
+Automate * automate_des_suivants( Rationnel * rat );
+
+/**
+ * @brief Renvoie le plus petit des automates d'Antimirov et des suivants
+ *        d'une expression rationnelle.
+ *
+ * On compare les nombres d'états, puis les nombres de transitions. Les
+ * positions de l'expression ne sont calculées qu'une fois.
+ *
+ * @param rat Une expression rationnelle.
+ * @param construction L'adresse où écrire la construction choisie, ou NULL.
+ * @return L'automate choisi.
+ */
+Automate * plus_petit_automate( Rationnel * rat, Construction * construction );
+
+#endif
@@ -0,0 +1,156 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "bitset.h"
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+void bitset_union( uint64_t* dest, const uint64_t* src, size_t nb_mots ){
+	size_t i = 0;
+#if defined(__SSE2__)
+	for( ; i + 2 <= nb_mots; i += 2 ){
+		__m128i a = _mm_loadu_si128( (const __m128i*) ( dest + i ) );
+		__m128i b = _mm_loadu_si128( (const __m128i*) ( src + i ) );
+		_mm_storeu_si128( (__m128i*) ( dest + i ), _mm_or_si128( a, b ) );
+	}
+#endif
+	for( ; i < nb_mots; i++ ){
+		dest[i] |= src[i];
+	}
+}
+
+void bitset_intersection( uint64_t* dest, const uint64_t* src, size_t nb_mots ){
+	size_t i = 0;
+#if defined(__SSE2__)
+	for( ; i + 2 <= nb_mots; i += 2 ){
+		__m128i a = _mm_loadu_si128( (const __m128i*) ( dest + i ) );
+		__m128i b = _mm_loadu_si128( (const __m128i*) ( src + i ) );
+		_mm_storeu_si128( (__m128i*) ( dest + i ), _mm_and_si128( a, b ) );
+	}
+#endif
+	for( ; i < nb_mots; i++ ){
+		dest[i] &= src[i];
+	}
+}
+
+void bitset_difference( uint64_t* dest, const uint64_t* src, size_t nb_mots ){
+	size_t i = 0;
+#if defined(__SSE2__)
+	for( ; i + 2 <= nb_mots; i += 2 ){
+		__m128i a = _mm_loadu_si128( (const __m128i*) ( dest + i ) );
+		__m128i b = _mm_loadu_si128( (const __m128i*) ( src + i ) );
+		_mm_storeu_si128( (__m128i*) ( dest + i ), _mm_andnot_si128( b, a ) );
+	}
+#endif
+	for( ; i < nb_mots; i++ ){
+		dest[i] &= ~src[i];
+	}
+}
+
+size_t bitset_cardinal( const uint64_t* mots, size_t nb_mots ){
+	size_t res = 0;
+	size_t i;
+	for( i = 0; i < nb_mots; i++ ){
+		res += __builtin_popcountll( mots[i] );
+	}
+	return res;
+}
+
+size_t bitset_premier_mot_different(
+	const uint64_t* a, const uint64_t* b, size_t nb_mots
+){
+	size_t i = 0;
+#if defined(__SSE2__)
+	for( ; i + 2 <= nb_mots; i += 2 ){
+		__m128i va = _mm_loadu_si128( (const __m128i*) ( a + i ) );
+		__m128i vb = _mm_loadu_si128( (const __m128i*) ( b + i ) );
+		if( _mm_movemask_epi8( _mm_cmpeq_epi8( va, vb ) ) != 0xffff ) break;
+	}
+#endif
+	for( ; i < nb_mots; i++ ){
+		if( a[i] != b[i] ) return i;
+	}
+	return nb_mots;
+}
+
+int bitset_est_vide( const uint64_t* mots, size_t nb_mots ){
+	size_t i;
+	for( i = 0; i < nb_mots; i++ ){
+		if( mots[i] ) return 0;
+	}
+	return 1;
+}
+
+int bitset_est_inclus( const uint64_t* a, const uint64_t* b, size_t nb_mots ){
+	size_t i;
+	for( i = 0; i < nb_mots; i++ ){
+		if( a[i] & ~b[i] ) return 0;
+	}
+	return 1;
+}
+
+long bitset_suivant( const uint64_t* mots, size_t nb_mots, long debut ){
+	if( debut < 0 ) debut = 0;
+	size_t i = (size_t) debut / BITSET_BITS;
+	if( i >= nb_mots ) return -1;
+	uint64_t mot = mots[i] & ( ~( (uint64_t) 0 ) << ( (size_t) debut % BITSET_BITS ) );
+	while( ! mot ){
+		i++;
+		if( i >= nb_mots ) return -1;
+		mot = mots[i];
+	}
+	return (long) ( i * BITSET_BITS + __builtin_ctzll( mot ) );
+}
+
+long bitset_precedent( const uint64_t* mots, size_t nb_mots, long fin ){
+	if( fin < 0 || nb_mots == 0 ) return -1;
+	size_t i = (size_t) fin / BITSET_BITS;
+	uint64_t mot;
+	if( i >= nb_mots ){
+		i = nb_mots - 1;
+		mot = mots[i];
+	}else{
+		size_t decalage = BITSET_BITS - 1 - (size_t) fin % BITSET_BITS;
+		mot = mots[i] & ( ~( (uint64_t) 0 ) >> decalage );
+	}
+	while( ! mot ){
+		if( i == 0 ) return -1;
+		i--;
+		mot = mots[i];
+	}
+	return (long) ( i * BITSET_BITS + BITSET_BITS - 1 - __builtin_clzll( mot ) );
+}
+
+uint64_t bitset_hacher_mot( uint64_t hache, size_t indice, uint64_t mot ){
+	uint64_t h = mot ^ ( (uint64_t) indice * 0x9e3779b97f4a7c15ULL );
+	h ^= h >> 33;
+	h *= 0xff51afd7ed558ccdULL;
+	h ^= h >> 33;
+	return ( hache ^ h ) * 0x100000001b3ULL;
+}
+
+uint64_t bitset_hacher( const uint64_t* mots, size_t nb_mots ){
+	uint64_t hache = BITSET_HACHE_INITIAL;
+	size_t i;
+	for( i = 0; i < nb_mots; i++ ){
+		if( mots[i] ) hache = bitset_hacher_mot( hache, i, mots[i] );
+	}
+	return hache;
+}
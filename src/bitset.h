@@ -0,0 +1,127 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __BITSET_H__
+#define __BITSET_H__
+
+#include <stdint.h>
+#include <stddef.h>
+
+/*
+ * Opérations sur des tableaux de mots de 64 bits, utilisés pour coder des
+ * ensembles d'entiers positifs : l'entier i appartient à l'ensemble si le
+ * bit (i % 64) du mot (i / 64) vaut 1.
+ *
+ * L'union, l'intersection, la différence et la comparaison utilisent des
+ * instructions SSE2 lorsque le compilateur les active (c'est le cas par
+ * défaut sur x86-64) et une version portable sinon.
+ */
+
+#define BITSET_BITS 64
+
+/*
+ * Renvoie le nombre de mots nécessaires pour coder les entiers de 0 à
+ * taille-1.
+ */
+#define BITSET_NB_MOTS(taille) ( ( (size_t) (taille) + BITSET_BITS - 1 ) / BITSET_BITS )
+
+/*
+ * Renvoie 1 si le bit i est à 1 et 0 sinon.
+ */
+#define BITSET_TEST(mots, i) \
+	( ( (mots)[ (size_t) (i) / BITSET_BITS ] >> ( (size_t) (i) % BITSET_BITS ) ) & 1 )
+
+/*
+ * Met le bit i à 1.
+ */
+#define BITSET_AJOUTER(mots, i) \
+	( (mots)[ (size_t) (i) / BITSET_BITS ] |= ( (uint64_t) 1 ) << ( (size_t) (i) % BITSET_BITS ) )
+
+/*
+ * Met le bit i à 0.
+ */
+#define BITSET_RETIRER(mots, i) \
+	( (mots)[ (size_t) (i) / BITSET_BITS ] &= ~( ( (uint64_t) 1 ) << ( (size_t) (i) % BITSET_BITS ) ) )
+
+/*
+ * dest = dest | src, sur nb_mots mots.
+ */
+void bitset_union( uint64_t* dest, const uint64_t* src, size_t nb_mots );
+
+/*
+ * dest = dest & src, sur nb_mots mots.
+ */
+void bitset_intersection( uint64_t* dest, const uint64_t* src, size_t nb_mots );
+
+/*
+ * dest = dest & ~src, sur nb_mots mots.
+ */
+void bitset_difference( uint64_t* dest, const uint64_t* src, size_t nb_mots );
+
+/*
+ * Renvoie le nombre de bits à 1.
+ */
+size_t bitset_cardinal( const uint64_t* mots, size_t nb_mots );
+
+/*
+ * Renvoie l'indice du premier mot différent entre a et b, ou nb_mots si
+ * les deux tableaux sont égaux.
+ */
+size_t bitset_premier_mot_different(
+	const uint64_t* a, const uint64_t* b, size_t nb_mots
+);
+
+/*
+ * Renvoie 1 si tous les mots sont nuls, 0 sinon.
+ */
+int bitset_est_vide( const uint64_t* mots, size_t nb_mots );
+
+/*
+ * Renvoie 1 si a est inclus dans b (a & ~b est nul), 0 sinon.
+ */
+int bitset_est_inclus( const uint64_t* a, const uint64_t* b, size_t nb_mots );
+
+/*
+ * Renvoie l'indice du premier bit à 1 supérieur ou égal à 'debut', ou -1
+ * s'il n'y en a pas.
+ */
+long bitset_suivant( const uint64_t* mots, size_t nb_mots, long debut );
+
+/*
+ * Renvoie l'indice du dernier bit à 1 inférieur ou égal à 'fin', ou -1
+ * s'il n'y en a pas.
+ */
+long bitset_precedent( const uint64_t* mots, size_t nb_mots, long fin );
+
+/*
+ * Fonctions de hachage.
+ *
+ * Le hachage d'un ensemble ne dépend que des mots non nuls et de leurs
+ * indices : deux tableaux de tailles différentes codant le même ensemble ont
+ * donc le même haché.
+ * bitset_hacher_mot() permet de calculer ce même haché mot par mot, en
+ * partant de BITSET_HACHE_INITIAL et en appelant la fonction pour chaque mot
+ * non nul, dans l'ordre croissant des indices.
+ */
+#define BITSET_HACHE_INITIAL ( (uint64_t) 0xcbf29ce484222325ULL )
+
+uint64_t bitset_hacher_mot( uint64_t hache, size_t indice, uint64_t mot );
+
+uint64_t bitset_hacher( const uint64_t* mots, size_t nb_mots );
+
+#endif
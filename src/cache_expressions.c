@@ -0,0 +1,336 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define _GNU_SOURCE
+
+#include "cache_expressions.h"
+#include "bitset.h"
+#include "outils.h"
+
+#include <pthread.h>
+#include <string.h>
+
+/*
+ * États d'une entrée. Une entrée en compilation est dans la table mais n'a
+ * pas encore d'Afd ; une expression mal formée est retirée de la table dès
+ * que la compilation a échoué.
+ */
+#define EN_COMPILATION 0
+#define COMPILEE 1
+#define MAL_FORMEE 2
+
+#define NB_ALVEOLES_INITIAL 64
+
+struct Cache_expressions {
+	pthread_rwlock_t verrou;			// protège la table et 'memoire'
+	pthread_mutex_t verrou_compilation;
+	pthread_cond_t compilation_finie;
+	Expression_compilee ** alveoles;
+	size_t nb_alveoles;
+	size_t nb_entrees;
+	size_t memoire;
+	size_t memoire_max;
+	atomic_uint_fast64_t horloge;
+	atomic_uint_fast64_t nb_succes;
+	atomic_uint_fast64_t nb_echecs;
+	atomic_uint_fast64_t nb_evictions;
+};
+
+/*
+ * Retire les blancs, que l'analyseur ignore (voir scan.l).
+ */
+char * normaliser_expression( const char * expression ){
+	char * cle = xmalloc( strlen( expression ) + 1 );
+	size_t k = 0;
+	const char * c;
+	for( c = expression; *c; c++ ){
+		if( *c != ' ' && *c != '\t' ) cle[ k++ ] = *c;
+	}
+	cle[k] = '\0';
+	return cle;
+}
+
+/* FNV-1a */
+uint64_t hacher_cle( const char * cle ){
+	uint64_t h = 0xcbf29ce484222325ULL;
+	const unsigned char * c;
+	for( c = (const unsigned char *) cle; *c; c++ ){
+		h ^= *c;
+		h *= 0x100000001b3ULL;
+	}
+	return h;
+}
+
+/*
+ * Mémoire occupée par une entrée compilée et son Afd.
+ */
+size_t taille_expression( const Expression_compilee * e ){
+	const Afd * afd = e->afd;
+	return sizeof(Expression_compilee) + strlen( e->cle ) + 1
+		+ sizeof(Afd)
+		+ (size_t) afd->nb_etats * afd->nb_classes * sizeof(int32_t)
+		+ BITSET_NB_MOTS( afd->nb_etats ) * sizeof(uint64_t)
+		+ (size_t) ( afd->nb_etats - 1 ) * sizeof(int);
+}
+
+/*
+ * Les fonctions suivantes, jusqu'à evincer_entrees(), supposent que le
+ * verrou de la table est tenu : en lecture pour chercher_entree() et
+ * prendre_entree(), en écriture pour les autres.
+ */
+Expression_compilee * chercher_entree(
+	const Cache_expressions * cache, const char * cle, uint64_t hache
+){
+	Expression_compilee * e;
+	for(
+		e = cache->alveoles[ hache & ( cache->nb_alveoles - 1 ) ];
+		e; e = e->suivante
+	){
+		if( e->hache == hache && strcmp( e->cle, cle ) == 0 ) return e;
+	}
+	return NULL;
+}
+
+void prendre_entree( Cache_expressions * cache, Expression_compilee * e ){
+	atomic_fetch_add( &e->nb_references, 1 );
+	atomic_store_explicit(
+		&e->dernier_acces, atomic_fetch_add( &cache->horloge, 1 ) + 1,
+		memory_order_relaxed
+	);
+}
+
+void inserer_entree( Cache_expressions * cache, Expression_compilee * e ){
+	if( cache->nb_entrees >= cache->nb_alveoles ){
+		size_t nb = 2 * cache->nb_alveoles, i;
+		Expression_compilee ** alveoles =
+			xmalloc( nb * sizeof(Expression_compilee *) );
+		for( i = 0; i < nb; i++ ) alveoles[i] = NULL;
+		for( i = 0; i < cache->nb_alveoles; i++ ){
+			Expression_compilee * f = cache->alveoles[i], * suivante;
+			for( ; f; f = suivante ){
+				suivante = f->suivante;
+				f->suivante = alveoles[ f->hache & ( nb - 1 ) ];
+				alveoles[ f->hache & ( nb - 1 ) ] = f;
+			}
+		}
+		xfree( cache->alveoles );
+		cache->alveoles = alveoles;
+		cache->nb_alveoles = nb;
+	}
+	Expression_compilee ** alveole =
+		cache->alveoles + ( e->hache & ( cache->nb_alveoles - 1 ) );
+	e->suivante = *alveole;
+	*alveole = e;
+	cache->nb_entrees++;
+}
+
+void retirer_entree( Cache_expressions * cache, Expression_compilee * e ){
+	Expression_compilee ** p =
+		cache->alveoles + ( e->hache & ( cache->nb_alveoles - 1 ) );
+	while( *p != e ) p = &(*p)->suivante;
+	*p = e->suivante;
+	cache->nb_entrees--;
+}
+
+/*
+ * Évince les entrées compilées utilisées le moins récemment, jusqu'à
+ * respecter le budget. Les entrées en compilation et 'epargnee' ne sont pas
+ * évincées.
+ */
+void evincer_entrees(
+	Cache_expressions * cache, const Expression_compilee * epargnee
+){
+	while( cache->memoire > cache->memoire_max ){
+		Expression_compilee * victime = NULL;
+		uint64_t plus_ancien = UINT64_MAX;
+		size_t i;
+		for( i = 0; i < cache->nb_alveoles; i++ ){
+			Expression_compilee * e;
+			for( e = cache->alveoles[i]; e; e = e->suivante ){
+				uint64_t acces = atomic_load_explicit(
+					&e->dernier_acces, memory_order_relaxed
+				);
+				if(
+					e != epargnee && atomic_load( &e->etat ) == COMPILEE
+					&& acces < plus_ancien
+				){
+					plus_ancien = acces;
+					victime = e;
+				}
+			}
+		}
+		if( ! victime ) return;
+		retirer_entree( cache, victime );
+		cache->memoire -= victime->taille;
+		atomic_fetch_add( &cache->nb_evictions, 1 );
+		rendre_expression( victime );
+	}
+}
+
+Cache_expressions * creer_cache_expressions( size_t memoire_max ){
+	Cache_expressions * cache = xmalloc( sizeof(Cache_expressions) );
+	pthread_rwlock_init( &cache->verrou, NULL );
+	pthread_mutex_init( &cache->verrou_compilation, NULL );
+	pthread_cond_init( &cache->compilation_finie, NULL );
+	cache->nb_alveoles = NB_ALVEOLES_INITIAL;
+	cache->alveoles =
+		xmalloc( cache->nb_alveoles * sizeof(Expression_compilee *) );
+	size_t i;
+	for( i = 0; i < cache->nb_alveoles; i++ ) cache->alveoles[i] = NULL;
+	cache->nb_entrees = 0;
+	cache->memoire = 0;
+	cache->memoire_max = memoire_max;
+	atomic_init( &cache->horloge, 0 );
+	atomic_init( &cache->nb_succes, 0 );
+	atomic_init( &cache->nb_echecs, 0 );
+	atomic_init( &cache->nb_evictions, 0 );
+	return cache;
+}
+
+void liberer_cache_expressions( Cache_expressions * cache ){
+	size_t i;
+	for( i = 0; i < cache->nb_alveoles; i++ ){
+		Expression_compilee * e = cache->alveoles[i], * suivante;
+		for( ; e; e = suivante ){
+			suivante = e->suivante;
+			rendre_expression( e );
+		}
+	}
+	xfree( cache->alveoles );
+	pthread_cond_destroy( &cache->compilation_finie );
+	pthread_mutex_destroy( &cache->verrou_compilation );
+	pthread_rwlock_destroy( &cache->verrou );
+	xfree( cache );
+}
+
+static pthread_once_t cache_global_cree = PTHREAD_ONCE_INIT;
+static Cache_expressions * cache_global = NULL;
+
+void creer_cache_global( void ){
+	cache_global = creer_cache_expressions( MEMOIRE_CACHE_GLOBAL );
+}
+
+Cache_expressions * cache_expressions_global( void ){
+	pthread_once( &cache_global_cree, creer_cache_global );
+	return cache_global;
+}
+
+/*
+ * Compile l'expression d'une entrée que l'on vient d'insérer, puis réveille
+ * les fils qui l'attendent.
+ */
+void compiler_entree( Cache_expressions * cache, Expression_compilee * e ){
+	Afd * afd = creer_afd_expression( e->cle );
+
+	pthread_rwlock_wrlock( &cache->verrou );
+	if( afd ){
+		e->afd = afd;
+		e->taille = taille_expression( e );
+		cache->memoire += e->taille;
+		atomic_store( &e->etat, COMPILEE );
+		evincer_entrees( cache, e );
+	}else{
+		retirer_entree( cache, e );
+		atomic_store( &e->etat, MAL_FORMEE );
+		rendre_expression( e );
+	}
+	pthread_rwlock_unlock( &cache->verrou );
+
+	// Un fil qui attend a lu l'état sous ce verrou avant de s'endormir
+	pthread_mutex_lock( &cache->verrou_compilation );
+	pthread_cond_broadcast( &cache->compilation_finie );
+	pthread_mutex_unlock( &cache->verrou_compilation );
+}
+
+Expression_compilee * obtenir_expression(
+	Cache_expressions * cache, const char * expression
+){
+	char * cle = normaliser_expression( expression );
+	uint64_t hache = hacher_cle( cle );
+
+	pthread_rwlock_rdlock( &cache->verrou );
+	Expression_compilee * e = chercher_entree( cache, cle, hache );
+	if( e ) prendre_entree( cache, e );
+	pthread_rwlock_unlock( &cache->verrou );
+
+	if( ! e ){
+		// Un autre fil a pu insérer l'entrée entre les deux verrous
+		pthread_rwlock_wrlock( &cache->verrou );
+		e = chercher_entree( cache, cle, hache );
+		if( e ){
+			prendre_entree( cache, e );
+		}else{
+			e = xmalloc( sizeof(Expression_compilee) );
+			e->cle = cle;
+			e->afd = NULL;
+			e->taille = 0;
+			e->hache = hache;
+			atomic_init( &e->etat, EN_COMPILATION );
+			// Une référence pour le cache, une pour l'appelant
+			atomic_init( &e->nb_references, 2 );
+			atomic_init(
+				&e->dernier_acces, atomic_fetch_add( &cache->horloge, 1 ) + 1
+			);
+			inserer_entree( cache, e );
+			cle = NULL;
+		}
+		pthread_rwlock_unlock( &cache->verrou );
+		if( ! cle ){
+			atomic_fetch_add( &cache->nb_echecs, 1 );
+			compiler_entree( cache, e );
+		}
+	}
+	if( cle ){
+		atomic_fetch_add( &cache->nb_succes, 1 );
+		xfree( cle );
+	}
+
+	if( atomic_load( &e->etat ) == EN_COMPILATION ){
+		pthread_mutex_lock( &cache->verrou_compilation );
+		while( atomic_load( &e->etat ) == EN_COMPILATION ){
+			pthread_cond_wait(
+				&cache->compilation_finie, &cache->verrou_compilation
+			);
+		}
+		pthread_mutex_unlock( &cache->verrou_compilation );
+	}
+	if( atomic_load( &e->etat ) == MAL_FORMEE ){
+		rendre_expression( e );
+		return NULL;
+	}
+	return e;
+}
+
+void rendre_expression( Expression_compilee * e ){
+	if( atomic_fetch_sub( &e->nb_references, 1 ) != 1 ) return;
+	if( e->afd ) liberer_afd( (Afd *) e->afd );
+	xfree( e->cle );
+	xfree( e );
+}
+
+void statistiques_cache_expressions(
+	Cache_expressions * cache, Statistiques_cache * statistiques
+){
+	statistiques->nb_succes = atomic_load( &cache->nb_succes );
+	statistiques->nb_echecs = atomic_load( &cache->nb_echecs );
+	statistiques->nb_evictions = atomic_load( &cache->nb_evictions );
+	pthread_rwlock_rdlock( &cache->verrou );
+	statistiques->nb_entrees = cache->nb_entrees;
+	statistiques->memoire = cache->memoire;
+	pthread_rwlock_unlock( &cache->verrou );
+}
@@ -0,0 +1,144 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file cache_expressions.h */
+
+#ifndef __CACHE_EXPRESSIONS_H__
+#define __CACHE_EXPRESSIONS_H__
+
+#include "afd.h"
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief Une expression compilée, rangée dans un cache.
+ *
+ * L'Afd n'est jamais modifié une fois publié : plusieurs fils d'exécution
+ * peuvent le lire en même temps. L'entrée est libérée lorsque le cache l'a
+ * évincée et que toutes les poignées rendues par obtenir_expression() ont
+ * été rendues avec rendre_expression().
+ */
+typedef struct Expression_compilee {
+	char * cle;						//!< l'expression normalisée
+	const Afd * afd;				//!< NULL tant que la compilation n'est pas finie
+	size_t taille;					//!< octets comptés dans le budget du cache
+	uint64_t hache;
+	atomic_int etat;
+	atomic_int nb_references;		//!< poignées, plus une si l'entrée est dans le cache
+	atomic_uint_fast64_t dernier_acces;
+	struct Expression_compilee * suivante;
+} Expression_compilee;
+
+/**
+ * @brief Les compteurs d'un cache d'expressions.
+ */
+typedef struct Statistiques_cache {
+	uint64_t nb_succes;			//!< expressions trouvées dans le cache
+	uint64_t nb_echecs;			//!< expressions compilées
+	uint64_t nb_evictions;		//!< entrées évincées pour respecter le budget
+	size_t nb_entrees;
+	size_t memoire;				//!< octets des entrées présentes
+} Statistiques_cache;
+
+/**
+ * @brief Un cache qui associe à chaque expression rationnelle son Afd
+ *        minimal (voir creer_afd_expression()).
+ *
+ * Les expressions sont normalisées en retirant les blancs, qui sont ignorés
+ * par l'analyseur : "a . b" et "a.b" partagent la même entrée.
+ *
+ * Les recherches qui trouvent l'expression ne prennent le verrou de la table
+ * qu'en lecture : elles ne se bloquent pas entre elles. Une expression
+ * absente est compilée hors de tout verrou, une seule fois : les fils qui la
+ * demandent pendant sa compilation attendent le résultat au lieu de la
+ * compiler à leur tour.
+ *
+ * Lorsque la mémoire des entrées dépasse 'memoire_max', les entrées
+ * utilisées le moins récemment sont évincées. Une entrée évincée reste
+ * valide pour les poignées qui la tiennent encore.
+ */
+typedef struct Cache_expressions Cache_expressions;
+
+/**
+ * @brief Le budget, en octets, du cache renvoyé par
+ *        cache_expressions_global().
+ */
+#define MEMOIRE_CACHE_GLOBAL ( (size_t) 64 << 20 )
+
+/**
+ * @brief Crée un cache d'expressions vide.
+ *
+ * @param memoire_max Le budget du cache, en octets.
+ * @return Le cache.
+ */
+Cache_expressions * creer_cache_expressions( size_t memoire_max );
+
+/**
+ * @brief Libère un cache d'expressions.
+ *
+ * Aucun fil ne doit utiliser le cache pendant l'appel. Les poignées encore
+ * tenues restent valides jusqu'à ce qu'elles soient rendues.
+ *
+ * @param cache Un cache d'expressions.
+ */
+void liberer_cache_expressions( Cache_expressions * cache );
+
+/**
+ * @brief Renvoie le cache partagé par tout le processus.
+ *
+ * Il est créé au premier appel, avec le budget MEMOIRE_CACHE_GLOBAL, et
+ * n'est jamais libéré.
+ */
+Cache_expressions * cache_expressions_global( void );
+
+/**
+ * @brief Renvoie une poignée sur l'expression compilée, en la compilant si
+ *        elle n'est pas dans le cache.
+ *
+ * La poignée doit être rendue avec rendre_expression(). Renvoie NULL si
+ * l'expression est mal formée ; les expressions mal formées ne sont pas
+ * gardées dans le cache.
+ *
+ * @param cache Un cache d'expressions.
+ * @param expression Une expression rationnelle.
+ * @return La poignée, ou NULL.
+ */
+Expression_compilee * obtenir_expression(
+	Cache_expressions * cache, const char * expression
+);
+
+/**
+ * @brief Rend une poignée obtenue avec obtenir_expression().
+ *
+ * @param expression Une poignée.
+ */
+void rendre_expression( Expression_compilee * expression );
+
+/**
+ * @brief Lit les compteurs d'un cache d'expressions.
+ *
+ * @param cache Un cache d'expressions.
+ * @param statistiques L'adresse où écrire les compteurs.
+ */
+void statistiques_cache_expressions(
+	Cache_expressions * cache, Statistiques_cache * statistiques
+);
+
+#endif
@@ -0,0 +1,276 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "derivees.h"
+#include "outils.h"
+
+#include <string.h>
+
+/*
+ * Les termes sont des rationnels internés dans afd->table, ∅ étant NULL.
+ * La concaténation est en plus associée à droite.
+ */
+Rationnel * terme_concat( Afd_derivees * afd, Rationnel * r, Rationnel * s ){
+	if( r && r->etiquette == CONCAT ){
+		return concat_interne(
+			afd->table, r->gauche, terme_concat( afd, r->droit, s )
+		);
+	}
+	return concat_interne( afd->table, r, s );
+}
+
+Rationnel * terme_du_rationnel( Afd_derivees * afd, const Rationnel * rat ){
+	if( ! rat ) return NULL;
+	switch( rat->etiquette ){
+		case LETTRE:
+			return lettre_interne( afd->table, rat->lettre );
+		case STAR:
+			return etoile_interne(
+				afd->table, terme_du_rationnel( afd, rat->gauche )
+			);
+		case UNION:
+			return union_interne(
+				afd->table, terme_du_rationnel( afd, rat->gauche ),
+				terme_du_rationnel( afd, rat->droit )
+			);
+		case CONCAT:
+			return terme_concat(
+				afd, terme_du_rationnel( afd, rat->gauche ),
+				terme_du_rationnel( afd, rat->droit )
+			);
+		default:
+			return epsilon_interne( afd->table );
+	}
+}
+
+/*
+ * Dérivée du terme par la lettre. Les dérivées déjà calculées, y compris
+ * celles des sous-termes, sont retrouvées dans la table des couples.
+ */
+Rationnel * deriver_terme( Afd_derivees * afd, Rationnel * terme, char lettre ){
+	if( ! terme ) return NULL;
+	int couple[2] = { numero_interne( terme ), (unsigned char) lettre }, nouveau;
+	int k = interner_sous_ensemble( afd->couples, couple, 2, &nouveau );
+	if( ! nouveau ) return afd->derivee[k];
+
+	Rationnel * res;
+	switch( terme->etiquette ){
+		case LETTRE:
+			res = terme->lettre == lettre ? epsilon_interne( afd->table ) : NULL;
+			break;
+		case STAR:
+			res = terme_concat(
+				afd, deriver_terme( afd, terme->gauche, lettre ), terme
+			);
+			break;
+		case CONCAT:
+			res = terme_concat(
+				afd, deriver_terme( afd, terme->gauche, lettre ), terme->droit
+			);
+			if( contient_mot_vide_interne( afd->table, terme->gauche ) ){
+				res = union_interne(
+					afd->table, res, deriver_terme( afd, terme->droit, lettre )
+				);
+			}
+			break;
+		case UNION:
+			// Le membre droit d'une union internée est le reste du peigne
+			res = union_interne(
+				afd->table, deriver_terme( afd, terme->gauche, lettre ),
+				deriver_terme( afd, terme->droit, lettre )
+			);
+			break;
+		default:
+			res = NULL;
+	}
+
+	if( k >= afd->capacite_couples ){
+		while( k >= afd->capacite_couples ) afd->capacite_couples *= 2;
+		afd->derivee = xrealloc(
+			afd->derivee, afd->capacite_couples * sizeof(Rationnel *)
+		);
+	}
+	afd->derivee[k] = res;
+	return res;
+}
+
+/*
+ * Renvoie l'état du terme, en le créant s'il n'existait pas. L'état du
+ * terme de numéro i est rangé en etat_du_terme[i + 1], celui de ∅ en
+ * etat_du_terme[0].
+ */
+int32_t etat_derivee( Afd_derivees * afd, Rationnel * terme ){
+	int indice = numero_interne( terme ) + 1;
+	if( indice >= afd->capacite_termes ){
+		int i = afd->capacite_termes;
+		while( indice >= afd->capacite_termes ) afd->capacite_termes *= 2;
+		afd->etat_du_terme = xrealloc(
+			afd->etat_du_terme, afd->capacite_termes * sizeof(int32_t)
+		);
+		for( ; i < afd->capacite_termes; i++ ) afd->etat_du_terme[i] = -1;
+	}
+	if( afd->etat_du_terme[ indice ] >= 0 ) return afd->etat_du_terme[ indice ];
+	if( afd->nb_etats == afd->capacite ){
+		afd->capacite *= 2;
+		afd->suivant = xrealloc(
+			afd->suivant,
+			(size_t) afd->capacite * afd->nb_classes * sizeof(int32_t)
+		);
+		afd->terme = xrealloc( afd->terme, afd->capacite * sizeof(Rationnel *) );
+	}
+	int32_t id = afd->nb_etats++;
+	memset(
+		afd->suivant + (size_t) id * afd->nb_classes, 0xff,
+		afd->nb_classes * sizeof(int32_t)
+	);
+	afd->terme[id] = terme;
+	afd->etat_du_terme[ indice ] = id;
+	return id;
+}
+
+void marquer_lettres( const Rationnel * rat, char * presente ){
+	if( ! rat ) return;
+	switch( rat->etiquette ){
+		case LETTRE:
+			presente[ (unsigned char) rat->lettre ] = 1;
+			break;
+		case UNION:
+		case CONCAT:
+			marquer_lettres( rat->droit, presente );
+			// pas de break
+		case STAR:
+			marquer_lettres( rat->gauche, presente );
+			break;
+		default:
+			break;
+	}
+}
+
+Afd_derivees * creer_afd_derivees( const Rationnel * rat ){
+	Afd_derivees * afd = xmalloc( sizeof(Afd_derivees) );
+
+	char presente[256];
+	memset( presente, 0, 256 );
+	marquer_lettres( rat, presente );
+	int i;
+	afd->nb_classes = 1;
+	for( i = 0; i < 256; i++ ){
+		afd->classe[i] = presente[i] ? afd->nb_classes++ : 0;
+	}
+	afd->representant = xmalloc( afd->nb_classes );
+	afd->representant[0] = 0;
+	for( i = 0; i < 256; i++ ){
+		if( presente[i] ) afd->representant[ afd->classe[i] ] = (char) i;
+	}
+
+	afd->table = creer_table_rationnels();
+	afd->capacite_termes = 64;
+	afd->etat_du_terme = xmalloc( afd->capacite_termes * sizeof(int32_t) );
+	for( i = 0; i < afd->capacite_termes; i++ ) afd->etat_du_terme[i] = -1;
+	afd->couples = creer_table_sous_ensembles();
+	afd->capacite_couples = 64;
+	afd->derivee = xmalloc( afd->capacite_couples * sizeof(Rationnel *) );
+
+	afd->capacite = 16;
+	afd->nb_etats = 0;
+	afd->suivant = xmalloc(
+		(size_t) afd->capacite * afd->nb_classes * sizeof(int32_t)
+	);
+	afd->terme = xmalloc( afd->capacite * sizeof(Rationnel *) );
+	afd->initial = etat_derivee( afd, terme_du_rationnel( afd, rat ) );
+	afd->nb_succes = 0;
+	afd->nb_echecs = 0;
+	return afd;
+}
+
+void liberer_afd_derivees( Afd_derivees * afd ){
+	liberer_table_rationnels( afd->table, 1 );
+	liberer_table_sous_ensembles( afd->couples );
+	xfree( afd->etat_du_terme );
+	xfree( afd->derivee );
+	xfree( afd->representant );
+	xfree( afd->suivant );
+	xfree( afd->terme );
+	xfree( afd );
+}
+
+int32_t afd_derivees_suivant( Afd_derivees * afd, int32_t etat, char lettre ){
+	int c = afd->classe[ (unsigned char) lettre ];
+	size_t i = (size_t) etat * afd->nb_classes + c;
+	if( afd->suivant[i] != AFD_DERIVEES_INCONNU ){
+		afd->nb_succes++;
+		return afd->suivant[i];
+	}
+	afd->nb_echecs++;
+	Rationnel * terme = c == 0 ? NULL :
+		deriver_terme( afd, afd->terme[ etat ], lettre );
+	int32_t r = etat_derivee( afd, terme );
+	afd->suivant[i] = r;
+	return r;
+}
+
+int afd_derivees_est_final( const Afd_derivees * afd, int32_t etat ){
+	return contient_mot_vide_interne( afd->table, afd->terme[ etat ] );
+}
+
+int afd_derivees_reconnait_tampon(
+	Afd_derivees * afd, const char * mot, size_t longueur
+){
+	int32_t etat = afd->initial;
+	size_t i;
+	for( i = 0; i < longueur; i++ ){
+		etat = afd_derivees_suivant( afd, etat, mot[i] );
+		if( ! afd->terme[ etat ] ) return 0;
+	}
+	return afd_derivees_est_final( afd, etat );
+}
+
+int afd_derivees_reconnait( Afd_derivees * afd, const char * mot ){
+	return afd_derivees_reconnait_tampon( afd, mot, strlen( mot ) );
+}
+
+Automate * automate_des_derivees( Afd_derivees * afd ){
+	int32_t i;
+	int c;
+	// Les états créés pendant le parcours sont parcourus à leur tour
+	for( i = 0; i < afd->nb_etats; i++ ){
+		for( c = 1; c < afd->nb_classes; c++ ){
+			afd_derivees_suivant( afd, i, afd->representant[c] );
+		}
+	}
+	Automate * automate = creer_automate();
+	ajouter_etat_initial( automate, afd->initial );
+	for( i = 0; i < afd->nb_etats; i++ ){
+		ajouter_etat( automate, i );
+		if( afd_derivees_est_final( afd, i ) ) ajouter_etat_final( automate, i );
+		for( c = 1; c < afd->nb_classes; c++ ){
+			ajouter_transition(
+				automate, i, afd->representant[c],
+				afd->suivant[ (size_t) i * afd->nb_classes + c ]
+			);
+		}
+	}
+	return automate;
+}
+
+Automate * Brzozowski( Rationnel * rat ){
+	Afd_derivees * afd = creer_afd_derivees( rat );
+	Automate * automate = automate_des_derivees( afd );
+	liberer_afd_derivees( afd );
+	return automate;
+}
@@ -0,0 +1,166 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file derivees.h */
+
+#ifndef __DERIVEES_H__
+#define __DERIVEES_H__
+
+#include "automate.h"
+#include "rationnel.h"
+#include "rationnel_interne.h"
+#include "sous_ensembles.h"
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief Valeur d'une transition de l'Afd des dérivées qui n'a pas encore
+ *        été calculée.
+ */
+#define AFD_DERIVEES_INCONNU -1
+
+/**
+ * @brief Le type d'un automate déterministe dont les états sont les
+ *        dérivées (de Brzozowski) d'une expression rationnelle, construit à
+ *        la demande.
+ *
+ * Les dérivées sont des rationnels internés dans une Table_rationnels
+ * (voir rationnel_interne.h), NULL représentant ∅ : deux termes égaux sont
+ * le même noeud. Les constructeurs de la table normalisent les termes ;
+ * en particulier l'union est comparée à l'associativité, la commutativité
+ * et l'idempotence près, si bien qu'une expression n'a qu'un nombre fini
+ * de dérivées. La concaténation est en plus associée à droite.
+ *
+ * L'état i est le i-ème terme atteint. Un état n'est créé que lorsqu'un mot
+ * l'atteint pour la première fois, et chaque transition calculée est gardée
+ * dans la table 'suivant' :
+ *     suivant[ i * nb_classes + c ]
+ * est l'état atteint depuis i par une lettre de classe c, ou
+ * AFD_DERIVEES_INCONNU. Chaque lettre de l'expression a sa classe ; la
+ * classe 0 regroupe les octets qui n'apparaissent pas dans l'expression et
+ * mène à l'état ∅. Les dérivées des sous-termes sont aussi gardées, pour
+ * n'être calculées qu'une fois.
+ *
+ * Les compteurs nb_succes et nb_echecs comptent respectivement les
+ * transitions trouvées dans la table et les transitions calculées.
+ *
+ * Un Afd des dérivées est modifié par chaque lecture : il ne doit pas être
+ * lu par plusieurs fils d'exécution à la fois.
+ */
+typedef struct Afd_derivees {
+	Table_rationnels * table;		//!< les termes
+	int32_t * etat_du_terme;		//!< l'état du terme de numéro i en i+1, de ∅ en 0, ou -1
+	int capacite_termes;
+	Table_sous_ensembles * couples;	//!< couples (terme, lettre) déjà dérivés
+	Rationnel ** derivee;			//!< derivee[k] : dérivée du couple k
+	int capacite_couples;
+
+	int nb_classes;
+	uint16_t classe[256];
+	char * representant;			//!< la lettre de chaque classe
+	int nb_etats;
+	int capacite;
+	Rationnel ** terme;				//!< terme[i] : terme de l'état i
+	int32_t * suivant;
+	int32_t initial;
+	uint64_t nb_succes;
+	uint64_t nb_echecs;
+} Afd_derivees;
+
+/**
+ * @brief Crée l'Afd des dérivées d'une expression rationnelle.
+ *
+ * Seul l'état initial, l'expression elle-même, est construit. L'Afd ne
+ * dépend pas de l'expression, qui peut ensuite être modifiée ou libérée.
+ *
+ * @param rat Une expression rationnelle, ou NULL pour ∅.
+ * @return L'Afd des dérivées.
+ */
+Afd_derivees * creer_afd_derivees( const Rationnel * rat );
+
+/**
+ * @brief Libère la mémoire d'un Afd des dérivées.
+ *
+ * @param afd Un Afd des dérivées.
+ */
+void liberer_afd_derivees( Afd_derivees * afd );
+
+/**
+ * @brief Renvoie l'état atteint depuis 'etat' en lisant 'lettre', en
+ *        calculant la dérivée si la transition n'est pas encore connue.
+ *
+ * @param afd Un Afd des dérivées.
+ * @param etat Un état de l'Afd des dérivées.
+ * @param lettre Une lettre.
+ */
+int32_t afd_derivees_suivant( Afd_derivees * afd, int32_t etat, char lettre );
+
+/**
+ * @brief Renvoie 1 si l'état est final, c'est-à-dire si sa dérivée
+ *        contient le mot vide, et 0 sinon.
+ *
+ * @param afd Un Afd des dérivées.
+ * @param etat Un état de l'Afd des dérivées.
+ */
+int afd_derivees_est_final( const Afd_derivees * afd, int32_t etat );
+
+/**
+ * @brief Renvoie 1 si le mot (terminé par '\0') est reconnu et 0 sinon.
+ *
+ * @param afd Un Afd des dérivées.
+ * @param mot Un mot.
+ */
+int afd_derivees_reconnait( Afd_derivees * afd, const char * mot );
+
+/**
+ * @brief Renvoie 1 si le mot formé des 'longueur' premiers octets de 'mot'
+ *        est reconnu et 0 sinon.
+ *
+ * @param afd Un Afd des dérivées.
+ * @param mot Un tableau d'octets.
+ * @param longueur Le nombre d'octets du mot.
+ */
+int afd_derivees_reconnait_tampon(
+	Afd_derivees * afd, const char * mot, size_t longueur
+);
+
+/**
+ * @brief Calcule toutes les transitions de l'Afd des dérivées et renvoie
+ *        l'automate déterministe complet correspondant.
+ *
+ * Les états de l'automate sont ceux de l'Afd des dérivées, de 0 à
+ * nb_etats-1. Son alphabet est celui de l'expression, et toutes les
+ * transitions sont définies : l'état ∅, s'il est atteint, boucle sur
+ * chaque lettre.
+ *
+ * @param afd Un Afd des dérivées.
+ * @return L'automate déterministe complet.
+ */
+Automate * automate_des_derivees( Afd_derivees * afd );
+
+/**
+ * @brief Renvoie l'automate déterministe complet des dérivées d'une
+ *        expression rationnelle (voir automate_des_derivees()).
+ *
+ * @param rat Une expression rationnelle.
+ * @return L'automate de Brzozowski.
+ */
+Automate * Brzozowski( Rationnel * rat );
+
+#endif
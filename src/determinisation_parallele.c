@@ -0,0 +1,418 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define _GNU_SOURCE
+
+#include "determinisation_parallele.h"
+#include "automate_fige.h"
+#include "bitset.h"
+#include "sous_ensembles.h"
+#include "outils.h"
+
+#include <limits.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <string.h>
+#include <unistd.h>
+
+/*
+ * La table des sous-ensembles est découpée en NB_TRANCHES tranches, choisies
+ * par les bits de poids fort du haché.
+ */
+#define NB_TRANCHES 64
+
+/*
+ * Les états sont rangés par blocs de TAILLE_BLOC_ETATS, alloués à la
+ * demande : un état ne change jamais d'adresse.
+ */
+#define TAILLE_BLOC_ETATS 4096
+#define NB_BLOCS_ETATS ( 1 << 16 )
+
+typedef struct {
+	int * elements;		// le sous-ensemble, libéré après développement
+	int taille;
+	int * suivants;		// un état par classe de lettres
+	char final;
+} Etat_parallele;
+
+typedef struct {
+	pthread_mutex_t verrou;
+	Table_sous_ensembles * table;
+	int * numeros;		// numéro global de chaque sous-ensemble de la tranche
+	int capacite;
+} Tranche;
+
+/*
+ * File d'un fil : il empile et dépile à la fin, les autres fils volent au
+ * début.
+ */
+typedef struct {
+	pthread_mutex_t verrou;
+	int * taches;
+	int debut;
+	int fin;
+	int capacite;
+} File_de_taches;
+
+typedef struct Determinisation_parallele {
+	const Automate_fige * fige;
+	int * representant;		// une lettre de chaque classe
+	int nb_fils;
+
+	Tranche tranches[ NB_TRANCHES ];
+	_Atomic( Etat_parallele * ) blocs[ NB_BLOCS_ETATS ];
+	atomic_int nb_etats;
+	atomic_long en_attente;	// états créés et pas encore développés
+
+	File_de_taches * files;
+} Determinisation_parallele;
+
+typedef struct {
+	Determinisation_parallele * d;
+	int numero;
+	int * position;
+	int * cibles;
+} Fil_determinisation;
+
+Etat_parallele * etat_parallele( Determinisation_parallele * d, int id ){
+	Etat_parallele * bloc = atomic_load( &d->blocs[ id / TAILLE_BLOC_ETATS ] );
+	if( ! bloc ){
+		Etat_parallele * nouveau = xmalloc(
+			TAILLE_BLOC_ETATS * sizeof(Etat_parallele)
+		);
+		memset( nouveau, 0, TAILLE_BLOC_ETATS * sizeof(Etat_parallele) );
+		if(
+			atomic_compare_exchange_strong(
+				&d->blocs[ id / TAILLE_BLOC_ETATS ], &bloc, nouveau
+			)
+		){
+			bloc = nouveau;
+		}else{
+			// Un autre fil a alloué le bloc entre-temps ; 'bloc' le contient
+			xfree( nouveau );
+		}
+	}
+	return bloc + id % TAILLE_BLOC_ETATS;
+}
+
+void empiler_tache( File_de_taches * f, int id ){
+	pthread_mutex_lock( &f->verrou );
+	if( f->fin == f->capacite ){
+		// On récupère d'abord la place libérée par les vols
+		if( f->debut > 0 ){
+			memmove(
+				f->taches, f->taches + f->debut,
+				( f->fin - f->debut ) * sizeof(int)
+			);
+			f->fin -= f->debut;
+			f->debut = 0;
+		}
+		if( f->fin == f->capacite ){
+			f->capacite *= 2;
+			f->taches = xrealloc( f->taches, f->capacite * sizeof(int) );
+		}
+	}
+	f->taches[ f->fin++ ] = id;
+	pthread_mutex_unlock( &f->verrou );
+}
+
+int depiler_tache( File_de_taches * f ){
+	int id = -1;
+	pthread_mutex_lock( &f->verrou );
+	if( f->fin > f->debut ) id = f->taches[ --f->fin ];
+	pthread_mutex_unlock( &f->verrou );
+	return id;
+}
+
+int voler_tache( File_de_taches * f ){
+	int id = -1;
+	pthread_mutex_lock( &f->verrou );
+	if( f->fin > f->debut ) id = f->taches[ f->debut++ ];
+	pthread_mutex_unlock( &f->verrou );
+	return id;
+}
+
+/*
+ * Interne le sous-ensemble trié et renvoie son numéro global. S'il est
+ * nouveau, son état est créé et mis dans la file du fil 'numero_fil'.
+ */
+int interner_parallele(
+	Determinisation_parallele * d, const int * elements, int taille,
+	int numero_fil
+){
+	uint64_t hache = hacher_sous_ensemble( elements, taille );
+	Tranche * tranche = d->tranches + ( hache >> 58 ) % NB_TRANCHES;
+
+	pthread_mutex_lock( &tranche->verrou );
+	int nouveau;
+	int local = interner_sous_ensemble(
+		tranche->table, elements, taille, &nouveau
+	);
+	if( ! nouveau ){
+		int id = tranche->numeros[ local ];
+		pthread_mutex_unlock( &tranche->verrou );
+		return id;
+	}
+	int id = atomic_fetch_add( &d->nb_etats, 1 );
+	if( id >= TAILLE_BLOC_ETATS * NB_BLOCS_ETATS ){
+		ERREUR( "Trop d'états pour la déterminisation parallèle" );
+	}
+	if( local == tranche->capacite ){
+		tranche->capacite *= 2;
+		tranche->numeros = xrealloc(
+			tranche->numeros, tranche->capacite * sizeof(int)
+		);
+	}
+	tranche->numeros[ local ] = id;
+	pthread_mutex_unlock( &tranche->verrou );
+
+	// Seul ce fil connaît l'état tant qu'il n'est pas dans une file
+	Etat_parallele * e = etat_parallele( d, id );
+	e->taille = taille;
+	e->elements = xmalloc( ( taille + 1 ) * sizeof(int) );
+	memcpy( e->elements, elements, taille * sizeof(int) );
+	e->suivants = xmalloc( ( d->fige->nb_classes + 1 ) * sizeof(int) );
+	e->final = 0;
+	int i;
+	for( i = 0; i < taille; i++ ){
+		if( BITSET_TEST( d->fige->finaux, elements[i] ) ) e->final = 1;
+	}
+	atomic_fetch_add( &d->en_attente, 1 );
+	empiler_tache( d->files + numero_fil, id );
+	return id;
+}
+
+/*
+ * Calcule les images du sous-ensemble de l'état par chaque classe de
+ * lettres, comme creer_automate_deterministe() : les fins des transitions
+ * étiquetées par les représentants des classes sont triées par classe.
+ */
+void developper_etat( Fil_determinisation * fil, int id ){
+	Determinisation_parallele * d = fil->d;
+	const Automate_fige * fige = d->fige;
+	Etat_parallele * e = etat_parallele( d, id );
+	int m = fige->nb_classes;
+	int * position = fil->position;
+	int * cibles = fil->cibles;
+	int i, a, k, x;
+
+	for( a = 0; a <= m; a++ ) position[a] = 0;
+	for( i = 0; i < e->taille; i++ ){
+		int q = e->elements[i];
+		for( k = fige->debut[q]; k < fige->debut[q+1]; k++ ){
+			int c = fige->classe[ (unsigned char) fige->lettre[k] ];
+			if( d->representant[c] != (unsigned char) fige->lettre[k] ) continue;
+			position[ c + 1 ] += fige->debut_fins[k+1] - fige->debut_fins[k];
+		}
+	}
+	for( a = 0; a < m; a++ ) position[a+1] += position[a];
+	for( i = 0; i < e->taille; i++ ){
+		int q = e->elements[i];
+		for( k = fige->debut[q]; k < fige->debut[q+1]; k++ ){
+			int c = fige->classe[ (unsigned char) fige->lettre[k] ];
+			if( d->representant[c] != (unsigned char) fige->lettre[k] ) continue;
+			for( x = fige->debut_fins[k]; x < fige->debut_fins[k+1]; x++ ){
+				cibles[ position[c]++ ] = fige->fins[x];
+			}
+		}
+	}
+	// position[a] est maintenant la fin du bloc de la classe a
+	int debut_bloc = 0;
+	for( a = 0; a < m; a++ ){
+		int taille = normaliser_sous_ensemble(
+			cibles + debut_bloc, position[a] - debut_bloc
+		);
+		e->suivants[a] = interner_parallele(
+			d, cibles + debut_bloc, taille, fil->numero
+		);
+		debut_bloc = position[a];
+	}
+	xfree( e->elements );
+	e->elements = NULL;
+}
+
+void * executer_fil_determinisation( void * data ){
+	Fil_determinisation * fil = (Fil_determinisation *) data;
+	Determinisation_parallele * d = fil->d;
+	while( 1 ){
+		int id = depiler_tache( d->files + fil->numero );
+		int i;
+		for( i = 1; id < 0 && i < d->nb_fils; i++ ){
+			id = voler_tache( d->files + ( fil->numero + i ) % d->nb_fils );
+		}
+		if( id < 0 ){
+			// Un état en cours de développement peut encore en créer
+			if( atomic_load( &d->en_attente ) == 0 ) break;
+			sched_yield();
+			continue;
+		}
+		developper_etat( fil, id );
+		atomic_fetch_sub( &d->en_attente, 1 );
+	}
+	return NULL;
+}
+
+/*
+ * Remplissage parallèle de l'automate résultat : chaque fil prend à son tour
+ * les TAILLE_TRANCHE_REMPLISSAGE états suivants et range leurs transitions
+ * d'un coup (voir remplir_etat_automate()).
+ */
+#define TAILLE_TRANCHE_REMPLISSAGE 256
+
+typedef struct {
+	Determinisation_parallele * d;
+	Automate * res;
+	int nb_etats;
+	atomic_int prochain;	// premier état de la prochaine tranche
+	int nb_lettres;
+	char lettres[256];		// triées comme des char
+	int classes[256];		// la classe de chaque lettre
+} Remplissage;
+
+void * executer_fil_remplissage( void * data ){
+	Remplissage * r = (Remplissage *) data;
+	int fins[256];
+	while( 1 ){
+		int debut = atomic_fetch_add( &r->prochain, TAILLE_TRANCHE_REMPLISSAGE );
+		if( debut >= r->nb_etats ) break;
+		int fin = debut + TAILLE_TRANCHE_REMPLISSAGE;
+		if( fin > r->nb_etats ) fin = r->nb_etats;
+		int i, j;
+		for( i = debut; i < fin; i++ ){
+			Etat_parallele * e = etat_parallele( r->d, i );
+			for( j = 0; j < r->nb_lettres; j++ ){
+				fins[j] = e->suivants[ r->classes[j] ];
+			}
+			remplir_etat_automate( r->res, i, r->nb_lettres, r->lettres, fins );
+			xfree( e->suivants );
+		}
+	}
+	return NULL;
+}
+
+Automate * creer_automate_deterministe_parallele(
+	const Automate * automate, int nb_fils
+){
+	if( nb_fils <= 0 ) nb_fils = (int) sysconf( _SC_NPROCESSORS_ONLN );
+	if( nb_fils <= 0 ) nb_fils = 1;
+
+	Automate_fige * fige = figer_automate( automate );
+	Determinisation_parallele * d = xmalloc( sizeof(Determinisation_parallele) );
+	int m = fige->nb_classes;
+	int i, l;
+
+	d->fige = fige;
+	d->nb_fils = nb_fils;
+	d->representant = xmalloc( ( m + 1 ) * sizeof(int) );
+	for( l = 255; l >= 0; l-- ){
+		if( fige->classe[l] >= 0 ) d->representant[ fige->classe[l] ] = l;
+	}
+	for( i = 0; i < NB_TRANCHES; i++ ){
+		pthread_mutex_init( &d->tranches[i].verrou, NULL );
+		d->tranches[i].table = creer_table_sous_ensembles();
+		d->tranches[i].capacite = 64;
+		d->tranches[i].numeros = xmalloc( 64 * sizeof(int) );
+	}
+	for( i = 0; i < NB_BLOCS_ETATS; i++ ) atomic_init( &d->blocs[i], NULL );
+	atomic_init( &d->nb_etats, 0 );
+	atomic_init( &d->en_attente, 0 );
+	d->files = xmalloc( nb_fils * sizeof(File_de_taches) );
+	Fil_determinisation * fils = xmalloc( nb_fils * sizeof(Fil_determinisation) );
+	pthread_t * threads = xmalloc( nb_fils * sizeof(pthread_t) );
+	for( i = 0; i < nb_fils; i++ ){
+		pthread_mutex_init( &d->files[i].verrou, NULL );
+		d->files[i].capacite = 64;
+		d->files[i].debut = 0;
+		d->files[i].fin = 0;
+		d->files[i].taches = xmalloc( 64 * sizeof(int) );
+		fils[i].d = d;
+		fils[i].numero = i;
+		fils[i].position = xmalloc( ( m + 2 ) * sizeof(int) );
+		fils[i].cibles = xmalloc( ( fige->nb_transitions + 1 ) * sizeof(int) );
+	}
+
+	// Le sous-ensemble initial, trié puisque les numéros denses suivent
+	// l'ordre des états
+	int * initiaux = xmalloc( ( fige->nb_etats + 1 ) * sizeof(int) );
+	int nb_initiaux = 0;
+	for( i = 0; i < fige->nb_etats; i++ ){
+		if( BITSET_TEST( fige->initiaux, i ) ) initiaux[ nb_initiaux++ ] = i;
+	}
+	int initial = interner_parallele( d, initiaux, nb_initiaux, 0 );
+	xfree( initiaux );
+
+	for( i = 1; i < nb_fils; i++ ){
+		if( pthread_create( threads + i, NULL, executer_fil_determinisation, fils + i ) ){
+			ERREUR( "Impossible de créer un fil d'exécution" );
+		}
+	}
+	executer_fil_determinisation( fils );
+	for( i = 1; i < nb_fils; i++ ) pthread_join( threads[i], NULL );
+
+	// Remplissage de l'automate résultat : les états et l'alphabet d'abord,
+	// puis les transitions, par tranches d'états réparties entre les fils
+	int n = atomic_load( &d->nb_etats );
+	Remplissage r;
+	r.d = d;
+	r.res = creer_automate_etats_consecutifs( n );
+	r.nb_etats = n;
+	atomic_init( &r.prochain, 0 );
+	// Les lettres dans l'ordre des char, celui des listes de transitions
+	r.nb_lettres = 0;
+	for( l = CHAR_MIN; l <= CHAR_MAX; l++ ){
+		int c = fige->classe[ (unsigned char) l ];
+		if( c < 0 ) continue;
+		r.lettres[ r.nb_lettres ] = (char) l;
+		r.classes[ r.nb_lettres++ ] = c;
+		ajouter_lettre( r.res, (char) l );
+	}
+	for( i = 0; i < n; i++ ){
+		if( etat_parallele( d, i )->final ) ajouter_etat_final( r.res, i );
+	}
+	ajouter_etat_initial( r.res, initial );
+
+	for( i = 1; i < nb_fils; i++ ){
+		if( pthread_create( threads + i, NULL, executer_fil_remplissage, &r ) ){
+			ERREUR( "Impossible de créer un fil d'exécution" );
+		}
+	}
+	executer_fil_remplissage( &r );
+	for( i = 1; i < nb_fils; i++ ) pthread_join( threads[i], NULL );
+	Automate * res = r.res;
+
+	for( i = 0; i < nb_fils; i++ ){
+		pthread_mutex_destroy( &d->files[i].verrou );
+		xfree( d->files[i].taches );
+		xfree( fils[i].position );
+		xfree( fils[i].cibles );
+	}
+	for( i = 0; i < NB_TRANCHES; i++ ){
+		pthread_mutex_destroy( &d->tranches[i].verrou );
+		liberer_table_sous_ensembles( d->tranches[i].table );
+		xfree( d->tranches[i].numeros );
+	}
+	for( i = 0; i < NB_BLOCS_ETATS; i++ ) xfree( atomic_load( &d->blocs[i] ) );
+	xfree( d->files );
+	xfree( fils );
+	xfree( threads );
+	xfree( d->representant );
+	xfree( d );
+	liberer_automate_fige( fige );
+	return res;
+}
@@ -0,0 +1,54 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file determinisation_parallele.h */
+
+#ifndef __DETERMINISATION_PARALLELE_H__
+#define __DETERMINISATION_PARALLELE_H__
+
+#include "automate.h"
+
+/**
+ * @brief Crée l'automate déterministe de l'automate passé en paramètre, en
+ *        répartissant la construction des sous-ensembles sur plusieurs fils
+ *        d'exécution.
+ *
+ * Le résultat est le même que celui de creer_automate_deterministe(), aux
+ * numéros des états près : mêmes sous-ensembles atteignables (puits
+ * compris), mêmes transitions, mêmes états finaux. Les numéros dépendent de
+ * l'ordre dans lequel les fils découvrent les sous-ensembles.
+ *
+ * Chaque fil développe les sous-ensembles de sa propre file, et vole ceux
+ * des autres fils lorsque la sienne est vide. Les sous-ensembles découverts
+ * sont internés dans une table partagée, découpée en tranches protégées
+ * chacune par un verrou ; leurs numéros sont attribués par un compteur
+ * atomique. L'automate résultat est ensuite rempli par les mêmes fils : ses
+ * états et son tableau d'adjacences sont créés d'avance (voir
+ * creer_automate_etats_consecutifs()), et chaque fil range les transitions
+ * d'une tranche d'états à la fois.
+ *
+ * @param automate Un automate.
+ * @param nb_fils Le nombre de fils d'exécution, ou 0 pour un fil par
+ *        processeur.
+ * @return L'automate déterministe.
+ */
+Automate * creer_automate_deterministe_parallele(
+	const Automate * automate, int nb_fils
+);
+
+#endif
@@ -257,3 +257,19 @@ int iterateur_ensemble_est_vide( Ensemble_iterateur iterateur ){
 intptr_t get_element( Ensemble_iterateur it ){
 	return get_cle( it );
 }
+
+int* ensemble_vers_tableau( const Ensemble* ens, int* taille ){
+	int n = taille_ensemble( ens );
+	int* res = xmalloc( ( n > 0 ? n : 1 ) * sizeof(int) );
+	int i = 0;
+	Ensemble_iterateur it;
+	for(
+		it = premier_iterateur_ensemble( ens );
+		! iterateur_ensemble_est_vide( it );
+		it = iterateur_suivant_ensemble( it )
+	){
+		res[i++] = get_element( it );
+	}
+	*taille = n;
+	return res;
+}
@@ -239,4 +239,12 @@ int iterateur_ensemble_est_vide( Ensemble_iterateur iterateur );
  */
 intptr_t get_element( Ensemble_iterateur it );
 
+/*
+ * Renvoie un tableau, alloué avec xmalloc(), contenant les éléments 
+ * (entiers) de l'ensemble dans l'ordre croissant.
+ * Le nombre d'éléments est écrit dans 'taille'.
+ * La mémoire du tableau est à la charge de l'utilisateur.
+ */
+int* ensemble_vers_tableau( const Ensemble* ens, int* taille );
+
 #endif
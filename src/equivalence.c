@@ -0,0 +1,210 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "equivalence.h"
+#include "afd_paresseux.h"
+#include "sous_ensembles.h"
+#include "outils.h"
+
+#include <stdint.h>
+#include <string.h>
+
+/*
+ * Union-find sur les états des deux Afd paresseux : l'état p du premier a
+ * le numéro 2p, l'état q du second le numéro 2q+1. Le tableau grandit avec
+ * les numéros des états créés.
+ */
+typedef struct {
+	int * parent;
+	int capacite;
+} Union_find;
+
+int trouver_union_find( Union_find * uf, int x ){
+	if( x >= uf->capacite ){
+		int ancienne = uf->capacite;
+		while( x >= uf->capacite ) uf->capacite *= 2;
+		uf->parent = xrealloc( uf->parent, uf->capacite * sizeof(int) );
+		int i;
+		for( i = ancienne; i < uf->capacite; i++ ) uf->parent[i] = i;
+	}
+	while( uf->parent[x] != x ){
+		uf->parent[x] = uf->parent[ uf->parent[x] ];
+		x = uf->parent[x];
+	}
+	return x;
+}
+
+/*
+ * Fusionne les classes de x et y ; renvoie 0 si elles étaient déjà égales.
+ */
+int unir_union_find( Union_find * uf, int x, int y ){
+	x = trouver_union_find( uf, x );
+	y = trouver_union_find( uf, y );
+	if( x == y ) return 0;
+	uf->parent[x] = y;
+	return 1;
+}
+
+/*
+ * Un couple du parcours en largeur, avec le couple depuis lequel il a été
+ * atteint et la lettre lue, pour reconstruire le contre-exemple.
+ */
+typedef struct {
+	int32_t p;
+	int32_t q;
+	int parent;
+	char lettre;
+} Couple_equivalence;
+
+/*
+ * Une lettre par couple (classe dans le premier, classe dans le second) :
+ * deux lettres du même couple de classes mènent aux mêmes états. Le couple
+ * (0, 0), des lettres hors des deux alphabets, mène aux deux états morts.
+ */
+int lettres_representantes(
+	const Afd_paresseux * a, const Afd_paresseux * b, char lettres[256]
+){
+	char * vu = xmalloc( (size_t) a->nb_classes * b->nb_classes );
+	memset( vu, 0, (size_t) a->nb_classes * b->nb_classes );
+	int nb_lettres = 0;
+	int i;
+	for( i = 0; i < 256; i++ ){
+		size_t couple = (size_t) a->classe[i] * b->nb_classes + b->classe[i];
+		if( couple == 0 || vu[ couple ] ) continue;
+		vu[ couple ] = 1;
+		lettres[ nb_lettres++ ] = (char) i;
+	}
+	xfree( vu );
+	return nb_lettres;
+}
+
+char * reconstruire_contre_exemple( const Couple_equivalence * couples, int i ){
+	int longueur = 0, j;
+	for( j = i; couples[j].parent >= 0; j = couples[j].parent ) longueur++;
+	char * mot = xmalloc( longueur + 1 );
+	mot[ longueur ] = '\0';
+	for( j = i; couples[j].parent >= 0; j = couples[j].parent ){
+		mot[ --longueur ] = couples[j].lettre;
+	}
+	return mot;
+}
+
+/*
+ * Parcourt en largeur les couples d'états atteints par un même mot et
+ * renvoie 1 si aucun couple n'a un seul état final.
+ *
+ * Avec 'union_find', un couple n'est exploré que si ses deux états ne sont
+ * pas déjà fusionnés (Hopcroft et Karp). Sinon, chaque couple est exploré
+ * une fois, et le premier couple distinguant est atteint par un plus court
+ * mot, écrit dans '*contre_exemple'.
+ */
+int explorer_couples(
+	Afd_paresseux * a, Afd_paresseux * b, int union_find,
+	char ** contre_exemple
+){
+	char lettres[256];
+	int nb_lettres = lettres_representantes( a, b, lettres );
+
+	Union_find uf;
+	uf.capacite = 64;
+	uf.parent = xmalloc( uf.capacite * sizeof(int) );
+	int i, l;
+	for( i = 0; i < uf.capacite; i++ ) uf.parent[i] = i;
+	Table_sous_ensembles * vus = creer_table_sous_ensembles();
+
+	int capacite = 64;
+	Couple_equivalence * couples = xmalloc( capacite * sizeof(Couple_equivalence) );
+	int nb_couples = 1;
+	couples[0].p = a->initial;
+	couples[0].q = b->initial;
+	couples[0].parent = -1;
+	if( union_find ){
+		unir_union_find( &uf, 2 * a->initial, 2 * b->initial + 1 );
+	}else{
+		int32_t initial[2] = { a->initial, b->initial };
+		interner_sous_ensemble( vus, initial, 2, NULL );
+	}
+
+	int res = 1;
+	int distinguant = -1;
+	if( afd_paresseux_est_final( a, a->initial ) != afd_paresseux_est_final( b, b->initial ) ){
+		distinguant = 0;
+	}
+	for( i = 0; i < nb_couples && distinguant < 0; i++ ){
+		for( l = 0; l < nb_lettres && distinguant < 0; l++ ){
+			int32_t couple[2];
+			couple[0] = afd_paresseux_suivant( a, couples[i].p, lettres[l] );
+			couple[1] = afd_paresseux_suivant( b, couples[i].q, lettres[l] );
+			int nouveau;
+			if( union_find ){
+				nouveau = unir_union_find( &uf, 2 * couple[0], 2 * couple[1] + 1 );
+			}else{
+				interner_sous_ensemble( vus, couple, 2, &nouveau );
+			}
+			if( ! nouveau ) continue;
+
+			if( nb_couples == capacite ){
+				capacite *= 2;
+				couples = xrealloc( couples, capacite * sizeof(Couple_equivalence) );
+			}
+			couples[ nb_couples ].p = couple[0];
+			couples[ nb_couples ].q = couple[1];
+			couples[ nb_couples ].parent = i;
+			couples[ nb_couples ].lettre = lettres[l];
+			if(
+				afd_paresseux_est_final( a, couple[0] ) !=
+				afd_paresseux_est_final( b, couple[1] )
+			){
+				distinguant = nb_couples;
+			}
+			nb_couples++;
+		}
+	}
+
+	if( distinguant >= 0 ){
+		res = 0;
+		if( contre_exemple ){
+			*contre_exemple = reconstruire_contre_exemple( couples, distinguant );
+		}
+	}
+	xfree( couples );
+	xfree( uf.parent );
+	liberer_table_sous_ensembles( vus );
+	return res;
+}
+
+int automates_equivalents(
+	const Automate * automate_1, const Automate * automate_2,
+	char ** contre_exemple
+){
+	// Les numéros des états des Afd paresseux ne doivent pas changer
+	Afd_paresseux * a = creer_afd_paresseux( automate_1, SIZE_MAX );
+	Afd_paresseux * b = creer_afd_paresseux( automate_2, SIZE_MAX );
+
+	int res = explorer_couples( a, b, 1, NULL );
+	// Avec l'union-find, le premier couple distinguant n'est pas toujours
+	// atteint par un plus court mot : on refait un parcours sans fusion, qui
+	// s'arrête à la profondeur du plus court contre-exemple.
+	if( ! res && contre_exemple ){
+		explorer_couples( a, b, 0, contre_exemple );
+	}
+
+	liberer_afd_paresseux( a );
+	liberer_afd_paresseux( b );
+	return res;
+}
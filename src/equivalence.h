@@ -0,0 +1,52 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file equivalence.h */
+
+#ifndef __EQUIVALENCE_H__
+#define __EQUIVALENCE_H__
+
+#include "automate.h"
+
+/**
+ * @brief Renvoie 1 si les deux automates reconnaissent le même langage, et
+ *        0 sinon.
+ *
+ * Les automates n'ont pas besoin d'être déterministes : leurs automates des
+ * parties sont construits à la demande (voir afd_paresseux.h), pendant le
+ * parcours en largeur des couples d'états atteints par un même mot. Les
+ * couples dont les deux états sont déjà connus comme équivalents sont
+ * ignorés : les états sont fusionnés dans une structure union-find
+ * (algorithme de Hopcroft et Karp). Le parcours s'arrête au premier couple
+ * dont un seul état est final.
+ *
+ * Si les langages sont différents et que 'contre_exemple' n'est pas NULL,
+ * '*contre_exemple' reçoit un plus court mot reconnu par un seul des deux
+ * automates, alloué avec xmalloc() et terminé par '\0'. Sinon,
+ * '*contre_exemple' n'est pas modifié.
+ *
+ * @param automate_1 Un automate.
+ * @param automate_2 Un automate.
+ * @param contre_exemple L'adresse où écrire le contre-exemple, ou NULL.
+ */
+int automates_equivalents(
+	const Automate * automate_1, const Automate * automate_2,
+	char ** contre_exemple
+);
+
+#endif
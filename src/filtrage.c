@@ -0,0 +1,166 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define _GNU_SOURCE
+
+#include "filtrage.h"
+#include "outils.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <string.h>
+#include <unistd.h>
+
+/*
+ * Les lignes choisies d'un morceau. Le tableau 'lignes' n'est agrandi que
+ * lorsqu'il est plein : le nombre d'allocations est logarithmique en le
+ * nombre de lignes choisies.
+ */
+typedef struct {
+	size_t nb;
+	size_t capacite;
+	Occurrence * lignes;
+} Resultat_morceau;
+
+typedef struct {
+	const Afd * afd;
+	const char * texte;
+	size_t longueur;
+	int inverser;
+	size_t taille_morceau;
+	size_t nb_morceaux;
+	atomic_size_t prochain;
+	int garder_lignes;
+	Resultat_morceau * resultats;
+} Filtrage;
+
+/*
+ * Début de la première ligne du morceau i : les lignes appartiennent au
+ * morceau qui contient leur premier octet.
+ */
+size_t debut_morceau( const Filtrage * f, size_t i ){
+	if( i == 0 ) return 0;
+	size_t debut = i * f->taille_morceau;
+	if( debut >= f->longueur ) return f->longueur;
+	const char * nl = memchr(
+		f->texte + debut - 1, '\n', f->longueur - debut + 1
+	);
+	return nl ? (size_t) ( nl - f->texte ) + 1 : f->longueur;
+}
+
+void filtrer_morceau( Filtrage * f, size_t i ){
+	const int32_t * suivant = f->afd->suivant;
+	const uint16_t * classe = f->afd->classe;
+	int32_t m = f->afd->nb_classes;
+	int32_t initial = f->afd->initial * m;
+	Resultat_morceau * r = f->resultats + i;
+	size_t debut = debut_morceau( f, i );
+	size_t fin_morceau = debut_morceau( f, i + 1 );
+
+	while( debut < fin_morceau ){
+		const char * nl = memchr( f->texte + debut, '\n', fin_morceau - debut );
+		size_t fin = nl ? (size_t) ( nl - f->texte ) : fin_morceau;
+		const unsigned char * p = (const unsigned char *) f->texte + debut;
+		const unsigned char * p_fin = (const unsigned char *) f->texte + fin;
+		int32_t ligne = initial;
+		while( p < p_fin && ligne != AFD_MORT ){
+			ligne = suivant[ ligne + classe[ *p++ ] ];
+		}
+		if( afd_est_final( f->afd, ligne / m ) != f->inverser ){
+			if( f->garder_lignes ){
+				if( r->nb == r->capacite ){
+					r->capacite = 2 * r->capacite + 16;
+					r->lignes = xrealloc(
+						r->lignes, r->capacite * sizeof(Occurrence)
+					);
+				}
+				r->lignes[ r->nb ].debut = debut;
+				r->lignes[ r->nb ].fin = fin;
+			}
+			r->nb++;
+		}
+		debut = fin + 1;
+	}
+}
+
+void * fil_filtrage( void * donnees ){
+	Filtrage * f = (Filtrage*) donnees;
+	size_t i;
+	while( ( i = atomic_fetch_add( &f->prochain, 1 ) ) < f->nb_morceaux ){
+		filtrer_morceau( f, i );
+	}
+	return NULL;
+}
+
+size_t filtrer_lignes(
+	const Afd * afd, const char * texte, size_t longueur, int inverser,
+	int nb_fils, size_t taille_morceau, Occurrence ** lignes
+){
+	Filtrage f;
+	f.afd = afd;
+	f.texte = texte;
+	f.longueur = longueur;
+	f.inverser = inverser ? 1 : 0;
+	f.taille_morceau = taille_morceau ? taille_morceau : TAILLE_MORCEAU_FILTRAGE;
+	f.nb_morceaux = ( longueur + f.taille_morceau - 1 ) / f.taille_morceau;
+	atomic_init( &f.prochain, 0 );
+	f.garder_lignes = ( lignes != NULL );
+	f.resultats = xmalloc( ( f.nb_morceaux + 1 ) * sizeof(Resultat_morceau) );
+	size_t i;
+	for( i = 0; i < f.nb_morceaux; i++ ){
+		f.resultats[i].nb = 0;
+		f.resultats[i].capacite = 0;
+		f.resultats[i].lignes = NULL;
+	}
+
+	if( nb_fils <= 0 ) nb_fils = (int) sysconf( _SC_NPROCESSORS_ONLN );
+	if( nb_fils < 1 ) nb_fils = 1;
+	if( (size_t) nb_fils > f.nb_morceaux ) nb_fils = (int) f.nb_morceaux;
+	if( nb_fils <= 1 ){
+		fil_filtrage( &f );
+	}else{
+		pthread_t * fils = xmalloc( nb_fils * sizeof(pthread_t) );
+		int k;
+		for( k = 0; k < nb_fils; k++ ){
+			if( pthread_create( fils + k, NULL, fil_filtrage, &f ) ){
+				ERREUR( "Impossible de créer un fil d'exécution" );
+			}
+		}
+		for( k = 0; k < nb_fils; k++ ) pthread_join( fils[k], NULL );
+		xfree( fils );
+	}
+
+	// Les résultats des morceaux sont mis bout à bout, dans l'ordre
+	size_t total = 0;
+	for( i = 0; i < f.nb_morceaux; i++ ) total += f.resultats[i].nb;
+	if( lignes ){
+		*lignes = xmalloc( ( total + 1 ) * sizeof(Occurrence) );
+		size_t k = 0;
+		for( i = 0; i < f.nb_morceaux; i++ ){
+			if( f.resultats[i].nb == 0 ) continue;
+			memcpy(
+				*lignes + k, f.resultats[i].lignes,
+				f.resultats[i].nb * sizeof(Occurrence)
+			);
+			k += f.resultats[i].nb;
+		}
+	}
+	for( i = 0; i < f.nb_morceaux; i++ ) xfree( f.resultats[i].lignes );
+	xfree( f.resultats );
+	return total;
+}
@@ -0,0 +1,67 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file filtrage.h */
+
+#ifndef __FILTRAGE_H__
+#define __FILTRAGE_H__
+
+#include "afd.h"
+#include "recherche.h"
+
+#include <stddef.h>
+
+/**
+ * @brief Taille par défaut, en octets, des morceaux de texte répartis entre
+ *        les fils d'exécution.
+ */
+#define TAILLE_MORCEAU_FILTRAGE ( (size_t) 1 << 20 )
+
+/**
+ * @brief Cherche les lignes d'un texte reconnues par un Afd.
+ *
+ * Les lignes sont séparées par '\n', qui n'en fait pas partie ; une
+ * dernière ligne non terminée par '\n' compte comme une ligne. Le texte est
+ * découpé en morceaux d'environ 'taille_morceau' octets, prolongés jusqu'à
+ * une fin de ligne, que les fils d'exécution se répartissent : chaque fil
+ * prend le prochain morceau libre dès qu'il a fini le précédent. Le texte
+ * n'est jamais copié et aucune mémoire n'est allouée par ligne.
+ *
+ * Si 'lignes' n'est pas NULL, '*lignes' reçoit un tableau, alloué avec
+ * xmalloc(), des lignes choisies dans l'ordre du texte : 'debut' est
+ * l'indice du premier octet et 'fin' celui du '\n' (ou la longueur du
+ * texte).
+ *
+ * @param afd Un Afd.
+ * @param texte Un tableau d'octets.
+ * @param longueur Le nombre d'octets du texte.
+ * @param inverser 0 pour garder les lignes reconnues, 1 pour garder les
+ *        autres.
+ * @param nb_fils Le nombre de fils d'exécution, ou 0 pour un fil par
+ *        processeur.
+ * @param taille_morceau La taille des morceaux, ou 0 pour
+ *        TAILLE_MORCEAU_FILTRAGE.
+ * @param lignes L'adresse où écrire le tableau des lignes, ou NULL.
+ * @return Le nombre de lignes choisies.
+ */
+size_t filtrer_lignes(
+	const Afd * afd, const char * texte, size_t longueur, int inverser,
+	int nb_fils, size_t taille_morceau, Occurrence ** lignes
+);
+
+#endif
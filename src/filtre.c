@@ -0,0 +1,164 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * filtre : affiche les lignes de fichiers reconnues par une expression
+ * rationnelle.
+ *
+ *     filtre [-c] [-v] [-j nb_fils] expression [fichier ...]
+ *
+ * Une ligne est affichée si elle est entièrement reconnue par l'expression
+ * (voir expression_to_rationnel() pour la syntaxe). Avec -c, seul le nombre
+ * de lignes est affiché ; avec -v, ce sont les lignes non reconnues qui sont
+ * choisies ; -j fixe le nombre de fils d'exécution (un par processeur par
+ * défaut). Les fichiers sont projetés en mémoire par mmap() et ne sont
+ * jamais copiés.
+ */
+
+#define _GNU_SOURCE
+
+#include "afd.h"
+#include "filtrage.h"
+#include "outils.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+void usage( const char * nom ){
+	fprintf(
+		stderr, "Usage : %s [-c] [-v] [-j nb_fils] expression [fichier ...]\n",
+		nom
+	);
+	exit( 2 );
+}
+
+/*
+ * Filtre un fichier, ou l'entrée standard si 'chemin' vaut NULL ; renvoie
+ * le nombre de lignes choisies, ou -1 en cas d'erreur.
+ */
+long filtrer_fichier(
+	const Afd * afd, const char * chemin, int compter, int inverser,
+	int nb_fils, const char * prefixe
+){
+	int fd = chemin ? open( chemin, O_RDONLY ) : STDIN_FILENO;
+	if( fd < 0 ){
+		perror( chemin );
+		return -1;
+	}
+	struct stat st;
+	if( fstat( fd, &st ) < 0 ){
+		perror( chemin ? chemin : "stdin" );
+		if( chemin ) close( fd );
+		return -1;
+	}
+
+	// Un fichier ordinaire est projeté ; un tube est lu en entier
+	size_t longueur = 0;
+	char * texte = NULL;
+	int projete = 0;
+	if( S_ISREG( st.st_mode ) ){
+		longueur = (size_t) st.st_size;
+		if( longueur > 0 ){
+			texte = mmap( NULL, longueur, PROT_READ, MAP_PRIVATE, fd, 0 );
+			if( texte == MAP_FAILED ){
+				perror( chemin ? chemin : "stdin" );
+				if( chemin ) close( fd );
+				return -1;
+			}
+			madvise( texte, longueur, MADV_SEQUENTIAL );
+			projete = 1;
+		}
+	}else{
+		size_t capacite = 1 << 16;
+		texte = xmalloc( capacite );
+		ssize_t lus;
+		while( ( lus = read( fd, texte + longueur, capacite - longueur ) ) > 0 ){
+			longueur += (size_t) lus;
+			if( longueur == capacite ){
+				capacite *= 2;
+				texte = xrealloc( texte, capacite );
+			}
+		}
+	}
+	if( chemin ) close( fd );
+
+	Occurrence * lignes = NULL;
+	size_t nb = filtrer_lignes(
+		afd, texte, longueur, inverser, nb_fils, 0, compter ? NULL : &lignes
+	);
+	if( compter ){
+		if( prefixe ) printf( "%s:", prefixe );
+		printf( "%zu\n", nb );
+	}else{
+		size_t i;
+		for( i = 0; i < nb; i++ ){
+			if( prefixe ) printf( "%s:", prefixe );
+			fwrite( texte + lignes[i].debut, 1, lignes[i].fin - lignes[i].debut, stdout );
+			putchar( '\n' );
+		}
+		xfree( lignes );
+	}
+
+	if( projete ){
+		munmap( texte, longueur );
+	}else{
+		xfree( texte );
+	}
+	return (long) nb;
+}
+
+int main( int argc, char ** argv ){
+	int compter = 0, inverser = 0, nb_fils = 0, option;
+	while( ( option = getopt( argc, argv, "cvj:" ) ) != -1 ){
+		switch( option ){
+			case 'c': compter = 1; break;
+			case 'v': inverser = 1; break;
+			case 'j': nb_fils = atoi( optarg ); break;
+			default: usage( argv[0] );
+		}
+	}
+	if( optind >= argc ) usage( argv[0] );
+
+	Afd * afd = creer_afd_expression( argv[ optind++ ] );
+	if( ! afd ) return 2;
+
+	int nb_fichiers = argc - optind;
+	int erreur = 0;
+	long total = 0;
+	if( nb_fichiers == 0 ){
+		long nb = filtrer_fichier( afd, NULL, compter, inverser, nb_fils, NULL );
+		if( nb < 0 ) erreur = 1; else total += nb;
+	}
+	for( ; optind < argc; optind++ ){
+		long nb = filtrer_fichier(
+			afd, argv[ optind ], compter, inverser, nb_fils,
+			nb_fichiers > 1 ? argv[ optind ] : NULL
+		);
+		if( nb < 0 ) erreur = 1; else total += nb;
+	}
+	liberer_afd( afd );
+
+	// Comme grep : 0 si une ligne a été choisie, 1 sinon, 2 en cas d'erreur
+	if( erreur ) return 2;
+	return total > 0 ? 0 : 1;
+}
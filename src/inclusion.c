@@ -0,0 +1,223 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "inclusion.h"
+#include "automate_fige.h"
+#include "bitset.h"
+#include "outils.h"
+
+#include <string.h>
+
+/*
+ * Un couple (p, S) du parcours : p est un état dense du premier automate,
+ * S est rangé dans la réserve des ensembles, à partir de l'indice
+ * 'ensemble'. Le couple a été atteint depuis le couple 'parent' en lisant
+ * 'lettre' ; il est 'domine' si un couple (p, S') avec S' strictement
+ * inclus dans S a été atteint depuis.
+ */
+typedef struct {
+	int p;
+	size_t ensemble;
+	int parent;
+	char lettre;
+	char domine;
+} Couple_inclusion;
+
+typedef struct {
+	Automate_fige * a;
+	Automate_fige * b;
+	size_t w;					// nombre de mots d'un ensemble d'états de b
+
+	Couple_inclusion * couples;
+	int nb_couples;
+	int capacite_couples;
+	uint64_t * ensembles;		// réserve des ensembles des couples
+	size_t capacite_ensembles;
+
+	// antichaines[p] : couples non dominés dont le premier état est p
+	int ** antichaines;
+	int * nb_antichaines;
+	int * capacite_antichaines;
+} Donnees_inclusion;
+
+/*
+ * Ajoute le couple (p, S) s'il n'est pas couvert par l'antichaîne de p ;
+ * renvoie son indice, ou -1.
+ */
+int ajouter_couple_inclusion(
+	Donnees_inclusion * d, int p, const uint64_t * ensemble,
+	int parent, char lettre
+){
+	int * antichaine = d->antichaines[p];
+	int i, n = d->nb_antichaines[p];
+	for( i = 0; i < n; i++ ){
+		const uint64_t * autre =
+			d->ensembles + d->couples[ antichaine[i] ].ensemble;
+		if( bitset_est_inclus( autre, ensemble, d->w ) ) return -1;
+	}
+	// Les couples dont l'ensemble contient S sont dominés par (p, S)
+	int k = 0;
+	for( i = 0; i < n; i++ ){
+		Couple_inclusion * c = d->couples + antichaine[i];
+		if( bitset_est_inclus( ensemble, d->ensembles + c->ensemble, d->w ) ){
+			c->domine = 1;
+		}else{
+			antichaine[ k++ ] = antichaine[i];
+		}
+	}
+	d->nb_antichaines[p] = k;
+
+	if( d->nb_couples == d->capacite_couples ){
+		d->capacite_couples *= 2;
+		d->couples = xrealloc(
+			d->couples, d->capacite_couples * sizeof(Couple_inclusion)
+		);
+	}
+	size_t debut = (size_t) d->nb_couples * d->w;
+	if( debut + d->w > d->capacite_ensembles ){
+		while( debut + d->w > d->capacite_ensembles ) d->capacite_ensembles *= 2;
+		d->ensembles = xrealloc(
+			d->ensembles, d->capacite_ensembles * sizeof(uint64_t)
+		);
+	}
+	memcpy( d->ensembles + debut, ensemble, d->w * sizeof(uint64_t) );
+	int id = d->nb_couples++;
+	d->couples[id].p = p;
+	d->couples[id].ensemble = debut;
+	d->couples[id].parent = parent;
+	d->couples[id].lettre = lettre;
+	d->couples[id].domine = 0;
+
+	if( d->nb_antichaines[p] == d->capacite_antichaines[p] ){
+		d->capacite_antichaines[p] = 2 * d->capacite_antichaines[p] + 4;
+		d->antichaines[p] = xrealloc(
+			d->antichaines[p], d->capacite_antichaines[p] * sizeof(int)
+		);
+	}
+	d->antichaines[p][ d->nb_antichaines[p]++ ] = id;
+	return id;
+}
+
+/*
+ * Renvoie 1 si le couple est fautif : p final et aucun état final dans S.
+ */
+int couple_fautif( const Donnees_inclusion * d, int id ){
+	const Couple_inclusion * c = d->couples + id;
+	if( ! BITSET_TEST( d->a->finaux, c->p ) ) return 0;
+	const uint64_t * ensemble = d->ensembles + c->ensemble;
+	size_t i;
+	for( i = 0; i < d->w; i++ ){
+		if( ensemble[i] & d->b->finaux[i] ) return 0;
+	}
+	return 1;
+}
+
+char * reconstruire_temoin( const Couple_inclusion * couples, int i ){
+	int longueur = 0, j;
+	for( j = i; couples[j].parent >= 0; j = couples[j].parent ) longueur++;
+	char * mot = xmalloc( longueur + 1 );
+	mot[ longueur ] = '\0';
+	for( j = i; couples[j].parent >= 0; j = couples[j].parent ){
+		mot[ --longueur ] = couples[j].lettre;
+	}
+	return mot;
+}
+
+int automate_est_inclus(
+	const Automate * automate_1, const Automate * automate_2, char ** temoin
+){
+	Donnees_inclusion d;
+	d.a = figer_automate( automate_1 );
+	d.b = figer_automate( automate_2 );
+	d.w = d.b->nb_mots;
+	int n = d.a->nb_etats;
+	int i, p;
+
+	d.capacite_couples = 64;
+	d.nb_couples = 0;
+	d.couples = xmalloc( d.capacite_couples * sizeof(Couple_inclusion) );
+	d.capacite_ensembles = 64 * d.w + 1;
+	d.ensembles = xmalloc( d.capacite_ensembles * sizeof(uint64_t) );
+	d.antichaines = xmalloc( ( n + 1 ) * sizeof(int*) );
+	d.nb_antichaines = xmalloc( ( n + 1 ) * sizeof(int) );
+	d.capacite_antichaines = xmalloc( ( n + 1 ) * sizeof(int) );
+	for( p = 0; p < n; p++ ){
+		d.antichaines[p] = NULL;
+		d.nb_antichaines[p] = 0;
+		d.capacite_antichaines[p] = 0;
+	}
+	uint64_t * suivant = xmalloc( ( d.w + 1 ) * sizeof(uint64_t) );
+
+	int fautif = -1;
+	for( p = 0; p < n && fautif < 0; p++ ){
+		if( ! BITSET_TEST( d.a->initiaux, p ) ) continue;
+		int id = ajouter_couple_inclusion( &d, p, d.b->initiaux, -1, 0 );
+		if( id >= 0 && couple_fautif( &d, id ) ) fautif = id;
+	}
+
+	// Parcours en largeur ; les couples dominés entre-temps ne sont pas
+	// développés
+	for( i = 0; i < d.nb_couples && fautif < 0; i++ ){
+		if( d.couples[i].domine ) continue;
+		int q = d.couples[i].p;
+		int e, k;
+		for( e = d.a->debut[q]; e < d.a->debut[q+1] && fautif < 0; e++ ){
+			char lettre = d.a->lettre[e];
+			// Calculé avant les ajouts, qui peuvent déplacer d.ensembles
+			delta_fige( d.b, d.ensembles + d.couples[i].ensemble, lettre, suivant );
+			for( k = d.a->debut_fins[e]; k < d.a->debut_fins[e+1] && fautif < 0; k++ ){
+				int id = ajouter_couple_inclusion(
+					&d, d.a->fins[k], suivant, i, lettre
+				);
+				if( id >= 0 && couple_fautif( &d, id ) ) fautif = id;
+			}
+		}
+	}
+
+	if( fautif >= 0 && temoin ){
+		*temoin = reconstruire_temoin( d.couples, fautif );
+	}
+
+	for( p = 0; p < n; p++ ) xfree( d.antichaines[p] );
+	xfree( d.antichaines );
+	xfree( d.nb_antichaines );
+	xfree( d.capacite_antichaines );
+	xfree( d.couples );
+	xfree( d.ensembles );
+	xfree( suivant );
+	liberer_automate_fige( d.a );
+	liberer_automate_fige( d.b );
+	return fautif < 0;
+}
+
+int automate_est_universel( const Automate * automate, char ** temoin ){
+	Automate * tous_les_mots = creer_automate();
+	ajouter_etat_initial( tous_les_mots, 0 );
+	ajouter_etat_final( tous_les_mots, 0 );
+	Ensemble_iterateur it;
+	for(
+		it = premier_iterateur_ensemble( get_alphabet( automate ) );
+		! iterateur_ensemble_est_vide( it );
+		it = iterateur_suivant_ensemble( it )
+	){
+		ajouter_transition( tous_les_mots, 0, (char) get_element( it ), 0 );
+	}
+	int res = automate_est_inclus( tous_les_mots, automate, temoin );
+	liberer_automate( tous_les_mots );
+	return res;
+}
@@ -0,0 +1,64 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file inclusion.h */
+
+#ifndef __INCLUSION_H__
+#define __INCLUSION_H__
+
+#include "automate.h"
+
+/**
+ * @brief Renvoie 1 si le langage de 'automate_1' est inclus dans celui de
+ *        'automate_2', et 0 sinon.
+ *
+ * Aucun des deux automates n'est déterminisé. On parcourt en largeur les
+ * couples (p, S) où p est un état de 'automate_1' et S l'ensemble des états
+ * de 'automate_2' atteints par un même mot ; l'inclusion est fausse dès
+ * qu'un couple a p final et aucun état final dans S. Un couple (p, S) est
+ * ignoré si un couple (p, S') avec S' inclus dans S a déjà été atteint :
+ * tout mot qui mène de (p, S) à un couple fautif y mène aussi depuis
+ * (p, S'). Les couples gardés forment ainsi, pour chaque p, une antichaîne.
+ *
+ * Si l'inclusion est fausse et que 'temoin' n'est pas NULL, '*temoin' reçoit
+ * un mot reconnu par 'automate_1' et pas par 'automate_2', alloué avec
+ * xmalloc() et terminé par '\0'. Sinon, '*temoin' n'est pas modifié.
+ *
+ * @param automate_1 Un automate.
+ * @param automate_2 Un automate.
+ * @param temoin L'adresse où écrire le témoin, ou NULL.
+ */
+int automate_est_inclus(
+	const Automate * automate_1, const Automate * automate_2, char ** temoin
+);
+
+/**
+ * @brief Renvoie 1 si l'automate reconnaît tous les mots écrits sur son
+ *        alphabet, et 0 sinon.
+ *
+ * C'est l'inclusion dans l'automate du langage de l'automate à un état qui
+ * reconnaît tous les mots sur l'alphabet (voir automate_est_inclus()). Si
+ * l'automate n'est pas universel et que 'temoin' n'est pas NULL, '*temoin'
+ * reçoit un mot de l'alphabet qui n'est pas reconnu.
+ *
+ * @param automate Un automate.
+ * @param temoin L'adresse où écrire le témoin, ou NULL.
+ */
+int automate_est_universel( const Automate * automate, char ** temoin );
+
+#endif
@@ -0,0 +1,111 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "lecteur.h"
+#include "bitset.h"
+#include "outils.h"
+
+#include <string.h>
+
+Lecteur * creer_lecteur( const Automate * automate ){
+	Lecteur * lecteur = xmalloc( sizeof(Lecteur) );
+	lecteur->afd = creer_afd( automate );
+	lecteur->fige = NULL;
+	lecteur->courant = NULL;
+	lecteur->tampon = NULL;
+	if( ! lecteur->afd ){
+		lecteur->fige = figer_automate( automate );
+		size_t w = lecteur->fige->nb_mots + 1;
+		lecteur->courant = xmalloc( w * sizeof(uint64_t) );
+		lecteur->tampon = xmalloc( w * sizeof(uint64_t) );
+	}
+	lecteur->nb_references = xmalloc( sizeof(int) );
+	*lecteur->nb_references = 1;
+	remettre_a_zero_lecteur( lecteur );
+	return lecteur;
+}
+
+Lecteur * copier_lecteur( const Lecteur * lecteur ){
+	Lecteur * copie = xmalloc( sizeof(Lecteur) );
+	*copie = *lecteur;
+	( *copie->nb_references )++;
+	if( lecteur->fige ){
+		size_t w = lecteur->fige->nb_mots + 1;
+		copie->courant = xmalloc( w * sizeof(uint64_t) );
+		copie->tampon = xmalloc( w * sizeof(uint64_t) );
+		memcpy( copie->courant, lecteur->courant, w * sizeof(uint64_t) );
+	}
+	return copie;
+}
+
+void liberer_lecteur( Lecteur * lecteur ){
+	if( --( *lecteur->nb_references ) == 0 ){
+		if( lecteur->afd ) liberer_afd( lecteur->afd );
+		if( lecteur->fige ) liberer_automate_fige( lecteur->fige );
+		xfree( lecteur->nb_references );
+	}
+	xfree( lecteur->courant );
+	xfree( lecteur->tampon );
+	xfree( lecteur );
+}
+
+void remettre_a_zero_lecteur( Lecteur * lecteur ){
+	lecteur->nb_octets = 0;
+	if( lecteur->afd ){
+		lecteur->etat = lecteur->afd->initial;
+	}else{
+		lecteur->etat = 0;
+		memcpy(
+			lecteur->courant, lecteur->fige->initiaux,
+			lecteur->fige->nb_mots * sizeof(uint64_t)
+		);
+	}
+}
+
+void lecteur_lire( Lecteur * lecteur, const char * morceau, size_t longueur ){
+	lecteur->nb_octets += longueur;
+	if( lecteur->afd ){
+		lecteur->etat = afd_lire_depuis(
+			lecteur->afd, lecteur->etat, morceau, longueur
+		);
+		return;
+	}
+	const Automate_fige * fige = lecteur->fige;
+	size_t i;
+	for( i = 0; i < longueur; i++ ){
+		if( bitset_est_vide( lecteur->courant, fige->nb_mots ) ) return;
+		delta_fige( fige, lecteur->courant, morceau[i], lecteur->tampon );
+		uint64_t * echange = lecteur->courant;
+		lecteur->courant = lecteur->tampon;
+		lecteur->tampon = echange;
+	}
+}
+
+int lecteur_accepte( const Lecteur * lecteur ){
+	if( lecteur->afd ) return afd_est_final( lecteur->afd, lecteur->etat );
+	size_t i;
+	for( i = 0; i < lecteur->fige->nb_mots; i++ ){
+		if( lecteur->courant[i] & lecteur->fige->finaux[i] ) return 1;
+	}
+	return 0;
+}
+
+int lecteur_est_bloque( const Lecteur * lecteur ){
+	if( lecteur->afd ) return lecteur->etat == AFD_MORT;
+	return bitset_est_vide( lecteur->courant, lecteur->fige->nb_mots );
+}
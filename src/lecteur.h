@@ -0,0 +1,120 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file lecteur.h */
+
+#ifndef __LECTEUR_H__
+#define __LECTEUR_H__
+
+#include "automate.h"
+#include "afd.h"
+#include "automate_fige.h"
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief Le type d'un lecteur, qui lit un mot morceau par morceau.
+ *
+ * Un lecteur garde l'état atteint par les octets déjà lus : on peut lui
+ * donner le mot par morceaux de longueur quelconque (qui peuvent contenir
+ * des '\0'), et lui demander à tout moment si le mot lu jusque-là est
+ * reconnu. La mémoire utilisée ne dépend pas de la longueur du mot.
+ *
+ * Si l'automate est déterministe, le lecteur utilise un Afd et l'état
+ * courant est un seul entier ; sinon, il utilise un automate figé et l'état
+ * courant est un ensemble d'états (voir automate_fige.h).
+ *
+ * L'Afd ou l'automate figé est partagé par un lecteur et ses copies, et
+ * libéré avec le dernier d'entre eux. Un lecteur et ses copies ne doivent
+ * pas être créés ou libérés par plusieurs fils d'exécution à la fois.
+ */
+typedef struct Lecteur {
+	Afd * afd;					//!< NULL si l'automate n'est pas déterministe
+	Automate_fige * fige;		//!< NULL si l'automate est déterministe
+	int * nb_references;
+	int32_t etat;
+	uint64_t * courant;
+	uint64_t * tampon;
+	uint64_t nb_octets;			//!< octets lus depuis la remise à zéro
+} Lecteur;
+
+/**
+ * @brief Crée un lecteur placé au début d'un mot.
+ *
+ * Le lecteur ne dépend pas de l'automate passé en paramètre, qui peut
+ * ensuite être modifié ou libéré.
+ *
+ * @param automate Un automate, déterministe ou non.
+ * @return Le lecteur.
+ */
+Lecteur * creer_lecteur( const Automate * automate );
+
+/**
+ * @brief Crée une copie d'un lecteur, placée au même endroit du mot.
+ *
+ * La copie et le lecteur avancent ensuite indépendamment.
+ *
+ * @param lecteur Un lecteur.
+ * @return La copie.
+ */
+Lecteur * copier_lecteur( const Lecteur * lecteur );
+
+/**
+ * @brief Libère la mémoire d'un lecteur.
+ *
+ * @param lecteur Un lecteur.
+ */
+void liberer_lecteur( Lecteur * lecteur );
+
+/**
+ * @brief Replace le lecteur au début d'un mot.
+ *
+ * @param lecteur Un lecteur.
+ */
+void remettre_a_zero_lecteur( Lecteur * lecteur );
+
+/**
+ * @brief Lit les 'longueur' premiers octets de 'morceau', à la suite des
+ *        octets déjà lus.
+ *
+ * La fonction n'alloue pas de mémoire.
+ *
+ * @param lecteur Un lecteur.
+ * @param morceau Un tableau d'octets.
+ * @param longueur Le nombre d'octets à lire.
+ */
+void lecteur_lire( Lecteur * lecteur, const char * morceau, size_t longueur );
+
+/**
+ * @brief Renvoie 1 si le mot lu depuis la remise à zéro est reconnu, et 0
+ *        sinon.
+ *
+ * @param lecteur Un lecteur.
+ */
+int lecteur_accepte( const Lecteur * lecteur );
+
+/**
+ * @brief Renvoie 1 si aucun mot ne peut plus être reconnu, quels que soient
+ *        les octets lus ensuite, et 0 si on ne le sait pas.
+ *
+ * @param lecteur Un lecteur.
+ */
+int lecteur_est_bloque( const Lecteur * lecteur );
+
+#endif
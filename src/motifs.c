@@ -0,0 +1,313 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "motifs.h"
+#include "afd_paresseux.h"
+#include "bitset.h"
+#include "outils.h"
+#include "rationnel.h"
+#include "sous_ensembles.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+	Automate * union_automates;
+	int decalage;				// premier état libre de l'union
+	int * motif;				// motif de chaque état de l'union
+} Union_motifs;
+
+void action_copier_transition_motif( int origine, char lettre, int fin, void* data ){
+	void ** d = (void**) data;
+	Union_motifs * u = (Union_motifs*) d[0];
+	int decalage = *(int*) d[1];
+	ajouter_transition( u->union_automates, origine + decalage, lettre, fin + decalage );
+}
+
+/*
+ * Ajoute à l'union une copie de l'automate dont les états sont décalés
+ * après ceux des automates déjà ajoutés.
+ */
+void ajouter_automate_motif( Union_motifs * u, const Automate * automate, int motif ){
+	if( taille_ensemble( get_etats( automate ) ) == 0 ) return;
+	int decalage = u->decalage - get_min_etat( automate );
+	int taille = get_max_etat( automate ) - get_min_etat( automate ) + 1;
+	u->motif = xrealloc( u->motif, ( u->decalage + taille ) * sizeof(int) );
+	int i;
+	for( i = 0; i < taille; i++ ) u->motif[ u->decalage + i ] = motif;
+	u->decalage += taille;
+
+	Ensemble_iterateur it;
+	for(
+		it = premier_iterateur_ensemble( get_etats( automate ) );
+		! iterateur_ensemble_est_vide( it );
+		it = iterateur_suivant_ensemble( it )
+	){
+		ajouter_etat( u->union_automates, get_element( it ) + decalage );
+	}
+	for(
+		it = premier_iterateur_ensemble( get_initiaux( automate ) );
+		! iterateur_ensemble_est_vide( it );
+		it = iterateur_suivant_ensemble( it )
+	){
+		ajouter_etat_initial( u->union_automates, get_element( it ) + decalage );
+	}
+	for(
+		it = premier_iterateur_ensemble( get_finaux( automate ) );
+		! iterateur_ensemble_est_vide( it );
+		it = iterateur_suivant_ensemble( it )
+	){
+		ajouter_etat_final( u->union_automates, get_element( it ) + decalage );
+	}
+	void * data[2] = { u, &decalage };
+	pour_toute_transition( automate, action_copier_transition_motif, data );
+}
+
+int comparer_motifs( const void * a, const void * b ){
+	int x = *(const int*) a, y = *(const int*) b;
+	return ( x > y ) - ( x < y );
+}
+
+/*
+ * Interne, dans 'etiquettes', l'ensemble des motifs des états finaux de
+ * l'ensemble d'états 'ensemble' de l'automate figé de l'union.
+ */
+int etiquette_motifs(
+	Table_sous_ensembles * etiquettes, const Automate_fige * fige,
+	const int * motif, const uint64_t * ensemble, int * vu, int * liste
+){
+	int nb = 0;
+	size_t i;
+	for( i = 0; i < fige->nb_mots; i++ ){
+		uint64_t mot = ensemble[i] & fige->finaux[i];
+		while( mot ){
+			int q = (int) ( i * BITSET_BITS ) + __builtin_ctzll( mot );
+			mot &= mot - 1;
+			int m = motif[ fige->etats[q] ];
+			if( ! vu[m] ){
+				vu[m] = 1;
+				liste[ nb++ ] = m;
+			}
+		}
+	}
+	for( i = 0; i < (size_t) nb; i++ ) vu[ liste[i] ] = 0;
+	qsort( liste, nb, sizeof(int), comparer_motifs );
+	int nouveau;
+	return interner_sous_ensemble( etiquettes, liste, nb, &nouveau );
+}
+
+Jeu_de_motifs * creer_jeu_de_motifs(
+	Automate * const * automates, int nb_motifs
+){
+	int i, c, q;
+	Union_motifs u;
+	u.union_automates = creer_automate();
+	u.decalage = 0;
+	u.motif = xmalloc( sizeof(int) );
+	for( i = 0; i < nb_motifs; i++ ){
+		ajouter_automate_motif( &u, automates[i], i );
+	}
+
+	// Déterminisation de l'union : tous les ensembles accessibles sont
+	// construits par l'Afd paresseux, qui n'est jamais vidé.
+	Afd_paresseux * afd = creer_afd_paresseux( u.union_automates, SIZE_MAX );
+	liberer_automate( u.union_automates );
+	int m = afd->nb_classes;
+	int capacite = 16;
+	int * table = xmalloc( capacite * m * sizeof(int) );
+	for( q = 0; q < afd->nb_etats; q++ ){
+		if( q == capacite ){
+			capacite *= 2;
+			table = xrealloc( table, (size_t) capacite * m * sizeof(int) );
+		}
+		table[ q*m ] = -1;
+		for( c = 1; c < m; c++ ){
+			table[ q*m + c ] = afd_paresseux_suivant( afd, q, afd->representant[c] );
+		}
+	}
+
+	// Les octets de la classe 0 mènent à un état puits ajouté, de
+	// numéro N-1
+	int N = afd->nb_etats + 1;
+	if( N > capacite ) table = xrealloc( table, (size_t) N * m * sizeof(int) );
+	for( c = 0; c < m; c++ ) table[ (N-1)*m + c ] = N-1;
+	for( q = 0; q < N-1; q++ ) table[ q*m ] = N-1;
+
+	// Étiquettes : ensembles de motifs, internés
+	const Automate_fige * fige = afd->fige;
+	Table_sous_ensembles * etiquettes = creer_table_sous_ensembles();
+	int * etiquette = xmalloc( N * sizeof(int) );
+	int * vu = xmalloc( ( nb_motifs + 1 ) * sizeof(int) );
+	int * liste = xmalloc( ( nb_motifs + 1 ) * sizeof(int) );
+	uint64_t * ensemble = xmalloc( ( fige->nb_mots + 1 ) * sizeof(uint64_t) );
+	memset( ensemble, 0, ( fige->nb_mots + 1 ) * sizeof(uint64_t) );
+	for( i = 0; i < nb_motifs; i++ ) vu[i] = 0;
+	for( q = 0; q < N; q++ ){
+		if( q < N-1 ){
+			int taille;
+			memcpy(
+				ensemble, get_sous_ensemble( afd->ensembles, q, &taille ),
+				fige->nb_mots * sizeof(uint64_t)
+			);
+		}else{
+			memset( ensemble, 0, fige->nb_mots * sizeof(uint64_t) );
+		}
+		etiquette[q] = etiquette_motifs(
+			etiquettes, fige, u.motif, ensemble, vu, liste
+		);
+	}
+	xfree( ensemble );
+	xfree( liste );
+	xfree( vu );
+	xfree( u.motif );
+
+	// Minimisation : deux états sont fusionnés si tout mot les mène à des
+	// états de mêmes motifs
+	int * bloc = xmalloc( N * sizeof(int) );
+	int nb_blocs = raffiner_partition_hopcroft(
+		table, N, m, etiquette, nombre_de_sous_ensembles( etiquettes ), bloc
+	);
+	int * representant = xmalloc( nb_blocs * sizeof(int) );
+	for( i = 0; i < nb_blocs; i++ ) representant[i] = -1;
+	for( q = 0; q < N; q++ ){
+		if( representant[ bloc[q] ] == -1 ) representant[ bloc[q] ] = q;
+	}
+
+	// Numérotation des blocs : le bloc du puits est l'état mort, puis les
+	// autres blocs dans l'ordre d'un parcours en largeur depuis le bloc
+	// initial.
+	int * numero = xmalloc( nb_blocs * sizeof(int) );
+	int * file = xmalloc( nb_blocs * sizeof(int) );
+	for( i = 0; i < nb_blocs; i++ ) numero[i] = -1;
+	int nb_numeros = 0;
+	numero[ bloc[N-1] ] = nb_numeros;
+	file[ nb_numeros++ ] = bloc[N-1];
+	if( numero[ bloc[ afd->initial ] ] == -1 ){
+		numero[ bloc[ afd->initial ] ] = nb_numeros;
+		file[ nb_numeros++ ] = bloc[ afd->initial ];
+	}
+	int tete;
+	for( tete = 0; tete < nb_numeros; tete++ ){
+		int r = representant[ file[tete] ];
+		for( c = 0; c < m; c++ ){
+			int b = bloc[ table[ r*m + c ] ];
+			if( numero[b] == -1 ){
+				numero[b] = nb_numeros;
+				file[ nb_numeros++ ] = b;
+			}
+		}
+	}
+
+	Jeu_de_motifs * jeu = xmalloc( sizeof(Jeu_de_motifs) );
+	jeu->nb_motifs = nb_motifs;
+	jeu->nb_etats = nb_numeros;
+	jeu->nb_classes = m;
+	for( i = 0; i < 256; i++ ) jeu->classe[i] = afd->classe[i];
+	jeu->initial = numero[ bloc[ afd->initial ] ];
+
+	size_t taille = (size_t) nb_numeros * m;
+	// Les débuts de ligne sont codés par des int32_t
+	if( taille > INT32_MAX ) ERREUR( "Jeu de motifs trop grand" );
+	jeu->suivant = xmalloc( taille * sizeof(int32_t) );
+	jeu->debut_motifs = xmalloc( ( nb_numeros + 1 ) * sizeof(int) );
+	jeu->debut_motifs[0] = 0;
+	for( tete = 0; tete < nb_numeros; tete++ ){
+		int r = representant[ file[tete] ];
+		for( c = 0; c < m; c++ ){
+			jeu->suivant[ (size_t) tete * m + c ] =
+				numero[ bloc[ table[ r*m + c ] ] ] * m;
+		}
+		int nb;
+		get_sous_ensemble( etiquettes, etiquette[r], &nb );
+		jeu->debut_motifs[ tete + 1 ] = jeu->debut_motifs[ tete ] + nb;
+	}
+	jeu->motifs = xmalloc( ( jeu->debut_motifs[ nb_numeros ] + 1 ) * sizeof(int) );
+	for( tete = 0; tete < nb_numeros; tete++ ){
+		int nb;
+		const int * motifs = get_sous_ensemble(
+			etiquettes, etiquette[ representant[ file[tete] ] ], &nb
+		);
+		memcpy(
+			jeu->motifs + jeu->debut_motifs[ tete ], motifs, nb * sizeof(int)
+		);
+	}
+
+	xfree( numero );
+	xfree( file );
+	xfree( representant );
+	xfree( bloc );
+	xfree( etiquette );
+	xfree( table );
+	liberer_table_sous_ensembles( etiquettes );
+	liberer_afd_paresseux( afd );
+	return jeu;
+}
+
+Jeu_de_motifs * compiler_motifs( const char * const * expressions, int nb_motifs ){
+	Automate ** automates = xmalloc( ( nb_motifs + 1 ) * sizeof(Automate*) );
+	int i, j;
+	for( i = 0; i < nb_motifs; i++ ){
+		Rationnel * rat = expression_to_rationnel( expressions[i] );
+		if( ! rat ){
+			for( j = 0; j < i; j++ ) liberer_automate( automates[j] );
+			xfree( automates );
+			return NULL;
+		}
+		numeroter_rationnel( rat );
+		automates[i] = Glushkov( rat );
+	}
+	Jeu_de_motifs * jeu = creer_jeu_de_motifs( automates, nb_motifs );
+	for( i = 0; i < nb_motifs; i++ ) liberer_automate( automates[i] );
+	xfree( automates );
+	return jeu;
+}
+
+void liberer_jeu_de_motifs( Jeu_de_motifs * jeu ){
+	xfree( jeu->suivant );
+	xfree( jeu->debut_motifs );
+	xfree( jeu->motifs );
+	xfree( jeu );
+}
+
+const int * motifs_reconnus_tampon(
+	const Jeu_de_motifs * jeu, const char * mot, size_t longueur,
+	int * nb_motifs
+){
+	const int32_t * suivant = jeu->suivant;
+	const uint16_t * classe = jeu->classe;
+	const unsigned char * p = (const unsigned char *) mot;
+	const unsigned char * fin = p + longueur;
+	int32_t ligne = jeu->initial * jeu->nb_classes;
+	while( p < fin && ligne != MOTIFS_MORT ){
+		ligne = suivant[ ligne + classe[ *p++ ] ];
+	}
+	return motifs_de_l_etat( jeu, ligne / jeu->nb_classes, nb_motifs );
+}
+
+const int * motifs_reconnus(
+	const Jeu_de_motifs * jeu, const char * mot, int * nb_motifs
+){
+	const int32_t * suivant = jeu->suivant;
+	const uint16_t * classe = jeu->classe;
+	const unsigned char * p = (const unsigned char *) mot;
+	int32_t ligne = jeu->initial * jeu->nb_classes;
+	while( *p && ligne != MOTIFS_MORT ){
+		ligne = suivant[ ligne + classe[ *p++ ] ];
+	}
+	return motifs_de_l_etat( jeu, ligne / jeu->nb_classes, nb_motifs );
+}
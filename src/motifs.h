@@ -0,0 +1,166 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file motifs.h */
+
+#ifndef __MOTIFS_H__
+#define __MOTIFS_H__
+
+#include "automate.h"
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief Numéro de l'état mort d'un Jeu_de_motifs.
+ *
+ * Depuis l'état mort, aucun mot ne mène à un état étiqueté : une fois
+ * atteint, on peut arrêter la lecture du mot.
+ */
+#define MOTIFS_MORT 0
+
+/**
+ * @brief Le type d'un jeu de motifs compilé.
+ *
+ * Un jeu de motifs est un automate déterministe minimal, rangé dans une table
+ * dense comme un Afd (voir afd.h), dont chaque état est étiqueté par
+ * l'ensemble des motifs qui reconnaissent les mots menant à cet état. Les
+ * motifs sont numérotés de 0 à nb_motifs-1 ; les motifs de l'état q sont
+ * motifs[ debut_motifs[q] ] ... motifs[ debut_motifs[q+1]-1 ], dans l'ordre
+ * croissant.
+ *
+ * Comme pour un Afd, la table 'suivant' contient des débuts de ligne : si la
+ * transition de l'état q par un octet de classe c mène à l'état r, alors
+ *     suivant[ q * nb_classes + c ] == r * nb_classes,
+ * et la classe 0 regroupe les octets qui ne sont dans l'alphabet d'aucun
+ * motif. La lecture d'un mot coûte une transition par octet, quel que soit
+ * le nombre de motifs.
+ *
+ * Un jeu de motifs n'est jamais modifié après sa création : il peut être lu
+ * par plusieurs fils d'exécution à la fois.
+ */
+typedef struct Jeu_de_motifs {
+	int nb_motifs;
+	int nb_etats;
+	int nb_classes;
+	int32_t * suivant;
+	uint16_t classe[256];
+	int32_t initial;
+	int * debut_motifs;
+	int * motifs;
+} Jeu_de_motifs;
+
+/**
+ * @brief Compile un jeu de motifs à partir d'automates.
+ *
+ * Le motif i est le langage de automates[i]. On construit l'union des
+ * automates en étiquetant chaque état final par le numéro de son automate,
+ * on la déterminise, puis on la minimise en ne fusionnant que des états
+ * dont les futurs mènent aux mêmes ensembles de motifs.
+ *
+ * @param automates Un tableau de nb_motifs automates, déterministes ou non.
+ * @param nb_motifs Le nombre de motifs.
+ * @return Le jeu de motifs.
+ */
+Jeu_de_motifs * creer_jeu_de_motifs(
+	Automate * const * automates, int nb_motifs
+);
+
+/**
+ * @brief Compile un jeu de motifs à partir d'expressions rationnelles.
+ *
+ * Chaque expression (voir expression_to_rationnel()) est traduite par
+ * l'automate de Glushkov, puis les automates sont compilés par
+ * creer_jeu_de_motifs().
+ *
+ * @param expressions Un tableau de nb_motifs expressions rationnelles.
+ * @param nb_motifs Le nombre de motifs.
+ * @return Le jeu de motifs, ou NULL si une expression est mal formée.
+ */
+Jeu_de_motifs * compiler_motifs( const char * const * expressions, int nb_motifs );
+
+/**
+ * @brief Libère la mémoire d'un jeu de motifs.
+ *
+ * @param jeu Un jeu de motifs.
+ */
+void liberer_jeu_de_motifs( Jeu_de_motifs * jeu );
+
+/**
+ * @brief Renvoie l'état atteint depuis 'etat' en lisant 'lettre'.
+ *
+ * @param jeu Un jeu de motifs.
+ * @param etat Un état du jeu de motifs.
+ * @param lettre Une lettre.
+ */
+static inline int32_t motifs_suivant(
+	const Jeu_de_motifs * jeu, int32_t etat, char lettre
+){
+	return jeu->suivant[
+		(size_t) etat * jeu->nb_classes + jeu->classe[ (unsigned char) lettre ]
+	] / jeu->nb_classes;
+}
+
+/**
+ * @brief Renvoie les motifs d'un état, dans l'ordre croissant.
+ *
+ * @param jeu Un jeu de motifs.
+ * @param etat Un état du jeu de motifs.
+ * @param nb_motifs L'adresse où écrire le nombre de motifs.
+ * @return Un tableau de '*nb_motifs' numéros de motifs, qui appartient au
+ *         jeu de motifs.
+ */
+static inline const int * motifs_de_l_etat(
+	const Jeu_de_motifs * jeu, int32_t etat, int * nb_motifs
+){
+	*nb_motifs = jeu->debut_motifs[ etat + 1 ] - jeu->debut_motifs[ etat ];
+	return jeu->motifs + jeu->debut_motifs[ etat ];
+}
+
+/**
+ * @brief Renvoie les motifs qui reconnaissent le mot (terminé par '\0').
+ *
+ * Le mot est lu une seule fois.
+ *
+ * @param jeu Un jeu de motifs.
+ * @param mot Un mot.
+ * @param nb_motifs L'adresse où écrire le nombre de motifs.
+ * @return Un tableau de '*nb_motifs' numéros de motifs, dans l'ordre
+ *         croissant, qui appartient au jeu de motifs.
+ */
+const int * motifs_reconnus(
+	const Jeu_de_motifs * jeu, const char * mot, int * nb_motifs
+);
+
+/**
+ * @brief Renvoie les motifs qui reconnaissent le mot formé des 'longueur'
+ *        premiers octets de 'mot'.
+ *
+ * @param jeu Un jeu de motifs.
+ * @param mot Un tableau d'octets.
+ * @param longueur Le nombre d'octets du mot.
+ * @param nb_motifs L'adresse où écrire le nombre de motifs.
+ * @return Un tableau de '*nb_motifs' numéros de motifs, dans l'ordre
+ *         croissant, qui appartient au jeu de motifs.
+ */
+const int * motifs_reconnus_tampon(
+	const Jeu_de_motifs * jeu, const char * mot, size_t longueur,
+	int * nb_motifs
+);
+
+#endif
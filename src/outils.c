@@ -39,6 +39,25 @@ void* xmalloc( size_t n ){
 	return result;
 }
 
+void* xrealloc( void* ptr, size_t n ){
+	void* result = realloc( ptr, n );
+	if( ! result ){
+		ERREUR( "Espace insuffisant" );
+	}
+	return result;
+}
+
 void xfree( void* ptr ){
 	free(ptr);
 }
+
+int indice_dans_tableau( const int* tab, int n, int valeur ){
+	int debut = 0, fin = n-1;
+	while( debut <= fin ){
+		int milieu = debut + ( fin - debut ) / 2;
+		if( tab[milieu] == valeur ) return milieu;
+		if( tab[milieu] < valeur ) debut = milieu + 1;
+		else fin = milieu - 1;
+	}
+	return -1;
+}
@@ -31,6 +31,7 @@
 #define ERREUR(x) do { fprintf(stderr,"ERREUR : %s - ligne : %d, fichier : %s\n", (x), __LINE__, __FILE__ ); exit(EXIT_FAILURE); } while(0)
 
 void* xmalloc( size_t n );
+void* xrealloc( void* ptr, size_t n );
 void xfree( void* ptr );
 
 #define TEST(y,x) do { x &= (y); if(!(y)){ fprintf(stdout, "\033[31mEchec du test %s() -- ligne : %d, fichier : %s\033[0m\n", __FUNCTION__, __LINE__, __FILE__ ); } } while(0)
@@ -41,5 +42,11 @@ void xfree( void* ptr );
 
 int test( int result, int ligne );
 
+/*
+ * Renvoie l'indice de 'valeur' dans le tableau trié 'tab' de taille 'n',
+ * ou -1 si la valeur n'est pas dans le tableau.
+ */
+int indice_dans_tableau( const int* tab, int n, int valeur );
+
 #endif
 
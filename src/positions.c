@@ -0,0 +1,243 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "positions.h"
+#include "bitset.h"
+#include "outils.h"
+
+#include <string.h>
+
+/*
+ * Taille maximale, en mots, des tables de successeurs par blocs. Au-delà, on
+ * calcule les successeurs état par état.
+ */
+#define TAILLE_MAX_SUIVANTS ( (size_t) 1 << 21 )
+
+/*
+ * Au-delà de cette taille (en mots), les tampons de la simulation sont
+ * alloués sur le tas.
+ */
+#define TAMPON_PILE_POSITIONS 64
+
+typedef struct {
+	Automate_positions * res;
+	int * lettre_entrante;		// -1 si aucune transition n'arrive dans l'état
+	int homogene;
+} Donnees_positions;
+
+int numero_position( const Automate_positions * automate, int etat ){
+	return indice_dans_tableau( automate->etats, automate->nb_etats, etat );
+}
+
+void action_remplir_positions( int origine, char lettre, int fin, void* data ){
+	Donnees_positions * d = (Donnees_positions*) data;
+	Automate_positions * res = d->res;
+	int q = numero_position( res, origine );
+	int r = numero_position( res, fin );
+	int l = (unsigned char) lettre;
+	if( d->lettre_entrante[r] >= 0 && d->lettre_entrante[r] != l ){
+		d->homogene = 0;
+		return;
+	}
+	d->lettre_entrante[r] = l;
+	BITSET_AJOUTER( res->lignes + (size_t) q * res->nb_mots, r );
+	BITSET_AJOUTER( res->masques + (size_t) l * res->nb_mots, r );
+}
+
+uint64_t * creer_bitset_positions( size_t nb_mots ){
+	uint64_t * res = xmalloc( ( nb_mots + 1 ) * sizeof(uint64_t) );
+	memset( res, 0, ( nb_mots + 1 ) * sizeof(uint64_t) );
+	return res;
+}
+
+/*
+ * Remplit les tables de successeurs par blocs de 8 bits :
+ * pour une valeur v non nulle, suivants(bloc, v) = suivants(bloc, v sans son
+ * plus petit bit) | lignes[ 8 * bloc + plus petit bit de v ].
+ */
+void remplir_suivants_par_blocs( Automate_positions * a ){
+	size_t w = a->nb_mots;
+	int bloc, v;
+	for( bloc = 0; bloc < a->nb_blocs; bloc++ ){
+		uint64_t * table = a->suivants + (size_t) bloc * 256 * w;
+		memset( table, 0, w * sizeof(uint64_t) );
+		for( v = 1; v < 256; v++ ){
+			int q = 8 * bloc + __builtin_ctz( v );
+			uint64_t * entree = table + (size_t) v * w;
+			memcpy( entree, table + (size_t) ( v & ( v - 1 ) ) * w, w * sizeof(uint64_t) );
+			if( q < a->nb_etats ){
+				bitset_union( entree, a->lignes + (size_t) q * w, w );
+			}
+		}
+	}
+}
+
+Automate_positions * creer_automate_positions( const Automate * automate ){
+	Automate_positions * res = xmalloc( sizeof(Automate_positions) );
+	Ensemble_iterateur it;
+	int i;
+
+	res->etats = ensemble_vers_tableau( get_etats( automate ), &res->nb_etats );
+	int n = res->nb_etats;
+	size_t w = BITSET_NB_MOTS( n );
+	if( w == 0 ) w = 1;
+	res->nb_mots = w;
+	res->nb_blocs = ( n + 7 ) / 8;
+	res->masques = creer_bitset_positions( 256 * w );
+	res->lignes = creer_bitset_positions( (size_t) n * w );
+	res->initiaux = creer_bitset_positions( w );
+	res->finaux = creer_bitset_positions( w );
+	res->suivants = NULL;
+
+	Donnees_positions d;
+	d.res = res;
+	d.homogene = 1;
+	d.lettre_entrante = xmalloc( ( n + 1 ) * sizeof(int) );
+	for( i = 0; i < n; i++ ) d.lettre_entrante[i] = -1;
+	pour_toute_transition( automate, action_remplir_positions, &d );
+	xfree( d.lettre_entrante );
+	if( ! d.homogene ){
+		liberer_automate_positions( res );
+		return NULL;
+	}
+
+	for(
+		it = premier_iterateur_ensemble( get_initiaux( automate ) );
+		! iterateur_ensemble_est_vide( it );
+		it = iterateur_suivant_ensemble( it )
+	){
+		BITSET_AJOUTER( res->initiaux, numero_position( res, get_element( it ) ) );
+	}
+	for(
+		it = premier_iterateur_ensemble( get_finaux( automate ) );
+		! iterateur_ensemble_est_vide( it );
+		it = iterateur_suivant_ensemble( it )
+	){
+		BITSET_AJOUTER( res->finaux, numero_position( res, get_element( it ) ) );
+	}
+
+	if( (size_t) res->nb_blocs * 256 * w <= TAILLE_MAX_SUIVANTS ){
+		res->suivants = creer_bitset_positions( (size_t) res->nb_blocs * 256 * w );
+		remplir_suivants_par_blocs( res );
+	}
+	return res;
+}
+
+void liberer_automate_positions( Automate_positions * automate ){
+	xfree( automate->etats );
+	xfree( automate->masques );
+	xfree( automate->lignes );
+	xfree( automate->suivants );
+	xfree( automate->initiaux );
+	xfree( automate->finaux );
+	xfree( automate );
+}
+
+/*
+ * Cas d'un seul mot de 64 bits : l'ensemble des états actifs reste dans un
+ * registre.
+ */
+int reconnaitre_un_mot(
+	const Automate_positions * a, const unsigned char * p,
+	const unsigned char * fin
+){
+	const uint64_t * suivants = a->suivants;
+	const uint64_t * masques = a->masques;
+	int nb_blocs = a->nb_blocs;
+	uint64_t actifs = a->initiaux[0];
+	int bloc;
+	for( ; p < fin && actifs; p++ ){
+		uint64_t s = 0;
+		for( bloc = 0; bloc < nb_blocs; bloc++ ){
+			s |= suivants[ bloc * 256 + ( ( actifs >> ( 8 * bloc ) ) & 0xff ) ];
+		}
+		actifs = s & masques[ *p ];
+	}
+	return ( actifs & a->finaux[0] ) != 0;
+}
+
+/*
+ * Cas général : les ensembles d'états sont des tableaux de w mots.
+ */
+int reconnaitre_plusieurs_mots(
+	const Automate_positions * a, const unsigned char * p,
+	const unsigned char * fin
+){
+	size_t w = a->nb_mots;
+	uint64_t pile[ 2 * TAMPON_PILE_POSITIONS ];
+	uint64_t * tampon = ( w <= TAMPON_PILE_POSITIONS ) ?
+		pile : xmalloc( 2 * w * sizeof(uint64_t) );
+	uint64_t * actifs = tampon;
+	uint64_t * s = tampon + w;
+	size_t i, j;
+	int bloc;
+
+	memcpy( actifs, a->initiaux, w * sizeof(uint64_t) );
+	uint64_t non_vide = 1;
+	for( ; p < fin && non_vide; p++ ){
+		memset( s, 0, w * sizeof(uint64_t) );
+		// Les mots sont peu nombreux : les boucles sur w sont écrites ici
+		// plutôt que déléguées à bitset_union(), pour être déroulées et
+		// vectorisées par le compilateur.
+		if( a->suivants ){
+			for( bloc = 0; bloc < a->nb_blocs; bloc++ ){
+				int v = ( actifs[ bloc / 8 ] >> ( 8 * ( bloc % 8 ) ) ) & 0xff;
+				if( ! v ) continue;
+				const uint64_t * e = a->suivants + ( (size_t) bloc * 256 + v ) * w;
+				for( i = 0; i < w; i++ ) s[i] |= e[i];
+			}
+		}else{
+			for( j = 0; j < w; j++ ){
+				uint64_t mot = actifs[j];
+				while( mot ){
+					size_t q = j * BITSET_BITS + __builtin_ctzll( mot );
+					mot &= mot - 1;
+					const uint64_t * e = a->lignes + q * w;
+					for( i = 0; i < w; i++ ) s[i] |= e[i];
+				}
+			}
+		}
+		const uint64_t * masque = a->masques + (size_t) *p * w;
+		non_vide = 0;
+		for( i = 0; i < w; i++ ){
+			s[i] &= masque[i];
+			non_vide |= s[i];
+		}
+		uint64_t * tmp = actifs;
+		actifs = s;
+		s = tmp;
+	}
+	bitset_intersection( actifs, a->finaux, w );
+	int res = ! bitset_est_vide( actifs, w );
+	if( tampon != pile ) xfree( tampon );
+	return res;
+}
+
+int positions_reconnait_tampon(
+	const Automate_positions * automate, const char * mot, size_t longueur
+){
+	const unsigned char * p = (const unsigned char *) mot;
+	if( automate->nb_mots == 1 && automate->suivants ){
+		return reconnaitre_un_mot( automate, p, p + longueur );
+	}
+	return reconnaitre_plusieurs_mots( automate, p, p + longueur );
+}
+
+int positions_reconnait( const Automate_positions * automate, const char * mot ){
+	return positions_reconnait_tampon( automate, mot, strlen( mot ) );
+}
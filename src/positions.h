@@ -0,0 +1,109 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file positions.h */
+
+#ifndef __POSITIONS_H__
+#define __POSITIONS_H__
+
+#include "automate.h"
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief Le type d'un automate des positions prêt à être simulé en
+ *        parallèle sur les bits d'un mot machine.
+ *
+ * Un automate est homogène si toutes les transitions qui arrivent dans un
+ * même état portent la même lettre ; c'est le cas des automates de Glushkov
+ * (voir Glushkov()), où toutes les transitions qui arrivent dans la position
+ * p portent la lettre de p. Pour un tel automate, l'ensemble D des états
+ * actifs évolue, à la lecture de la lettre c, selon :
+ *     D' = Suivants( D ) & Masque( c )
+ * où Suivants( D ) est l'union des successeurs (toutes lettres confondues)
+ * des états de D, et Masque( c ) l'ensemble des états dans lesquels on
+ * entre par la lettre c. On n'a jamais besoin de déterminiser.
+ *
+ * Les états sont renumérotés de 0 à nb_etats-1 dans l'ordre croissant et
+ * codés par des tableaux de nb_mots mots de 64 bits (voir bitset.h).
+ * Suivants( D ) est calculé par blocs de 8 bits : suivants contient, pour
+ * chaque bloc et chaque valeur des 8 bits du bloc, l'union des successeurs
+ * des états correspondants. Si ces tables sont trop grosses, lignes contient
+ * simplement les successeurs de chaque état, et suivants vaut NULL.
+ *
+ * Lorsque l'automate a au plus 64 états, chaque ensemble d'états tient dans
+ * un seul mot de 64 bits et la simulation n'utilise que des registres.
+ *
+ * Un Automate_positions n'est jamais modifié après sa création : il peut
+ * être lu par plusieurs fils d'exécution à la fois.
+ */
+typedef struct Automate_positions {
+	int nb_etats;
+	int * etats;
+	size_t nb_mots;
+	int nb_blocs;
+	uint64_t * masques;		//!< masques[ octet * nb_mots ... ]
+	uint64_t * suivants;	//!< suivants[ ( bloc * 256 + valeur ) * nb_mots ... ]
+	uint64_t * lignes;		//!< lignes[ etat * nb_mots ... ]
+	uint64_t * initiaux;
+	uint64_t * finaux;
+} Automate_positions;
+
+/**
+ * @brief Prépare la simulation d'un automate homogène.
+ *
+ * Renvoie NULL si deux transitions qui arrivent dans un même état portent
+ * des lettres différentes.
+ *
+ * @param automate Un automate homogène, par exemple un automate de Glushkov.
+ * @return L'automate des positions, ou NULL.
+ */
+Automate_positions * creer_automate_positions( const Automate * automate );
+
+/**
+ * @brief Libère la mémoire d'un automate des positions.
+ *
+ * @param automate Un automate des positions.
+ */
+void liberer_automate_positions( Automate_positions * automate );
+
+/**
+ * @brief Renvoie 1 si le mot (terminé par '\0') est reconnu et 0 sinon.
+ *
+ * @param automate Un automate des positions.
+ * @param mot Un mot.
+ */
+int positions_reconnait( const Automate_positions * automate, const char * mot );
+
+/**
+ * @brief Renvoie 1 si le mot formé des 'longueur' premiers octets de 'mot'
+ *        est reconnu et 0 sinon.
+ *
+ * La fonction n'alloue pas de mémoire lorsque l'automate a au plus 4096
+ * états.
+ *
+ * @param automate Un automate des positions.
+ * @param mot Un tableau d'octets.
+ * @param longueur Le nombre d'octets du mot.
+ */
+int positions_reconnait_tampon(
+	const Automate_positions * automate, const char * mot, size_t longueur
+);
+
+#endif
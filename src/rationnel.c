@@ -21,6 +21,9 @@
 #include "rationnel.h"
 #include "ensemble.h"
 #include "automate.h"
+#include "equivalence.h"
+#include "automates_expression.h"
+#include "rationnel_interne.h"
 #include "parse.h"
 #include "scan.h"
 #include "outils.h"
@@ -30,12 +33,6 @@
 #include <assert.h>
 #include <stdio.h>
 
-typedef struct data_meme_langage 
-{ 
-   bool estDansSecondAutomate; 
-   Automate* a; 
-} Data;
-
 typedef struct data_systeme
 {
    int taille;
@@ -523,7 +520,6 @@ Ensemble *dernier(Rationnel *rat){
    /* L'ensemble des derniers n'est, au final, que l'ensemble des premiers 
    * de l'expression miroir */
    Rationnel * r = miroir_expression_rationnelle(rat);
-   print_rationnel(r);
    return premier(r);
 }
 
@@ -620,6 +616,17 @@ char get_position_lettre(Rationnel * rat, int position)
 /* Retourne un automate décrivant le langage décrit par le Rationnel donné. */
 Automate *Glushkov(Rationnel *rat)
 {
+   /* Un noeud partagé (voir Arden()) a plusieurs occurrences, donc
+   * plusieurs positions : on numérote une copie développée. */
+   if (rationnel_est_partage(rat))
+   {
+      Rationnel * arbre = developper_rationnel(rat);
+      numeroter_rationnel(arbre);
+      Automate * res = Glushkov(arbre);
+      liberer_rationnel_partage(arbre);
+      return res;
+   }
+
    Automate* aut = creer_automate();
 
    Ensemble * ens = premier(rat);
@@ -670,51 +677,10 @@ Automate *Glushkov(Rationnel *rat)
 
 }
 
-/* Fonction appelée par pour_toute_transition.
-* Teste si une transition d'un automate se trouve dans un
-* autre automate */
-void testerAutomateDans(int origine, char lettre, int fin, void * data)
-{ 
-   Data * a = (Data *) data; 
-   if (!est_une_transition_de_l_automate(a->a, origine, lettre, fin))
-   { 
-      a->estDansSecondAutomate = false; 
-   } 
-}
-
 /* Vérifie que deux automates quelconques vérifient le même langage. */
 bool automates_reconnaissent_le_meme_langage (Automate * aut1, Automate * aut2)
 {
-   aut1 = creer_automate_minimal(aut1);
-   aut2 = creer_automate_minimal(aut2);
-
-
-     if (comparer_ensemble(aut1->vide, aut2->vide) == 0) 
-     {
-      if (comparer_ensemble(aut1->etats, aut2->etats) == 0) 
-      {
-         if (comparer_ensemble(aut1->initiaux, aut2->initiaux) == 0) 
-         {
-            if (comparer_ensemble(aut1->finaux, aut2->finaux) == 0)
-            {
-               Data * d = malloc(sizeof(Data)); 
-               d->estDansSecondAutomate = true; 
-               d->a = aut2; 
-            
-               pour_toute_transition(aut1, testerAutomateDans, d);
-
-               Data * d1 = malloc(sizeof(Data)); 
-               d1->estDansSecondAutomate = true; 
-               d1->a = aut1;
-               pour_toute_transition(aut2, testerAutomateDans, d1); 
-
-               return d->estDansSecondAutomate && d1->estDansSecondAutomate;
-            }
-         }
-      }
-   }
-
-   return false;
+   return automates_equivalents(aut1, aut2, NULL);
 }
 
 /* Vérifie que deux expressions rationnelles textuelles (char*) reconnaissent 
@@ -722,28 +688,30 @@ bool automates_reconnaissent_le_meme_langage (Automate * aut1, Automate * aut2)
 bool meme_langage (const char *expr1, const char* expr2)
 {
 
-   /*expr ---(expr_to_rationnel)--> Rationnel* ---(Glushkov)--> Automate*
-   * On minimalise les automates, et on les compare. */
+   /*expr ---(expr_to_rationnel)--> Rationnel* ---(plus_petit_automate)--> Automate*
+   * On prend le plus petit quotient de l'automate de Glushkov, puis on
+   * compare les automates sans les déterminiser ni les minimiser
+   * (voir automates_equivalents()). */
    Rationnel* rat1, *rat2;
    rat1 = expression_to_rationnel(expr1);
    rat2 = expression_to_rationnel(expr2);
 
-   numeroter_rationnel(rat1);
-   numeroter_rationnel(rat2);
-
    Automate * aut1, *aut2;
-   aut1 = Glushkov(rat1);
-   aut2 = Glushkov(rat2);
+   aut1 = plus_petit_automate(rat1, NULL);
+   aut2 = plus_petit_automate(rat2, NULL);
 
-  
-   return automates_reconnaissent_le_meme_langage(aut1, aut2);
+   bool res = automates_reconnaissent_le_meme_langage(aut1, aut2);
+   liberer_automate(aut1);
+   liberer_automate(aut2);
+   return res;
 
 }
 
 void remplir_matrice(int origine, char lettre, int fin, void * data)
 {
+   // Plusieurs lettres peuvent mener de 'origine' à 'fin'
    Systeme sys = (Systeme) data;
-   sys[origine][fin] = Lettre(lettre);
+   sys[origine][fin] = Union(sys[origine][fin], Lettre(lettre));
 }
 
 void ajouter_epsilon(const intptr_t element, void * data)
@@ -764,7 +732,7 @@ Systeme systeme(Automate *automate)
    Systeme sys = malloc(taille * sizeof(Rationnel **));
 
    for (int ind = 0; ind < taille; ind++)
-      sys[ind] = malloc((taille + 1) * sizeof(Rationnel *));
+      sys[ind] = calloc(taille + 1, sizeof(Rationnel *));
 
    pour_toute_transition(automate, remplir_matrice, sys);
    ens = get_finaux(automate);
@@ -774,6 +742,7 @@ Systeme systeme(Automate *automate)
    data->sys = sys;
 
    pour_tout_element(ens, ajouter_epsilon, data);
+   free(data);
 
    return sys;
 }
@@ -855,11 +824,14 @@ Systeme resoudre_systeme(Systeme systeme, int nb_vars)
 /* Retourne un Rationnel décrivant l'automate donné. */
 Rationnel *Arden(Automate *automate)
 {
-   // Crée une matrice représentant le système d'équations de l'automate
-   Systeme sys = systeme(automate);
-   int taille = taille_ensemble(get_etats(automate));
-   // Résoud le système et sauvegarde le résultat dans sys[0][taille]
-   sys = resoudre_systeme(sys, taille);
+   /* Les substitutions successives recopient les mêmes sous-expressions
+   * dans plusieurs lignes : on résout le système avec des rationnels
+   * internés, partagés et simplifiés (voir rationnel_interne.h). Le
+   * résultat reste partagé : seuls ses noeuds survivent à la table. */
+   Table_rationnels * table = creer_table_rationnels();
+   Rationnel * rat = extraire_rationnel_interne(
+      table, Arden_interne(table, automate)
+   );
 
-   return sys[0][taille];
+   return rat;
 }
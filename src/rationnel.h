@@ -381,7 +381,16 @@ Systeme resoudre_systeme(Systeme sys, int nb_vars);
 
 /**
  * @brief @todo Convertit un automate en expression rationnelle.
- * @param automate L'automate d'entrée.
+ *
+ * Le système est résolu avec des rationnels internés (voir Arden_interne()).
+ * L'expression renvoyée est un rationnel partagé (voir
+ * extraire_rationnel_interne()) : ses sous-expressions égales sont un même
+ * noeud, si bien que sa taille reste proche de celle du système alors que
+ * l'arbre développé peut être exponentiel. Elle peut être passée à
+ * Glushkov(), Antimirov() ou plus_petit_automate(), se libère avec
+ * liberer_rationnel_partage(), et developper_rationnel() en donne un arbre
+ * ordinaire.
+ * @param automate L'automate d'entrée, dont les états sont numérotés de 0 à n-1, l'état initial étant 0.
  * @return Une expression rationnelle décrivant le langage reconnu par l'automate.
  */
 Rationnel *Arden(Automate *automate);
@@ -0,0 +1,415 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "rationnel_interne.h"
+#include "ensemble.h"
+#include "outils.h"
+#include "sous_ensembles.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct Table_rationnels {
+	Table_sous_ensembles * index;	// ( étiquette, lettre, fils gauche, fils droit )
+	Rationnel ** noeuds;			// noeuds[i] : le noeud de numéro i
+	char * vide;					// vide[i] : le noeud i contient le mot vide
+	int capacite;
+};
+
+int numero_interne( const Rationnel * rat ){
+	return rat ? (int) (intptr_t) rat->data : -1;
+}
+
+Rationnel * noeud_interne(
+	Table_rationnels * table, Noeud etiquette, char lettre,
+	Rationnel * gauche, Rationnel * droit
+){
+	int cle[4] = {
+		etiquette, (unsigned char) lettre,
+		numero_interne( gauche ), numero_interne( droit )
+	};
+	int nouveau;
+	int id = interner_sous_ensemble( table->index, cle, 4, &nouveau );
+	if( ! nouveau ) return table->noeuds[id];
+
+	if( id == table->capacite ){
+		table->capacite *= 2;
+		table->noeuds = xrealloc(
+			table->noeuds, table->capacite * sizeof(Rationnel *)
+		);
+		table->vide = xrealloc( table->vide, table->capacite );
+	}
+	Rationnel * rat = rationnel(
+		etiquette, lettre, 0, 0, (void *) (intptr_t) id, gauche, droit, NULL
+	);
+	table->noeuds[id] = rat;
+	switch( etiquette ){
+		case EPSILON:
+		case STAR:
+			table->vide[id] = 1;
+			break;
+		case UNION:
+			table->vide[id] =
+				table->vide[ numero_interne( gauche ) ]
+				|| table->vide[ numero_interne( droit ) ];
+			break;
+		case CONCAT:
+			table->vide[id] =
+				table->vide[ numero_interne( gauche ) ]
+				&& table->vide[ numero_interne( droit ) ];
+			break;
+		default:
+			table->vide[id] = 0;
+	}
+	return rat;
+}
+
+Table_rationnels * creer_table_rationnels(){
+	Table_rationnels * table = xmalloc( sizeof(Table_rationnels) );
+	table->index = creer_table_sous_ensembles();
+	table->capacite = 64;
+	table->noeuds = xmalloc( table->capacite * sizeof(Rationnel *) );
+	table->vide = xmalloc( table->capacite );
+	return table;
+}
+
+void liberer_table_rationnels( Table_rationnels * table, int liberer_rationnels ){
+	if( liberer_rationnels ){
+		int i, n = nombre_de_sous_ensembles( table->index );
+		// Les noeuds sont alloués par rationnel()
+		for( i = 0; i < n; i++ ) free( table->noeuds[i] );
+	}
+	liberer_table_sous_ensembles( table->index );
+	xfree( table->noeuds );
+	xfree( table->vide );
+	xfree( table );
+}
+
+int nombre_de_rationnels_internes( const Table_rationnels * table ){
+	return nombre_de_sous_ensembles( table->index );
+}
+
+int contient_mot_vide_interne(
+	const Table_rationnels * table, const Rationnel * rat
+){
+	return rat ? table->vide[ numero_interne( rat ) ] : 0;
+}
+
+Rationnel * epsilon_interne( Table_rationnels * table ){
+	return noeud_interne( table, EPSILON, 0, NULL, NULL );
+}
+
+Rationnel * lettre_interne( Table_rationnels * table, char lettre ){
+	return noeud_interne( table, LETTRE, lettre, NULL, NULL );
+}
+
+int comparer_numeros( const void * a, const void * b ){
+	int x = numero_interne( *(Rationnel * const *) a );
+	int y = numero_interne( *(Rationnel * const *) b );
+	return ( x > y ) - ( x < y );
+}
+
+int nombre_de_membres( const Rationnel * rat ){
+	int n = 1;
+	while( rat->etiquette == UNION ){
+		n++;
+		rat = rat->droit;
+	}
+	return n;
+}
+
+/*
+ * Copie dans 'membres' les membres de l'union 'rat' (rat lui-même si ce
+ * n'est pas une union) ; renvoie leur nombre.
+ */
+int copier_membres( Rationnel * rat, Rationnel ** membres ){
+	int n = 0;
+	while( rat->etiquette == UNION ){
+		membres[ n++ ] = rat->gauche;
+		rat = rat->droit;
+	}
+	membres[ n++ ] = rat;
+	return n;
+}
+
+/*
+ * Construit l'union des 'n' membres, triés par numéro et sans doublon ;
+ * 'omettre' est un membre à ignorer, ou NULL.
+ */
+Rationnel * peigne_union(
+	Table_rationnels * table, Rationnel ** membres, int n,
+	const Rationnel * omettre
+){
+	Rationnel * res = NULL;
+	int i;
+	for( i = n - 1; i >= 0; i-- ){
+		if( membres[i] == omettre ) continue;
+		res = res ? noeud_interne( table, UNION, 0, membres[i], res ) : membres[i];
+	}
+	return res;
+}
+
+Rationnel * union_interne(
+	Table_rationnels * table, Rationnel * rat1, Rationnel * rat2
+){
+	if( ! rat1 ) return rat2;
+	if( ! rat2 || rat1 == rat2 ) return rat1;
+
+	int n = nombre_de_membres( rat1 ) + nombre_de_membres( rat2 );
+	Rationnel ** membres = xmalloc( n * sizeof(Rationnel *) );
+	n = copier_membres( rat1, membres );
+	n += copier_membres( rat2, membres + n );
+	qsort( membres, n, sizeof(Rationnel *), comparer_numeros );
+	int i, k = 0, vide = 0;
+	Rationnel * epsilon = NULL;
+	for( i = 0; i < n; i++ ){
+		if( k > 0 && membres[ k - 1 ] == membres[i] ) continue;
+		membres[ k++ ] = membres[i];
+		if( membres[i]->etiquette == EPSILON ){
+			epsilon = membres[i];
+		}else if( table->vide[ numero_interne( membres[i] ) ] ){
+			vide = 1;
+		}
+	}
+	// ε + r = r si r contient le mot vide
+	Rationnel * res = peigne_union( table, membres, k, vide ? epsilon : NULL );
+	xfree( membres );
+	return res;
+}
+
+Rationnel * concat_interne(
+	Table_rationnels * table, Rationnel * rat1, Rationnel * rat2
+){
+	if( ! rat1 || ! rat2 ) return NULL;
+	if( rat1->etiquette == EPSILON ) return rat2;
+	if( rat2->etiquette == EPSILON ) return rat1;
+	return noeud_interne( table, CONCAT, 0, rat1, rat2 );
+}
+
+Rationnel * etoile_interne( Table_rationnels * table, Rationnel * rat ){
+	if( ! rat || rat->etiquette == EPSILON ) return epsilon_interne( table );
+	if( rat->etiquette == STAR ) return rat;
+	if( rat->etiquette == UNION ){
+		// (ε + r)* = r*
+		int n = nombre_de_membres( rat );
+		Rationnel ** membres = xmalloc( n * sizeof(Rationnel *) );
+		copier_membres( rat, membres );
+		Rationnel * epsilon = NULL;
+		int i;
+		for( i = 0; i < n; i++ ){
+			if( membres[i]->etiquette == EPSILON ) epsilon = membres[i];
+		}
+		if( epsilon ) rat = peigne_union( table, membres, n, epsilon );
+		xfree( membres );
+		if( epsilon ) return etoile_interne( table, rat );
+	}
+	return noeud_interne( table, STAR, 0, rat, NULL );
+}
+
+Rationnel * interner_rationnel( Table_rationnels * table, const Rationnel * rat ){
+	if( ! rat ) return NULL;
+	switch( rat->etiquette ){
+		case EPSILON:
+			return epsilon_interne( table );
+		case LETTRE:
+			return lettre_interne( table, rat->lettre );
+		case STAR:
+			return etoile_interne( table, interner_rationnel( table, rat->gauche ) );
+		case UNION:
+			return union_interne(
+				table, interner_rationnel( table, rat->gauche ),
+				interner_rationnel( table, rat->droit )
+			);
+		case CONCAT:
+			return concat_interne(
+				table, interner_rationnel( table, rat->gauche ),
+				interner_rationnel( table, rat->droit )
+			);
+	}
+	return NULL;
+}
+
+/*
+ * Marque les numéros des noeuds internés atteints depuis 'rat'.
+ */
+void marquer_noeuds_internes( const Rationnel * rat, char * garde ){
+	if( ! rat || garde[ numero_interne( rat ) ] ) return;
+	garde[ numero_interne( rat ) ] = 1;
+	marquer_noeuds_internes( rat->gauche, garde );
+	marquer_noeuds_internes( rat->droit, garde );
+}
+
+Rationnel * extraire_rationnel_interne(
+	Table_rationnels * table, Rationnel * rat
+){
+	int i, n = nombre_de_rationnels_internes( table );
+	char * garde = xmalloc( n );
+	memset( garde, 0, n );
+	marquer_noeuds_internes( rat, garde );
+	for( i = 0; i < n; i++ ){
+		if( ! garde[i] ) free( table->noeuds[i] );
+	}
+	xfree( garde );
+	liberer_table_rationnels( table, 0 );
+	return rat;
+}
+
+/*
+ * Ajoute à 'vus' les noeuds atteints depuis 'rat' ; renvoie 1 dès qu'un
+ * noeud est atteint deux fois si 'arret' vaut 1.
+ */
+int parcourir_noeuds( const Rationnel * rat, Ensemble * vus, int arret ){
+	if( ! rat ) return 0;
+	if( est_dans_l_ensemble( vus, (intptr_t) rat ) ) return 1;
+	ajouter_element( vus, (intptr_t) rat );
+	if( parcourir_noeuds( rat->gauche, vus, arret ) && arret ) return 1;
+	return parcourir_noeuds( rat->droit, vus, arret ) && arret;
+}
+
+int rationnel_est_partage( const Rationnel * rat ){
+	Ensemble * vus = creer_ensemble( NULL, NULL, NULL );
+	int res = parcourir_noeuds( rat, vus, 1 );
+	liberer_ensemble( vus );
+	return res;
+}
+
+void liberer_rationnel_partage( Rationnel * rat ){
+	Ensemble * vus = creer_ensemble( NULL, NULL, NULL );
+	parcourir_noeuds( rat, vus, 0 );
+	Ensemble_iterateur it;
+	for(
+		it = premier_iterateur_ensemble( vus );
+		! iterateur_ensemble_est_vide( it );
+		it = iterateur_suivant_ensemble( it )
+	){
+		free( (Rationnel *) get_element( it ) );
+	}
+	liberer_ensemble( vus );
+}
+
+/*
+ * Recopie 'rat' sous le père 'pere', chaque occurrence d'un noeud partagé
+ * devenant un noeud distinct.
+ */
+Rationnel * copier_occurrences( const Rationnel * rat, Rationnel * pere ){
+	Rationnel * res = rationnel(
+		rat->etiquette, rat->lettre, 0, 0, NULL, NULL, NULL, pere
+	);
+	if( rat->gauche ) res->gauche = copier_occurrences( rat->gauche, res );
+	if( rat->droit ) res->droit = copier_occurrences( rat->droit, res );
+	return res;
+}
+
+Rationnel * developper_rationnel( const Rationnel * rat ){
+	return rat ? copier_occurrences( rat, NULL ) : NULL;
+}
+
+typedef struct {
+	Table_rationnels * table;
+	Systeme systeme;
+} Donnees_systeme_interne;
+
+void ajouter_transition_systeme( int origine, char lettre, int fin, void * data ){
+	Donnees_systeme_interne * d = data;
+	d->systeme[ origine ][ fin ] = union_interne(
+		d->table, d->systeme[ origine ][ fin ], lettre_interne( d->table, lettre )
+	);
+}
+
+Systeme systeme_interne( Table_rationnels * table, const Automate * automate ){
+	int n = taille_ensemble( get_etats( automate ) ), i, j;
+	Systeme systeme = xmalloc( ( n + 1 ) * sizeof(Rationnel **) );
+	for( i = 0; i < n; i++ ){
+		systeme[i] = xmalloc( ( n + 1 ) * sizeof(Rationnel *) );
+		for( j = 0; j <= n; j++ ) systeme[i][j] = NULL;
+	}
+	Donnees_systeme_interne d = { table, systeme };
+	pour_toute_transition( automate, ajouter_transition_systeme, &d );
+	Ensemble_iterateur it;
+	for(
+		it = premier_iterateur_ensemble( get_finaux( automate ) );
+		! iterateur_ensemble_est_vide( it );
+		it = iterateur_suivant_ensemble( it )
+	){
+		systeme[ get_element( it ) ][n] = epsilon_interne( table );
+	}
+	return systeme;
+}
+
+Rationnel ** resoudre_variable_arden_interne(
+	Table_rationnels * table, Rationnel ** ligne, int numero_variable,
+	int nb_vars
+){
+	if( ! ligne[ numero_variable ] ) return ligne;
+	// X = U.X + V donne X = U*.V
+	Rationnel * etoile = etoile_interne( table, ligne[ numero_variable ] );
+	int i;
+	for( i = 0; i <= nb_vars; i++ ){
+		if( i != numero_variable ){
+			ligne[i] = concat_interne( table, etoile, ligne[i] );
+		}
+	}
+	ligne[ numero_variable ] = NULL;
+	return ligne;
+}
+
+Rationnel ** substituer_variable_interne(
+	Table_rationnels * table, Rationnel ** ligne, int numero_variable,
+	Rationnel ** valeur_variable, int nb_vars
+){
+	Rationnel * coefficient = ligne[ numero_variable ];
+	if( ! coefficient ) return ligne;
+	int i;
+	for( i = 0; i <= nb_vars; i++ ){
+		if( i != numero_variable ){
+			ligne[i] = union_interne(
+				table, ligne[i],
+				concat_interne( table, coefficient, valeur_variable[i] )
+			);
+		}
+	}
+	ligne[ numero_variable ] = NULL;
+	return ligne;
+}
+
+Systeme resoudre_systeme_interne(
+	Table_rationnels * table, Systeme systeme, int nb_vars
+){
+	int i, j;
+	for( i = nb_vars - 1; i >= 0; i-- ){
+		resoudre_variable_arden_interne( table, systeme[i], i, nb_vars );
+		for( j = 0; j < i; j++ ){
+			substituer_variable_interne(
+				table, systeme[j], i, systeme[i], nb_vars
+			);
+		}
+	}
+	return systeme;
+}
+
+Rationnel * Arden_interne( Table_rationnels * table, const Automate * automate ){
+	int n = taille_ensemble( get_etats( automate ) ), i;
+	if( n == 0 ) return NULL;
+	Systeme systeme = systeme_interne( table, automate );
+	resoudre_systeme_interne( table, systeme, n );
+	Rationnel * rat = systeme[0][n];
+	for( i = 0; i < n; i++ ) xfree( systeme[i] );
+	xfree( systeme );
+	return rat;
+}
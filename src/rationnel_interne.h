@@ -0,0 +1,246 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file rationnel_interne.h */
+
+#ifndef __RATIONNEL_INTERNE_H__
+#define __RATIONNEL_INTERNE_H__
+
+#include "automate.h"
+#include "rationnel.h"
+
+/**
+ * @brief Le type d'une table de rationnels internés.
+ *
+ * Deux rationnels internés dans la même table qui ont la même étiquette, la
+ * même lettre et les mêmes fils sont le même noeud : les sous-expressions
+ * égales sont partagées, et une expression est un graphe sans cycle plutôt
+ * qu'un arbre. Le numéro d'un noeud dans la table est rangé dans son champ
+ * 'data' ; son champ 'pere' vaut NULL, puisqu'un noeud partagé a plusieurs
+ * pères. Les fonctions qui utilisent les champs 'pere' ou 'position_min' et
+ * 'position_max' (numeroter_rationnel(), premier(), suivant(), ...) ne
+ * s'appliquent donc pas aux rationnels internés ; Glushkov(), Antimirov()
+ * et plus_petit_automate() s'y appliquent.
+ *
+ * Les constructeurs simplifient les expressions à l'aide de quelques
+ * identités, NULL représentant ∅ :
+ * - ∅ + r = r, ∅.r = r.∅ = ∅, ∅* = ε ;
+ * - ε.r = r.ε = r, ε* = ε ;
+ * - (r*)* = r* et (ε + r)* = r* ;
+ * - l'union est associative, commutative et idempotente : ses membres sont
+ *   triés par numéro, sans doublon, et rangés dans un peigne à droite ;
+ * - ε + r = r si r contient le mot vide.
+ */
+typedef struct Table_rationnels Table_rationnels;
+
+/**
+ * @brief Crée une table de rationnels internés vide.
+ */
+Table_rationnels * creer_table_rationnels();
+
+/**
+ * @brief Libère une table de rationnels internés.
+ *
+ * @param table Une table de rationnels internés.
+ * @param liberer_rationnels Si ce paramètre vaut 0, les rationnels internés
+ *        ne sont pas libérés : ils deviennent des rationnels ordinaires
+ *        (partagés), qui ne doivent plus être passés aux constructeurs de
+ *        ce fichier.
+ */
+void liberer_table_rationnels( Table_rationnels * table, int liberer_rationnels );
+
+/**
+ * @brief Renvoie le nombre de rationnels internés dans la table.
+ *
+ * @param table Une table de rationnels internés.
+ */
+int nombre_de_rationnels_internes( const Table_rationnels * table );
+
+/**
+ * @brief Renvoie le numéro d'un rationnel interné, ou -1 pour NULL.
+ *
+ * Les numéros d'une table vont de 0 à nombre_de_rationnels_internes()-1.
+ *
+ * @param rat Un rationnel interné, ou NULL.
+ */
+int numero_interne( const Rationnel * rat );
+
+/**
+ * @brief Renvoie 1 si le rationnel interné contient le mot vide, et 0
+ *        sinon (en particulier pour NULL).
+ *
+ * @param table Une table de rationnels internés.
+ * @param rat Un rationnel interné dans la table, ou NULL.
+ */
+int contient_mot_vide_interne(
+	const Table_rationnels * table, const Rationnel * rat
+);
+
+/**
+ * @brief Renvoie le mot vide interné.
+ *
+ * @param table Une table de rationnels internés.
+ */
+Rationnel * epsilon_interne( Table_rationnels * table );
+
+/**
+ * @brief Renvoie la lettre internée.
+ *
+ * @param table Une table de rationnels internés.
+ * @param lettre Une lettre.
+ */
+Rationnel * lettre_interne( Table_rationnels * table, char lettre );
+
+/**
+ * @brief Renvoie l'union simplifiée de deux rationnels internés.
+ *
+ * @param table Une table de rationnels internés.
+ * @param rat1 Un rationnel interné dans la table, ou NULL.
+ * @param rat2 Un rationnel interné dans la table, ou NULL.
+ */
+Rationnel * union_interne(
+	Table_rationnels * table, Rationnel * rat1, Rationnel * rat2
+);
+
+/**
+ * @brief Renvoie la concaténation simplifiée de deux rationnels internés.
+ *
+ * @param table Une table de rationnels internés.
+ * @param rat1 Un rationnel interné dans la table, ou NULL.
+ * @param rat2 Un rationnel interné dans la table, ou NULL.
+ */
+Rationnel * concat_interne(
+	Table_rationnels * table, Rationnel * rat1, Rationnel * rat2
+);
+
+/**
+ * @brief Renvoie l'étoile simplifiée d'un rationnel interné.
+ *
+ * @param table Une table de rationnels internés.
+ * @param rat Un rationnel interné dans la table, ou NULL.
+ */
+Rationnel * etoile_interne( Table_rationnels * table, Rationnel * rat );
+
+/**
+ * @brief Interne, en le simplifiant, un rationnel quelconque.
+ *
+ * Le rationnel passé en paramètre n'est pas modifié.
+ *
+ * @param table Une table de rationnels internés.
+ * @param rat Un rationnel, ou NULL.
+ * @return Le rationnel interné.
+ */
+Rationnel * interner_rationnel( Table_rationnels * table, const Rationnel * rat );
+
+/**
+ * @brief Libère la table en ne gardant que les noeuds atteints depuis un
+ *        rationnel interné, qui devient un rationnel partagé.
+ *
+ * Un rationnel partagé est un graphe sans cycle : ses sous-expressions
+ * égales sont un même noeud, et ses champs 'pere' valent NULL. Il ne doit
+ * plus être passé aux constructeurs de ce fichier ; il se libère avec
+ * liberer_rationnel_partage().
+ *
+ * @param table Une table de rationnels internés, libérée par la fonction.
+ * @param rat Un rationnel interné dans la table, ou NULL.
+ * @return Le rationnel partagé 'rat'.
+ */
+Rationnel * extraire_rationnel_interne(
+	Table_rationnels * table, Rationnel * rat
+);
+
+/**
+ * @brief Renvoie 1 si un noeud du rationnel est atteint par deux chemins
+ *        depuis la racine, et 0 sinon.
+ *
+ * @param rat Un rationnel, ou NULL.
+ */
+int rationnel_est_partage( const Rationnel * rat );
+
+/**
+ * @brief Libère chaque noeud d'un rationnel, partagé ou non, une seule fois.
+ *
+ * @param rat Un rationnel, ou NULL.
+ */
+void liberer_rationnel_partage( Rationnel * rat );
+
+/**
+ * @brief Recopie un rationnel en un arbre ordinaire.
+ *
+ * Chaque occurrence d'un noeud partagé devient un noeud distinct, et les
+ * champs 'pere' sont remplis. La taille de l'arbre est celle de
+ * l'expression développée, qui peut être exponentielle en le nombre de
+ * noeuds d'un rationnel partagé : Glushkov() s'applique directement aux
+ * rationnels partagés, et cette copie n'est utile que pour les fonctions
+ * qui numérotent ou remontent les noeuds (numeroter_rationnel(),
+ * premier(), suivant(), ...).
+ *
+ * @param rat Un rationnel, ou NULL.
+ * @return L'arbre, ou NULL si 'rat' vaut NULL.
+ */
+Rationnel * developper_rationnel( const Rationnel * rat );
+
+/**
+ * @brief Construit, avec des rationnels internés, le système d'équations
+ *        de langages associé à un automate (voir systeme()).
+ *
+ * @param table Une table de rationnels internés.
+ * @param automate L'automate, dont les états sont numérotés de 0 à n-1.
+ */
+Systeme systeme_interne( Table_rationnels * table, const Automate * automate );
+
+/**
+ * @brief Comme resoudre_variable_arden(), avec des rationnels internés.
+ */
+Rationnel ** resoudre_variable_arden_interne(
+	Table_rationnels * table, Rationnel ** ligne, int numero_variable,
+	int nb_vars
+);
+
+/**
+ * @brief Comme substituer_variable(), avec des rationnels internés.
+ */
+Rationnel ** substituer_variable_interne(
+	Table_rationnels * table, Rationnel ** ligne, int numero_variable,
+	Rationnel ** valeur_variable, int nb_vars
+);
+
+/**
+ * @brief Comme resoudre_systeme(), avec des rationnels internés.
+ */
+Systeme resoudre_systeme_interne(
+	Table_rationnels * table, Systeme systeme, int nb_vars
+);
+
+/**
+ * @brief Convertit un automate en expression rationnelle internée dans la
+ *        table (voir Arden()).
+ *
+ * Grâce au partage et aux simplifications, la taille de l'expression (le
+ * nombre de noeuds internés) reste proche de celle du système, alors que
+ * l'arbre développé des substitutions successives peut être exponentiel.
+ * L'expression est libérée avec la table.
+ *
+ * @param table Une table de rationnels internés.
+ * @param automate L'automate, dont les états sont numérotés de 0 à n-1,
+ *        l'état initial étant 0.
+ * @return L'expression, ou NULL si le langage est vide.
+ */
+Rationnel * Arden_interne( Table_rationnels * table, const Automate * automate );
+
+#endif
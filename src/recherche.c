@@ -0,0 +1,245 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "recherche.h"
+#include "bitset.h"
+#include "outils.h"
+
+#include <string.h>
+
+/*
+ * L'Afd minimal et émondé d'un automate : les états dont on ne peut plus
+ * atteindre d'état final disparaissent, et les transitions qui y menaient
+ * mènent à l'état mort de l'Afd.
+ */
+Afd * creer_afd_emonde( const Automate * automate ){
+	Automate * deterministe = creer_automate_deterministe( automate );
+	Automate * minimal = creer_automate_minimal( deterministe );
+	Automate * emonde = automate_emonde( minimal );
+	Afd * afd = creer_afd( emonde );
+	liberer_automate( emonde );
+	liberer_automate( minimal );
+	liberer_automate( deterministe );
+	return afd;
+}
+
+void action_prefixer_sigma_etoile( int origine, char lettre, int fin, void* data ){
+	void ** d = (void**) data;
+	const Automate * automate = (const Automate*) d[0];
+	Automate * res = (Automate*) d[1];
+	int nouvel_initial = *(int*) d[2];
+	ajouter_transition( res, origine, lettre, fin );
+	if( est_un_etat_initial_de_l_automate( automate, origine ) ){
+		ajouter_transition( res, nouvel_initial, lettre, fin );
+	}
+}
+
+/*
+ * L'Afd de Σ*.L, où L est le langage de l'automate et Σ son alphabet. Les
+ * octets hors de l'alphabet ramènent à l'état initial.
+ */
+Afd * creer_afd_non_ancre( const Automate * automate ){
+	Automate * prefixe = creer_automate();
+	int nouvel_initial = 0;
+	if( taille_ensemble( get_etats( automate ) ) > 0 ){
+		nouvel_initial = get_max_etat( automate ) + 1;
+	}
+	ajouter_etat_initial( prefixe, nouvel_initial );
+	Ensemble_iterateur it;
+	for(
+		it = premier_iterateur_ensemble( get_alphabet( automate ) );
+		! iterateur_ensemble_est_vide( it );
+		it = iterateur_suivant_ensemble( it )
+	){
+		ajouter_transition(
+			prefixe, nouvel_initial, (char) get_element( it ), nouvel_initial
+		);
+	}
+	for(
+		it = premier_iterateur_ensemble( get_finaux( automate ) );
+		! iterateur_ensemble_est_vide( it );
+		it = iterateur_suivant_ensemble( it )
+	){
+		ajouter_etat_final( prefixe, get_element( it ) );
+		if( est_un_etat_initial_de_l_automate( automate, get_element( it ) ) ){
+			ajouter_etat_final( prefixe, nouvel_initial );
+		}
+	}
+	void * data[3] = { (void*) automate, prefixe, &nouvel_initial };
+	pour_toute_transition( automate, action_prefixer_sigma_etoile, data );
+
+	Afd * afd = creer_afd_emonde( prefixe );
+	liberer_automate( prefixe );
+
+	int32_t q;
+	for( q = 0; q < afd->nb_etats; q++ ){
+		afd->suivant[ (size_t) q * afd->nb_classes ] = afd->initial * afd->nb_classes;
+	}
+	return afd;
+}
+
+Recherche * creer_recherche( const Automate * automate ){
+	Recherche * recherche = xmalloc( sizeof(Recherche) );
+	Automate * mir = miroir( automate );
+	recherche->avant = creer_afd_emonde( automate );
+	recherche->arriere = creer_afd_emonde( mir );
+	recherche->avant_non_ancre = creer_afd_non_ancre( automate );
+	recherche->arriere_non_ancre = creer_afd_non_ancre( mir );
+	liberer_automate( mir );
+	return recherche;
+}
+
+void liberer_recherche( Recherche * recherche ){
+	liberer_afd( recherche->avant );
+	liberer_afd( recherche->arriere );
+	liberer_afd( recherche->avant_non_ancre );
+	liberer_afd( recherche->arriere_non_ancre );
+	xfree( recherche );
+}
+
+/*
+ * Renvoie la fin de l'occurrence la plus longue qui commence en 'debut'.
+ * Il doit y en avoir une.
+ */
+size_t fin_la_plus_longue(
+	const Afd * avant, const char * texte, size_t longueur, size_t debut
+){
+	const int32_t * suivant = avant->suivant;
+	const uint16_t * classe = avant->classe;
+	const unsigned char * t = (const unsigned char *) texte;
+	int32_t m = avant->nb_classes;
+	int32_t ligne = avant->initial * m;
+	size_t fin = debut, i;
+	for( i = debut; i < longueur && ligne != AFD_MORT; i++ ){
+		ligne = suivant[ ligne + classe[ t[i] ] ];
+		if( afd_est_final( avant, ligne / m ) ) fin = i + 1;
+	}
+	return fin;
+}
+
+/*
+ * Renvoie le début de l'occurrence la plus longue qui finit en 'fin'. Il
+ * doit y en avoir une.
+ */
+size_t debut_le_plus_a_gauche(
+	const Afd * arriere, const char * texte, size_t fin
+){
+	const int32_t * suivant = arriere->suivant;
+	const uint16_t * classe = arriere->classe;
+	const unsigned char * t = (const unsigned char *) texte;
+	int32_t m = arriere->nb_classes;
+	int32_t ligne = arriere->initial * m;
+	size_t debut = fin, i;
+	for( i = fin; i > 0 && ligne != AFD_MORT; i-- ){
+		ligne = suivant[ ligne + classe[ t[i-1] ] ];
+		if( afd_est_final( arriere, ligne / m ) ) debut = i - 1;
+	}
+	return debut;
+}
+
+int rechercher_premiere(
+	const Recherche * recherche, const char * texte, size_t longueur,
+	Occurrence * occurrence
+){
+	const Afd * afd = recherche->arriere_non_ancre;
+	const int32_t * suivant = afd->suivant;
+	const uint16_t * classe = afd->classe;
+	const unsigned char * t = (const unsigned char *) texte;
+	int32_t m = afd->nb_classes;
+	int32_t ligne = afd->initial * m;
+	int trouve = afd_est_final( afd, afd->initial );
+	size_t debut = longueur, i;
+	for( i = longueur; i > 0; i-- ){
+		ligne = suivant[ ligne + classe[ t[i-1] ] ];
+		if( afd_est_final( afd, ligne / m ) ){
+			trouve = 1;
+			debut = i - 1;
+		}
+	}
+	if( ! trouve ) return 0;
+	occurrence->debut = debut;
+	occurrence->fin = fin_la_plus_longue( recherche->avant, texte, longueur, debut );
+	return 1;
+}
+
+/*
+ * Ajoute une occurrence au tableau, en doublant sa capacité si besoin.
+ */
+void ajouter_occurrence(
+	Occurrence ** occurrences, size_t * nb, size_t * capacite,
+	size_t debut, size_t fin
+){
+	if( *nb == *capacite ){
+		*capacite *= 2;
+		*occurrences = xrealloc( *occurrences, *capacite * sizeof(Occurrence) );
+	}
+	( *occurrences )[ *nb ].debut = debut;
+	( *occurrences )[ *nb ].fin = fin;
+	( *nb )++;
+}
+
+size_t rechercher_toutes(
+	const Recherche * recherche, const char * texte, size_t longueur,
+	int mode, Occurrence ** occurrences
+){
+	size_t nb = 0, capacite = 16, i;
+	*occurrences = xmalloc( capacite * sizeof(Occurrence) );
+	const unsigned char * t = (const unsigned char *) texte;
+
+	if( mode == RECHERCHE_CHEVAUCHANTES ){
+		const Afd * afd = recherche->avant_non_ancre;
+		int32_t m = afd->nb_classes;
+		int32_t ligne = afd->initial * m;
+		for( i = 0; i <= longueur; i++ ){
+			if( i > 0 ) ligne = afd->suivant[ ligne + afd->classe[ t[i-1] ] ];
+			if( afd_est_final( afd, ligne / m ) ){
+				ajouter_occurrence(
+					occurrences, &nb, &capacite,
+					debut_le_plus_a_gauche( recherche->arriere, texte, i ), i
+				);
+			}
+		}
+		return nb;
+	}
+
+	// Débuts possibles, marqués par une lecture de droite à gauche
+	const Afd * afd = recherche->arriere_non_ancre;
+	int32_t m = afd->nb_classes;
+	int32_t ligne = afd->initial * m;
+	size_t nb_mots = BITSET_NB_MOTS( longueur + 1 );
+	uint64_t * debuts = xmalloc( nb_mots * sizeof(uint64_t) );
+	memset( debuts, 0, nb_mots * sizeof(uint64_t) );
+	if( afd_est_final( afd, afd->initial ) ) BITSET_AJOUTER( debuts, longueur );
+	for( i = longueur; i > 0; i-- ){
+		ligne = afd->suivant[ ligne + afd->classe[ t[i-1] ] ];
+		if( afd_est_final( afd, ligne / m ) ) BITSET_AJOUTER( debuts, i - 1 );
+	}
+
+	long debut = bitset_suivant( debuts, nb_mots, 0 );
+	while( debut >= 0 ){
+		size_t fin = fin_la_plus_longue(
+			recherche->avant, texte, longueur, (size_t) debut
+		);
+		ajouter_occurrence( occurrences, &nb, &capacite, (size_t) debut, fin );
+		size_t reprise = ( fin > (size_t) debut ) ? fin : fin + 1;
+		if( reprise > longueur ) break;
+		debut = bitset_suivant( debuts, nb_mots, (long) reprise );
+	}
+	xfree( debuts );
+	return nb;
+}
@@ -0,0 +1,138 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file recherche.h */
+
+#ifndef __RECHERCHE_H__
+#define __RECHERCHE_H__
+
+#include "automate.h"
+#include "afd.h"
+
+#include <stddef.h>
+
+/**
+ * @brief Mode de rechercher_toutes() : occurrences disjointes, chacune la
+ *        plus à gauche puis la plus longue après la précédente.
+ */
+#define RECHERCHE_DISJOINTES 0
+
+/**
+ * @brief Mode de rechercher_toutes() : pour chaque position où se termine
+ *        une occurrence, l'occurrence la plus longue qui s'y termine.
+ */
+#define RECHERCHE_CHEVAUCHANTES 1
+
+/**
+ * @brief Une occurrence : les octets texte[debut] ... texte[fin-1].
+ */
+typedef struct Occurrence {
+	size_t debut;
+	size_t fin;
+} Occurrence;
+
+/**
+ * @brief Le type d'un moteur de recherche des occurrences d'un langage L
+ *        dans un texte.
+ *
+ * Le moteur contient quatre Afd émondés (un octet qui ne mène nulle part
+ * mène à l'état mort, et la lecture s'arrête) :
+ *  - avant reconnaît L ;
+ *  - arriere reconnaît le miroir de L ;
+ *  - avant_non_ancre reconnaît Σ*.L : après la lecture de texte[0 .. i-1],
+ *    son état est final si et seulement si une occurrence finit en i ;
+ *  - arriere_non_ancre reconnaît Σ*.miroir(L) : après la lecture, de droite
+ *    à gauche, de texte[i .. n-1], son état est final si et seulement si une
+ *    occurrence commence en i.
+ * Dans les deux derniers, les octets qui ne sont pas dans l'alphabet
+ * ramènent à l'état initial, puisqu'aucune occurrence ne les contient.
+ *
+ * Un moteur n'est jamais modifié après sa création : il peut être utilisé
+ * par plusieurs fils d'exécution à la fois.
+ */
+typedef struct Recherche {
+	Afd * avant;
+	Afd * arriere;
+	Afd * avant_non_ancre;
+	Afd * arriere_non_ancre;
+} Recherche;
+
+/**
+ * @brief Crée le moteur de recherche des occurrences du langage d'un
+ *        automate.
+ *
+ * @param automate Un automate, déterministe ou non.
+ * @return Le moteur de recherche.
+ */
+Recherche * creer_recherche( const Automate * automate );
+
+/**
+ * @brief Libère la mémoire d'un moteur de recherche.
+ *
+ * @param recherche Un moteur de recherche.
+ */
+void liberer_recherche( Recherche * recherche );
+
+/**
+ * @brief Cherche l'occurrence la plus à gauche, puis la plus longue parmi
+ *        celles qui commencent à cette position.
+ *
+ * Le texte est lu une fois de droite à gauche pour trouver le début de
+ * l'occurrence, puis de gauche à droite depuis ce début jusqu'à ce que
+ * l'Afd avant atteigne l'état mort. La fonction n'alloue pas de mémoire.
+ *
+ * @param recherche Un moteur de recherche.
+ * @param texte Un tableau d'octets.
+ * @param longueur Le nombre d'octets du texte.
+ * @param occurrence L'adresse où écrire l'occurrence trouvée.
+ * @return 1 si une occurrence a été trouvée, 0 sinon.
+ */
+int rechercher_premiere(
+	const Recherche * recherche, const char * texte, size_t longueur,
+	Occurrence * occurrence
+);
+
+/**
+ * @brief Cherche toutes les occurrences, selon le mode.
+ *
+ * En mode RECHERCHE_DISJOINTES, chaque occurrence est la plus à gauche puis
+ * la plus longue parmi celles qui commencent à la fin de la précédente ou
+ * après ; une occurrence vide est suivie d'une recherche à la position
+ * suivante. Les débuts possibles sont marqués par une seule lecture du
+ * texte de droite à gauche.
+ *
+ * En mode RECHERCHE_CHEVAUCHANTES, les fins possibles sont trouvées par une
+ * seule lecture du texte de gauche à droite, et le début de chaque
+ * occurrence par une lecture de droite à gauche avec l'Afd arriere.
+ *
+ * Les occurrences sont rangées par fin croissante, dans un tableau alloué
+ * avec xmalloc().
+ *
+ * @param recherche Un moteur de recherche.
+ * @param texte Un tableau d'octets.
+ * @param longueur Le nombre d'octets du texte.
+ * @param mode RECHERCHE_DISJOINTES ou RECHERCHE_CHEVAUCHANTES.
+ * @param occurrences L'adresse où écrire le tableau des occurrences.
+ * @return Le nombre d'occurrences.
+ */
+size_t rechercher_toutes(
+	const Recherche * recherche, const char * texte, size_t longueur,
+	int mode, Occurrence ** occurrences
+);
+
+#endif
@@ -0,0 +1,481 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define _GNU_SOURCE
+
+#include "sauvegarde.h"
+#include "bitset.h"
+#include "outils.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define SIGNATURE_SAUVEGARDE "IT2AUTOM"
+#define TAILLE_ENTETE 64
+#define TYPE_AUTOMATE 1
+#define TYPE_AFD 2
+
+#define NB_SECTIONS_AUTOMATE 5
+#define SECTION_ETATS 0
+#define SECTION_INITIAUX 1
+#define SECTION_FINAUX 2
+#define SECTION_ALPHABET 3
+#define SECTION_TRANSITIONS 4
+
+#define NB_SECTIONS_AFD 5
+#define SECTION_DESCRIPTION 0
+#define SECTION_CLASSES 1
+#define SECTION_SUIVANT 2
+#define SECTION_FINAUX_AFD 3
+#define SECTION_ETATS_AFD 4
+
+/*
+ * Positions des champs de l'entête.
+ */
+#define POSITION_VERSION 8
+#define POSITION_TYPE 12
+#define POSITION_TAILLE 16
+#define POSITION_SOMME 24
+#define POSITION_NB_SECTIONS 32
+
+int hote_petit_boutiste(){
+	const uint16_t un = 1;
+	return *(const unsigned char *) &un == 1;
+}
+
+/*
+ * Copie n éléments de 'taille_element' octets, en passant de l'ordre des
+ * octets du processeur à l'ordre petit-boutiste (ou l'inverse : c'est la
+ * même opération). 'destination' et 'source' peuvent être égaux.
+ */
+void copier_petit_boutiste(
+	void * destination, const void * source, size_t n, size_t taille_element
+){
+	if( hote_petit_boutiste() || taille_element == 1 ){
+		if( destination != source ) memmove( destination, source, n * taille_element );
+		return;
+	}
+	unsigned char * d = (unsigned char *) destination;
+	const unsigned char * s = (const unsigned char *) source;
+	size_t i, k;
+	for( i = 0; i < n; i++ ){
+		for( k = 0; k < taille_element / 2; k++ ){
+			unsigned char x = s[ i*taille_element + k ];
+			d[ i*taille_element + k ] = s[ i*taille_element + taille_element - 1 - k ];
+			d[ i*taille_element + taille_element - 1 - k ] = x;
+		}
+	}
+}
+
+uint64_t lire_u64( const unsigned char * p ){
+	uint64_t x;
+	copier_petit_boutiste( &x, p, 1, sizeof(x) );
+	return x;
+}
+
+uint32_t lire_u32( const unsigned char * p ){
+	uint32_t x;
+	copier_petit_boutiste( &x, p, 1, sizeof(x) );
+	return x;
+}
+
+uint16_t lire_u16( const unsigned char * p ){
+	uint16_t x;
+	copier_petit_boutiste( &x, p, 1, sizeof(x) );
+	return x;
+}
+
+void ecrire_u64( unsigned char * p, uint64_t x ){
+	copier_petit_boutiste( p, &x, 1, sizeof(x) );
+}
+
+void ecrire_u32( unsigned char * p, uint32_t x ){
+	copier_petit_boutiste( p, &x, 1, sizeof(x) );
+}
+
+/*
+ * Somme de contrôle (FNV-1a sur des mots de 64 bits petit-boutistes) ;
+ * 'taille' est un multiple de 8.
+ */
+uint64_t somme_de_controle( const unsigned char * octets, size_t taille ){
+	uint64_t h = BITSET_HACHE_INITIAL;
+	size_t i;
+	for( i = 0; i < taille; i += 8 ){
+		h ^= lire_u64( octets + i );
+		h *= 0x100000001b3ULL;
+	}
+	return h;
+}
+
+/*
+ * Image en mémoire d'un fichier en cours de construction.
+ */
+typedef struct {
+	unsigned char * octets;
+	size_t taille;
+	size_t capacite;
+	int nb_sections;
+} Image_sauvegarde;
+
+void agrandir_image( Image_sauvegarde * image, size_t taille ){
+	if( taille <= image->capacite ) return;
+	while( taille > image->capacite ) image->capacite *= 2;
+	image->octets = xrealloc( image->octets, image->capacite );
+}
+
+/*
+ * Crée une image avec un entête vide et une table de 'nb_sections'
+ * sections.
+ */
+void initialiser_image( Image_sauvegarde * image, int nb_sections ){
+	image->capacite = 4096;
+	image->octets = xmalloc( image->capacite );
+	image->nb_sections = nb_sections;
+	image->taille = TAILLE_ENTETE + 16 * (size_t) nb_sections;
+	agrandir_image( image, image->taille );
+	memset( image->octets, 0, image->taille );
+}
+
+/*
+ * Ajoute la section i, formée de n éléments de 'taille_element' octets
+ * écrits dans l'ordre petit-boutiste.
+ */
+void ajouter_section(
+	Image_sauvegarde * image, int i, const void * elements, size_t n,
+	size_t taille_element
+){
+	size_t debut = ( image->taille + 7 ) & ~(size_t) 7;
+	size_t taille = n * taille_element;
+	agrandir_image( image, debut + taille + 8 );
+	memset( image->octets + image->taille, 0, debut - image->taille );
+	if( n > 0 ){
+		copier_petit_boutiste( image->octets + debut, elements, n, taille_element );
+	}
+	image->taille = debut + taille;
+	ecrire_u64( image->octets + TAILLE_ENTETE + 16*i, debut );
+	ecrire_u64( image->octets + TAILLE_ENTETE + 16*i + 8, taille );
+}
+
+/*
+ * Complète l'entête, puis écrit l'image dans un fichier temporaire renommé
+ * ensuite en 'chemin'. Libère l'image.
+ */
+int ecrire_image( Image_sauvegarde * image, int type, const char * chemin ){
+	size_t fin = ( image->taille + 7 ) & ~(size_t) 7;
+	agrandir_image( image, fin );
+	memset( image->octets + image->taille, 0, fin - image->taille );
+	image->taille = fin;
+
+	memcpy( image->octets, SIGNATURE_SAUVEGARDE, 8 );
+	ecrire_u32( image->octets + POSITION_VERSION, VERSION_SAUVEGARDE );
+	ecrire_u32( image->octets + POSITION_TYPE, type );
+	ecrire_u64( image->octets + POSITION_TAILLE, image->taille );
+	ecrire_u32( image->octets + POSITION_NB_SECTIONS, image->nb_sections );
+	ecrire_u64(
+		image->octets + POSITION_SOMME,
+		somme_de_controle(
+			image->octets + TAILLE_ENTETE, image->taille - TAILLE_ENTETE
+		)
+	);
+
+	size_t longueur = strlen( chemin );
+	char * temporaire = xmalloc( longueur + 5 );
+	memcpy( temporaire, chemin, longueur );
+	memcpy( temporaire + longueur, ".tmp", 5 );
+	FILE * f = fopen( temporaire, "wb" );
+	int ok = f != NULL;
+	if( ok ) ok = fwrite( image->octets, 1, image->taille, f ) == image->taille;
+	if( f ) ok = ( fclose( f ) == 0 ) && ok;
+	if( ok ) ok = rename( temporaire, chemin ) == 0;
+	if( ! ok ) remove( temporaire );
+	xfree( temporaire );
+	xfree( image->octets );
+	return ok;
+}
+
+/*
+ * Un fichier projeté en mémoire, dont l'entête et la table des sections
+ * ont été vérifiés.
+ */
+typedef struct {
+	unsigned char * octets;
+	size_t taille;
+	int nb_sections;
+} Fichier_sauvegarde;
+
+const unsigned char * section( const Fichier_sauvegarde * f, int i, size_t * taille ){
+	const unsigned char * entree = f->octets + TAILLE_ENTETE + 16*i;
+	*taille = lire_u64( entree + 8 );
+	return f->octets + lire_u64( entree );
+}
+
+/*
+ * Projette le fichier et vérifie son entête, sa table des sections (qui
+ * doivent être alignées et contenues dans le fichier) et, si 'verifier'
+ * vaut 1, sa somme de contrôle. Sur un processeur gros-boutiste, la
+ * projection est privée et modifiable, pour convertir les tables en place.
+ */
+int ouvrir_sauvegarde(
+	Fichier_sauvegarde * f, const char * chemin, int type, int nb_sections,
+	int verifier
+){
+	int fd = open( chemin, O_RDONLY );
+	if( fd < 0 ) return 0;
+	struct stat st;
+	if( fstat( fd, &st ) < 0 || (size_t) st.st_size < TAILLE_ENTETE ){
+		close( fd );
+		return 0;
+	}
+	f->taille = (size_t) st.st_size;
+	int protection = hote_petit_boutiste() ? PROT_READ : PROT_READ | PROT_WRITE;
+	void * p = mmap( NULL, f->taille, protection, MAP_PRIVATE, fd, 0 );
+	close( fd );
+	if( p == MAP_FAILED ) return 0;
+	f->octets = (unsigned char *) p;
+	f->nb_sections = nb_sections;
+
+	int ok = 1
+		&& memcmp( f->octets, SIGNATURE_SAUVEGARDE, 8 ) == 0
+		&& lire_u32( f->octets + POSITION_VERSION ) == VERSION_SAUVEGARDE
+		&& lire_u32( f->octets + POSITION_TYPE ) == (uint32_t) type
+		&& lire_u64( f->octets + POSITION_TAILLE ) == f->taille
+		&& f->taille % 8 == 0
+		&& lire_u32( f->octets + POSITION_NB_SECTIONS ) == (uint32_t) nb_sections
+		&& f->taille >= TAILLE_ENTETE + 16 * (size_t) nb_sections;
+	int i;
+	for( i = 0; ok && i < nb_sections; i++ ){
+		const unsigned char * entree = f->octets + TAILLE_ENTETE + 16*i;
+		uint64_t debut = lire_u64( entree ), taille = lire_u64( entree + 8 );
+		ok = debut % 8 == 0
+			&& debut >= TAILLE_ENTETE + 16 * (uint64_t) nb_sections
+			&& debut <= f->taille
+			&& taille <= f->taille - debut;
+	}
+	if( ok && verifier ){
+		ok = somme_de_controle(
+			f->octets + TAILLE_ENTETE, f->taille - TAILLE_ENTETE
+		) == lire_u64( f->octets + POSITION_SOMME );
+	}
+	if( ! ok ) munmap( f->octets, f->taille );
+	return ok;
+}
+
+void action_lister_transition( int origine, char lettre, int fin, void* data ){
+	void ** d = (void**) data;
+	int32_t ** transitions = (int32_t**) d[0];
+	size_t * nb = (size_t*) d[1];
+	size_t * capacite = (size_t*) d[2];
+	if( *nb + 3 > *capacite ){
+		*capacite *= 2;
+		*transitions = xrealloc( *transitions, *capacite * sizeof(int32_t) );
+	}
+	( *transitions )[ (*nb)++ ] = origine;
+	( *transitions )[ (*nb)++ ] = (unsigned char) lettre;
+	( *transitions )[ (*nb)++ ] = fin;
+}
+
+int32_t * ensemble_vers_int32( const Ensemble * ensemble, size_t * n ){
+	int32_t * res = xmalloc( ( taille_ensemble( ensemble ) + 1 ) * sizeof(int32_t) );
+	*n = 0;
+	Ensemble_iterateur it;
+	for(
+		it = premier_iterateur_ensemble( ensemble );
+		! iterateur_ensemble_est_vide( it );
+		it = iterateur_suivant_ensemble( it )
+	){
+		res[ (*n)++ ] = (int32_t) get_element( it );
+	}
+	return res;
+}
+
+int sauvegarder_automate( const Automate * automate, const char * chemin ){
+	Image_sauvegarde image;
+	initialiser_image( &image, NB_SECTIONS_AUTOMATE );
+	size_t n;
+	int32_t * elements = ensemble_vers_int32( get_etats( automate ), &n );
+	ajouter_section( &image, SECTION_ETATS, elements, n, sizeof(int32_t) );
+	xfree( elements );
+	elements = ensemble_vers_int32( get_initiaux( automate ), &n );
+	ajouter_section( &image, SECTION_INITIAUX, elements, n, sizeof(int32_t) );
+	xfree( elements );
+	elements = ensemble_vers_int32( get_finaux( automate ), &n );
+	ajouter_section( &image, SECTION_FINAUX, elements, n, sizeof(int32_t) );
+	xfree( elements );
+
+	unsigned char alphabet[256];
+	n = 0;
+	Ensemble_iterateur it;
+	for(
+		it = premier_iterateur_ensemble( get_alphabet( automate ) );
+		! iterateur_ensemble_est_vide( it );
+		it = iterateur_suivant_ensemble( it )
+	){
+		alphabet[ n++ ] = (unsigned char) (char) get_element( it );
+	}
+	ajouter_section( &image, SECTION_ALPHABET, alphabet, n, 1 );
+
+	size_t nb = 0, capacite = 48;
+	int32_t * transitions = xmalloc( capacite * sizeof(int32_t) );
+	void * data[3] = { &transitions, &nb, &capacite };
+	pour_toute_transition( automate, action_lister_transition, data );
+	ajouter_section( &image, SECTION_TRANSITIONS, transitions, nb, sizeof(int32_t) );
+	xfree( transitions );
+
+	return ecrire_image( &image, TYPE_AUTOMATE, chemin );
+}
+
+Automate * charger_automate( const char * chemin ){
+	Fichier_sauvegarde f;
+	if( ! ouvrir_sauvegarde( &f, chemin, TYPE_AUTOMATE, NB_SECTIONS_AUTOMATE, 1 ) ){
+		return NULL;
+	}
+	size_t taille, i;
+	for( i = 0; i < NB_SECTIONS_AUTOMATE; i++ ){
+		section( &f, i, &taille );
+		if( i != SECTION_ALPHABET && taille % 4 != 0 ) break;
+	}
+	const unsigned char * transitions = section( &f, SECTION_TRANSITIONS, &taille );
+	if( i < NB_SECTIONS_AUTOMATE || taille % 12 != 0 ){
+		munmap( f.octets, f.taille );
+		return NULL;
+	}
+	for( i = 0; i < taille; i += 12 ){
+		if( lire_u32( transitions + i + 4 ) > 255 ){
+			munmap( f.octets, f.taille );
+			return NULL;
+		}
+	}
+
+	Automate * automate = creer_automate();
+	const unsigned char * s = section( &f, SECTION_ETATS, &taille );
+	for( i = 0; i < taille; i += 4 ) ajouter_etat( automate, (int32_t) lire_u32( s + i ) );
+	s = section( &f, SECTION_INITIAUX, &taille );
+	for( i = 0; i < taille; i += 4 ){
+		ajouter_etat_initial( automate, (int32_t) lire_u32( s + i ) );
+	}
+	s = section( &f, SECTION_FINAUX, &taille );
+	for( i = 0; i < taille; i += 4 ){
+		ajouter_etat_final( automate, (int32_t) lire_u32( s + i ) );
+	}
+	s = section( &f, SECTION_ALPHABET, &taille );
+	for( i = 0; i < taille; i++ ) ajouter_lettre( automate, (char) s[i] );
+	s = section( &f, SECTION_TRANSITIONS, &taille );
+	for( i = 0; i < taille; i += 12 ){
+		ajouter_transition(
+			automate, (int32_t) lire_u32( s + i ), (char) lire_u32( s + i + 4 ),
+			(int32_t) lire_u32( s + i + 8 )
+		);
+	}
+	munmap( f.octets, f.taille );
+	return automate;
+}
+
+int sauvegarder_afd( const Afd * afd, const char * chemin ){
+	Image_sauvegarde image;
+	initialiser_image( &image, NB_SECTIONS_AFD );
+	int32_t description[4] = { afd->nb_etats, afd->nb_classes, afd->initial, 0 };
+	ajouter_section( &image, SECTION_DESCRIPTION, description, 4, sizeof(int32_t) );
+	ajouter_section( &image, SECTION_CLASSES, afd->classe, 256, sizeof(uint16_t) );
+	ajouter_section(
+		&image, SECTION_SUIVANT, afd->suivant,
+		(size_t) afd->nb_etats * afd->nb_classes, sizeof(int32_t)
+	);
+	ajouter_section(
+		&image, SECTION_FINAUX_AFD, afd->finaux,
+		BITSET_NB_MOTS( afd->nb_etats ), sizeof(uint64_t)
+	);
+	ajouter_section(
+		&image, SECTION_ETATS_AFD, afd->etats, afd->nb_etats - 1, sizeof(int32_t)
+	);
+	return ecrire_image( &image, TYPE_AFD, chemin );
+}
+
+Afd * projeter_afd( const char * chemin, int verifier ){
+	Fichier_sauvegarde f;
+	if( ! ouvrir_sauvegarde( &f, chemin, TYPE_AFD, NB_SECTIONS_AFD, verifier ) ){
+		return NULL;
+	}
+	size_t taille_description, taille_classes, taille_suivant, taille_finaux;
+	size_t taille_etats;
+	const unsigned char * description = section(
+		&f, SECTION_DESCRIPTION, &taille_description
+	);
+	const unsigned char * classes = section( &f, SECTION_CLASSES, &taille_classes );
+	unsigned char * suivant = (unsigned char *) section(
+		&f, SECTION_SUIVANT, &taille_suivant
+	);
+	unsigned char * finaux = (unsigned char *) section(
+		&f, SECTION_FINAUX_AFD, &taille_finaux
+	);
+	unsigned char * etats = (unsigned char *) section(
+		&f, SECTION_ETATS_AFD, &taille_etats
+	);
+
+	int ok = taille_description == 16 && taille_classes == 512;
+	int32_t nb_etats = 0, nb_classes = 0, initial = 0;
+	if( ok ){
+		nb_etats = (int32_t) lire_u32( description );
+		nb_classes = (int32_t) lire_u32( description + 4 );
+		initial = (int32_t) lire_u32( description + 8 );
+		ok = nb_etats >= 1 && nb_classes >= 1 && nb_classes <= 257
+			&& initial >= 0 && initial < nb_etats
+			&& taille_suivant / 4 / nb_classes == (size_t) nb_etats
+			&& taille_suivant == (size_t) nb_etats * nb_classes * 4
+			&& taille_finaux == BITSET_NB_MOTS( nb_etats ) * 8
+			&& taille_etats == (size_t) ( nb_etats - 1 ) * 4;
+	}
+	Afd * afd = NULL;
+	if( ok ){
+		afd = xmalloc( sizeof(Afd) );
+		afd->nb_etats = nb_etats;
+		afd->nb_classes = nb_classes;
+		afd->initial = initial;
+		int i;
+		for( i = 0; i < 256; i++ ){
+			afd->classe[i] = lire_u16( classes + 2*i );
+			if( afd->classe[i] >= nb_classes ) ok = 0;
+		}
+		if( ! hote_petit_boutiste() ){
+			copier_petit_boutiste( suivant, suivant, taille_suivant / 4, 4 );
+			copier_petit_boutiste( finaux, finaux, taille_finaux / 8, 8 );
+			copier_petit_boutiste( etats, etats, taille_etats / 4, 4 );
+		}
+		afd->suivant = (int32_t *) suivant;
+		afd->finaux = (uint64_t *) finaux;
+		afd->etats = (int *) etats;
+		afd->projection = f.octets;
+		afd->taille_projection = f.taille;
+	}
+	if( ok && verifier ){
+		size_t k, n = (size_t) nb_etats * nb_classes;
+		for( k = 0; k < n && ok; k++ ){
+			int32_t ligne = afd->suivant[k];
+			ok = ligne >= 0 && ligne % nb_classes == 0 && ligne / nb_classes < nb_etats;
+		}
+	}
+	if( ! ok ){
+		xfree( afd );
+		munmap( f.octets, f.taille );
+		return NULL;
+	}
+	return afd;
+}
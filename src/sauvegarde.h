@@ -0,0 +1,106 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file sauvegarde.h */
+
+#ifndef __SAUVEGARDE_H__
+#define __SAUVEGARDE_H__
+
+#include "automate.h"
+#include "afd.h"
+
+/**
+ * @brief Version du format des fichiers écrits par ce module.
+ *
+ * Un fichier d'une autre version est refusé au chargement.
+ */
+#define VERSION_SAUVEGARDE 1
+
+/**
+ * @brief Enregistre un automate dans un fichier binaire.
+ *
+ * Format (tous les entiers sont petit-boutistes, quel que soit le
+ * processeur) :
+ *  - un entête de 64 octets : la signature "IT2AUTOM", la version, le type
+ *    du contenu (1 pour un Automate, 2 pour un Afd), la taille du fichier,
+ *    une somme de contrôle des octets qui suivent l'entête et le nombre de
+ *    sections ;
+ *  - la table des sections : pour chacune, sa position dans le fichier et
+ *    sa taille en octets ;
+ *  - les sections, chacune alignée sur 8 octets.
+ * Les positions sont relatives au début du fichier : le contenu ne dépend
+ * pas de l'adresse à laquelle il est chargé.
+ *
+ * Le fichier est d'abord écrit sous un nom temporaire, puis renommé : un
+ * processus qui utilise l'ancien fichier, projeté en mémoire, n'est pas
+ * perturbé.
+ *
+ * @param automate Un automate.
+ * @param chemin Le chemin du fichier.
+ * @return 1 si l'enregistrement a réussi, 0 sinon.
+ */
+int sauvegarder_automate( const Automate * automate, const char * chemin );
+
+/**
+ * @brief Recrée un automate enregistré par sauvegarder_automate().
+ *
+ * La somme de contrôle et la cohérence des sections sont vérifiées.
+ *
+ * @param chemin Le chemin du fichier.
+ * @return L'automate, ou NULL si le fichier est illisible, d'une autre
+ *         version ou corrompu.
+ */
+Automate * charger_automate( const char * chemin );
+
+/**
+ * @brief Enregistre les tables d'un Afd dans un fichier binaire.
+ *
+ * Le format est celui de sauvegarder_automate(). Les tables sont rangées
+ * telles qu'en mémoire (sur un processeur petit-boutiste), pour pouvoir
+ * être utilisées en place par projeter_afd().
+ *
+ * @param afd Un Afd.
+ * @param chemin Le chemin du fichier.
+ * @return 1 si l'enregistrement a réussi, 0 sinon.
+ */
+int sauvegarder_afd( const Afd * afd, const char * chemin );
+
+/**
+ * @brief Charge un Afd enregistré par sauvegarder_afd(), en projetant le
+ *        fichier en mémoire.
+ *
+ * Les tables ne sont pas copiées : l'Afd lit directement les pages du
+ * fichier, que le système partage entre tous les processus qui projettent
+ * le même fichier. Le chargement ne lit que l'entête et la table des
+ * sections, en temps constant.
+ *
+ * Si 'verifier' vaut 1, la somme de contrôle est recalculée et chaque
+ * transition est vérifiée, en temps linéaire ; sinon, le fichier est
+ * supposé intègre. Sur un processeur gros-boutiste, les tables sont
+ * converties dans une copie privée des pages.
+ *
+ * L'Afd est libéré par liberer_afd(), qui supprime la projection.
+ *
+ * @param chemin Le chemin du fichier.
+ * @param verifier 1 pour vérifier tout le contenu du fichier, 0 sinon.
+ * @return L'Afd, ou NULL si le fichier est illisible, d'une autre version
+ *         ou corrompu.
+ */
+Afd * projeter_afd( const char * chemin, int verifier );
+
+#endif
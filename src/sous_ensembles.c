@@ -0,0 +1,225 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "sous_ensembles.h"
+#include "outils.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+	size_t debut;		// indice du premier élément dans la zone
+	int taille;
+	uint64_t hache;
+} Sous_ensemble;
+
+struct Table_sous_ensembles {
+	int * zone;			// éléments de tous les sous-ensembles, bout à bout
+	size_t taille_zone;
+	size_t capacite_zone;
+
+	Sous_ensemble * sous_ensembles;
+	int nb_sous_ensembles;
+	int capacite_sous_ensembles;
+
+	int * alveoles;		// adressage ouvert : numéro ou -1
+	size_t nb_alveoles;	// puissance de 2
+};
+
+Table_sous_ensembles * creer_table_sous_ensembles(){
+	Table_sous_ensembles * res = xmalloc( sizeof(Table_sous_ensembles) );
+	res->capacite_zone = 1024;
+	res->taille_zone = 0;
+	res->zone = xmalloc( res->capacite_zone * sizeof(int) );
+	res->capacite_sous_ensembles = 64;
+	res->nb_sous_ensembles = 0;
+	res->sous_ensembles = xmalloc(
+		res->capacite_sous_ensembles * sizeof(Sous_ensemble)
+	);
+	res->nb_alveoles = 128;
+	res->alveoles = xmalloc( res->nb_alveoles * sizeof(int) );
+	memset( res->alveoles, -1, res->nb_alveoles * sizeof(int) );
+	return res;
+}
+
+void liberer_table_sous_ensembles( Table_sous_ensembles * table ){
+	xfree( table->zone );
+	xfree( table->sous_ensembles );
+	xfree( table->alveoles );
+	xfree( table );
+}
+
+uint64_t hacher_sous_ensemble( const int * elements, int taille ){
+	uint64_t h = 0x9e3779b97f4a7c15ULL ^ (uint64_t) taille;
+	int i;
+	for( i = 0; i < taille; i++ ){
+		h ^= (uint32_t) elements[i];
+		h *= 0xff51afd7ed558ccdULL;
+		h ^= h >> 32;
+	}
+	h ^= h >> 29;
+	h *= 0xc4ceb9fe1a85ec53ULL;
+	h ^= h >> 32;
+	return h;
+}
+
+int sous_ensemble_est_egal(
+	const Table_sous_ensembles * table, int id,
+	const int * elements, int taille, uint64_t hache
+){
+	const Sous_ensemble * s = &( table->sous_ensembles[id] );
+	return s->hache == hache && s->taille == taille && (
+		taille == 0 ||
+		memcmp( table->zone + s->debut, elements, taille * sizeof(int) ) == 0
+	);
+}
+
+/*
+ * Renvoie l'indice de l'alvéole contenant le sous-ensemble, ou de l'alvéole
+ * libre où il faudrait l'insérer.
+ */
+size_t chercher_alveole(
+	const Table_sous_ensembles * table, const int * elements, int taille,
+	uint64_t hache
+){
+	size_t masque = table->nb_alveoles - 1;
+	size_t i = (size_t) hache & masque;
+	while( table->alveoles[i] != -1 ){
+		if(
+			sous_ensemble_est_egal(
+				table, table->alveoles[i], elements, taille, hache
+			)
+		) break;
+		i = ( i + 1 ) & masque;
+	}
+	return i;
+}
+
+void agrandir_alveoles( Table_sous_ensembles * table ){
+	xfree( table->alveoles );
+	table->nb_alveoles *= 2;
+	table->alveoles = xmalloc( table->nb_alveoles * sizeof(int) );
+	memset( table->alveoles, -1, table->nb_alveoles * sizeof(int) );
+	size_t masque = table->nb_alveoles - 1;
+	int id;
+	for( id = 0; id < table->nb_sous_ensembles; id++ ){
+		size_t i = (size_t) table->sous_ensembles[id].hache & masque;
+		while( table->alveoles[i] != -1 ) i = ( i + 1 ) & masque;
+		table->alveoles[i] = id;
+	}
+}
+
+int trouver_sous_ensemble(
+	const Table_sous_ensembles * table, const int * elements, int taille
+){
+	uint64_t hache = hacher_sous_ensemble( elements, taille );
+	return table->alveoles[ chercher_alveole( table, elements, taille, hache ) ];
+}
+
+int interner_sous_ensemble(
+	Table_sous_ensembles * table, const int * elements, int taille,
+	int * nouveau
+){
+	uint64_t hache = hacher_sous_ensemble( elements, taille );
+	size_t i = chercher_alveole( table, elements, taille, hache );
+	if( table->alveoles[i] != -1 ){
+		if( nouveau ) *nouveau = 0;
+		return table->alveoles[i];
+	}
+
+	// Copie du sous-ensemble dans la zone
+	if( table->taille_zone + taille > table->capacite_zone ){
+		while( table->taille_zone + taille > table->capacite_zone ){
+			table->capacite_zone *= 2;
+		}
+		table->zone = xrealloc( table->zone, table->capacite_zone * sizeof(int) );
+	}
+	if( taille > 0 ){
+		memcpy( table->zone + table->taille_zone, elements, taille * sizeof(int) );
+	}
+	if( table->nb_sous_ensembles == table->capacite_sous_ensembles ){
+		table->capacite_sous_ensembles *= 2;
+		table->sous_ensembles = xrealloc(
+			table->sous_ensembles,
+			table->capacite_sous_ensembles * sizeof(Sous_ensemble)
+		);
+	}
+	int id = table->nb_sous_ensembles++;
+	table->sous_ensembles[id].debut = table->taille_zone;
+	table->sous_ensembles[id].taille = taille;
+	table->sous_ensembles[id].hache = hache;
+	table->taille_zone += taille;
+
+	table->alveoles[i] = id;
+	// On garde un taux de remplissage inférieur à 1/2
+	if( 2 * (size_t) table->nb_sous_ensembles > table->nb_alveoles ){
+		agrandir_alveoles( table );
+	}
+	if( nouveau ) *nouveau = 1;
+	return id;
+}
+
+const int * get_sous_ensemble(
+	const Table_sous_ensembles * table, int id, int * taille
+){
+	*taille = table->sous_ensembles[id].taille;
+	return table->zone + table->sous_ensembles[id].debut;
+}
+
+int nombre_de_sous_ensembles( const Table_sous_ensembles * table ){
+	return table->nb_sous_ensembles;
+}
+
+size_t memoire_table_sous_ensembles( const Table_sous_ensembles * table ){
+	return sizeof(Table_sous_ensembles)
+		+ table->capacite_zone * sizeof(int)
+		+ (size_t) table->capacite_sous_ensembles * sizeof(Sous_ensemble)
+		+ table->nb_alveoles * sizeof(int);
+}
+
+size_t memoire_ajout_sous_ensemble(
+	const Table_sous_ensembles * table, int taille
+){
+	size_t res = 0;
+	size_t capacite = table->capacite_zone;
+	while( table->taille_zone + taille > capacite ) capacite *= 2;
+	res += ( capacite - table->capacite_zone ) * sizeof(int);
+	if( table->nb_sous_ensembles == table->capacite_sous_ensembles ){
+		res += (size_t) table->capacite_sous_ensembles * sizeof(Sous_ensemble);
+	}
+	if( 2 * (size_t) ( table->nb_sous_ensembles + 1 ) > table->nb_alveoles ){
+		res += table->nb_alveoles * sizeof(int);
+	}
+	return res;
+}
+
+int comparer_entiers( const void * a, const void * b ){
+	int x = *(const int*) a;
+	int y = *(const int*) b;
+	return ( x > y ) - ( x < y );
+}
+
+int normaliser_sous_ensemble( int * elements, int taille ){
+	if( taille <= 1 ) return taille;
+	qsort( elements, taille, sizeof(int), comparer_entiers );
+	int i, n = 1;
+	for( i = 1; i < taille; i++ ){
+		if( elements[i] != elements[n-1] ) elements[n++] = elements[i];
+	}
+	return n;
+}
@@ -0,0 +1,113 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __SOUS_ENSEMBLES_H__
+#define __SOUS_ENSEMBLES_H__
+
+#include <stdint.h>
+#include <stddef.h>
+
+/*
+ * Définit le type d'une table de sous-ensembles internés.
+ *
+ * Chaque sous-ensemble d'entiers est stocké une seule fois, sous forme
+ * canonique (tableau trié sans doublon), dans une zone mémoire partagée par
+ * toute la table. Les sous-ensembles sont numérotés de 0 à n-1 dans l'ordre
+ * où ils sont internés et sont retrouvés à l'aide d'un haché sur 64 bits.
+ *
+ * Cette table remplace, pour la construction des sous-ensembles, les tables
+ * indexées par des copies d'Ensemble : la recherche d'un sous-ensemble
+ * coûte un calcul de haché et, en cas de collision, une comparaison de
+ * tableaux contigus.
+ *
+ * La table peut aussi servir à numéroter des n-uplets d'entiers : il suffit
+ * de les interner sans les trier.
+ */
+typedef struct Table_sous_ensembles Table_sous_ensembles;
+
+/*
+ * Crée une table vide.
+ */
+Table_sous_ensembles * creer_table_sous_ensembles();
+
+/*
+ * Libère la mémoire de la table et de tous les sous-ensembles internés.
+ */
+void liberer_table_sous_ensembles( Table_sous_ensembles * table );
+
+/*
+ * Renvoie le haché du tableau 'elements' de taille 'taille'.
+ */
+uint64_t hacher_sous_ensemble( const int * elements, int taille );
+
+/*
+ * Interne le sous-ensemble codé par le tableau trié, sans doublon,
+ * 'elements' de taille 'taille', et renvoie son numéro.
+ *
+ * Si le sous-ensemble n'était pas encore dans la table, il y est copié,
+ * il reçoit le premier numéro libre, et '*nouveau' est mis à 1 (si
+ * 'nouveau' n'est pas NULL). Sinon '*nouveau' est mis à 0.
+ */
+int interner_sous_ensemble(
+	Table_sous_ensembles * table, const int * elements, int taille,
+	int * nouveau
+);
+
+/*
+ * Renvoie le numéro du sous-ensemble s'il est dans la table, et -1 sinon.
+ */
+int trouver_sous_ensemble(
+	const Table_sous_ensembles * table, const int * elements, int taille
+);
+
+/*
+ * Renvoie le tableau trié des éléments du sous-ensemble de numéro 'id'.
+ * Sa taille est écrite dans '*taille'.
+ *
+ * Le pointeur renvoyé n'est valable que jusqu'au prochain appel à
+ * interner_sous_ensemble().
+ */
+const int * get_sous_ensemble(
+	const Table_sous_ensembles * table, int id, int * taille
+);
+
+/*
+ * Renvoie le nombre de sous-ensembles internés.
+ */
+int nombre_de_sous_ensembles( const Table_sous_ensembles * table );
+
+/*
+ * Renvoie la mémoire, en octets, allouée par la table (capacités comprises).
+ */
+size_t memoire_table_sous_ensembles( const Table_sous_ensembles * table );
+
+/*
+ * Renvoie la mémoire, en octets, que la table allouerait en plus pour
+ * interner un nouveau sous-ensemble de 'taille' éléments.
+ */
+size_t memoire_ajout_sous_ensemble(
+	const Table_sous_ensembles * table, int taille
+);
+
+/*
+ * Trie un tableau d'entiers et supprime les doublons.
+ * Renvoie la nouvelle taille.
+ */
+int normaliser_sous_ensemble( int * elements, int taille );
+
+#endif
@@ -0,0 +1,154 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "afd.h"
+#include "bitset.h"
+#include "outils.h"
+
+#include <stdlib.h>
+
+#define NB_MOTS_LOT 1000
+#define LONGUEUR_MAX_LOT 24
+
+/*
+ * Compare afd_reconnait_lot() à afd_reconnait_tampon() sur des mots
+ * aléatoires de longueurs variées, dont certains contiennent des lettres
+ * hors de l'alphabet.
+ */
+int verifier_lot( const Afd * afd ){
+	static char tampon[ NB_MOTS_LOT * LONGUEUR_MAX_LOT ];
+	const char * mots[ NB_MOTS_LOT ];
+	size_t longueurs[ NB_MOTS_LOT ];
+	uint64_t resultats[ BITSET_NB_MOTS( NB_MOTS_LOT ) ];
+	size_t i, k;
+	for( i = 0; i < NB_MOTS_LOT; i++ ){
+		mots[i] = tampon + i * LONGUEUR_MAX_LOT;
+		longueurs[i] = rand() % LONGUEUR_MAX_LOT;
+		for( k = 0; k < longueurs[i]; k++ ){
+			tampon[ i * LONGUEUR_MAX_LOT + k ] = 
+				( rand() % 50 == 0 ) ? 'z' : "abc"[ rand() % 3 ];
+		}
+	}
+	int ok = 1;
+	size_t nb;
+	// Lots complets et lots plus petits que AFD_LOT
+	for( nb = 0; nb <= NB_MOTS_LOT; nb += ( nb < 20 ) ? 1 : 245 ){
+		afd_reconnait_lot( afd, mots, longueurs, nb, resultats );
+		for( i = 0; i < nb; i++ ){
+			if(
+				BITSET_TEST( resultats, i ) !=
+				afd_reconnait_tampon( afd, mots[i], longueurs[i] )
+			) ok = 0;
+		}
+	}
+	return ok;
+}
+
+
+int test_afd(){
+
+	int result = 1;
+
+	// Mots sur {a, b} dont l'avant-dernière lettre est un 'a'
+	Automate * automate = creer_automate();
+	ajouter_etat_initial( automate, 0 );
+	ajouter_etat_final( automate, 2 );
+	ajouter_transition( automate, 0, 'a', 0 );
+	ajouter_transition( automate, 0, 'b', 0 );
+	ajouter_transition( automate, 0, 'a', 1 );
+	ajouter_transition( automate, 1, 'a', 2 );
+	ajouter_transition( automate, 1, 'b', 2 );
+
+	TEST( creer_afd( automate ) == NULL, result );
+
+	Automate * deterministe = creer_automate_deterministe( automate );
+	Afd * afd = creer_afd( deterministe );
+
+	TEST(
+		1
+		&& afd
+		&& afd->nb_etats == taille_ensemble( get_etats( deterministe ) ) + 1
+		&& afd->nb_classes == 3
+		&& afd_reconnait( afd, "ab" )
+		&& afd_reconnait( afd, "bbaa" )
+		&& ! afd_reconnait( afd, "" )
+		&& ! afd_reconnait( afd, "aba" )
+		&& ! afd_reconnait( afd, "abc" )
+		&& afd_reconnait_tampon( afd, "abc", 2 )
+		&& ! afd_reconnait_tampon( afd, "abc", 3 )
+		&& afd_lire( afd, "bcaa", 4 ) == AFD_MORT
+		&& afd_suivant( afd, AFD_MORT, 'a' ) == AFD_MORT
+		, result
+	);
+
+	srand( 20 );
+	{
+		int ok = verifier_lot( afd );
+		TEST( ok, result );
+	}
+
+	liberer_afd( afd );
+	liberer_automate( deterministe );
+	liberer_automate( automate );
+
+	// Une table trop grande pour les caches, lue par lots entrelacés
+	{
+		int n = 70000, q;
+		Automate * grand = creer_automate();
+		ajouter_etat_initial( grand, 0 );
+		for( q = 0; q < n; q++ ){
+			ajouter_transition( grand, q, 'a', ( q + 1 ) % n );
+			ajouter_transition( grand, q, 'b', ( 2 * q ) % n );
+			if( q % 7 ) ajouter_transition( grand, q, 'c', ( 3 * q + 1 ) % n );
+			if( q % 3 == 0 ) ajouter_etat_final( grand, q );
+		}
+		Afd * afd_grand = creer_afd( grand );
+		int ok = verifier_lot( afd_grand );
+		TEST( ok && afd_grand->nb_etats * afd_grand->nb_classes > ( 1 << 18 ), result );
+		liberer_afd( afd_grand );
+		liberer_automate( grand );
+	}
+
+	{
+		Automate * vide = creer_automate();
+		ajouter_transition( vide, 1, 'a', 2 );
+		Afd * afd_vide = creer_afd( vide );
+		TEST(
+			1
+			&& afd_vide
+			&& afd_vide->initial == AFD_MORT
+			&& ! afd_reconnait( afd_vide, "" )
+			&& ! afd_reconnait( afd_vide, "a" )
+			, result
+		);
+		liberer_afd( afd_vide );
+		liberer_automate( vide );
+	}
+
+	return result;
+}
+
+
+
+int main(){
+
+	if( ! test_afd() ){ return 1; }
+
+	return 0;
+}
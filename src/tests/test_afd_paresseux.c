@@ -0,0 +1,127 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "afd_paresseux.h"
+#include "outils.h"
+
+#include <stdlib.h>
+
+
+int test_afd_paresseux(){
+
+	int result = 1;
+
+	// Mots sur {a, b} dont l'avant-dernière lettre est un 'a'
+	Automate * automate = creer_automate();
+	ajouter_etat_initial( automate, 0 );
+	ajouter_etat_final( automate, 2 );
+	ajouter_transition( automate, 0, 'a', 0 );
+	ajouter_transition( automate, 0, 'b', 0 );
+	ajouter_transition( automate, 0, 'a', 1 );
+	ajouter_transition( automate, 1, 'a', 2 );
+	ajouter_transition( automate, 1, 'b', 2 );
+
+	{
+		Afd_paresseux * afd = creer_afd_paresseux( automate, 1 << 20 );
+		int premiere_lecture =
+			afd_paresseux_reconnait( afd, "ab" )
+			&& afd->nb_echecs == 2 && afd->nb_succes == 0;
+		int deuxieme_lecture =
+			afd_paresseux_reconnait( afd, "ab" )
+			&& afd->nb_echecs == 2 && afd->nb_succes == 2;
+		// TEST() évalue deux fois son argument : les lectures sont faites avant
+		int ok =
+			1
+			&& afd->nb_etats == 3
+			&& premiere_lecture
+			&& deuxieme_lecture
+			&& afd_paresseux_reconnait( afd, "bbaa" )
+			&& ! afd_paresseux_reconnait( afd, "" )
+			&& ! afd_paresseux_reconnait( afd, "aba" )
+			&& ! afd_paresseux_reconnait( afd, "abc" )
+			&& ! afd_paresseux_reconnait( afd, "cab" )
+			&& afd_paresseux_reconnait_tampon( afd, "abc", 2 )
+			&& afd->nb_vidages == 0;
+		TEST( ok, result );
+		remettre_a_zero_compteurs_afd_paresseux( afd );
+		TEST( afd->nb_succes == 0 && afd->nb_echecs == 0, result );
+		liberer_afd_paresseux( afd );
+	}
+
+	// Sans mémoire : la table est vidée à chaque nouvel état, mais les
+	// réponses ne changent pas
+	{
+		Afd_paresseux * afd = creer_afd_paresseux( automate, 0 );
+		int ok =
+			1
+			&& afd_paresseux_reconnait( afd, "ab" )
+			&& afd_paresseux_reconnait( afd, "bbaa" )
+			&& ! afd_paresseux_reconnait( afd, "aba" )
+			&& afd_paresseux_reconnait( afd, "babaabbab" )
+			&& afd->nb_vidages > 0;
+		TEST( ok, result );
+		liberer_afd_paresseux( afd );
+	}
+
+	liberer_automate( automate );
+
+	// Mots dont la dixième lettre avant la fin est un 'a' : 1024 états. La
+	// mémoire comptée, capacités comprises, ne dépasse jamais le maximum.
+	{
+		Automate * automate = creer_automate();
+		int i, k;
+		ajouter_etat_initial( automate, 0 );
+		ajouter_transition( automate, 0, 'a', 0 );
+		ajouter_transition( automate, 0, 'b', 0 );
+		ajouter_transition( automate, 0, 'a', 1 );
+		for( i = 1; i < 10; i++ ){
+			ajouter_transition( automate, i, 'a', i + 1 );
+			ajouter_transition( automate, i, 'b', i + 1 );
+		}
+		ajouter_etat_final( automate, 10 );
+		size_t memoire_max = 32 << 10;
+		Afd_paresseux * afd = creer_afd_paresseux( automate, memoire_max );
+		char mot[41];
+		int ok = 1;
+		srand( 12 );
+		for( k = 0; k < 200; k++ ){
+			for( i = 0; i < 40; i++ ) mot[i] = rand() % 2 ? 'a' : 'b';
+			mot[40] = '\0';
+			if( afd_paresseux_reconnait( afd, mot ) != ( mot[30] == 'a' ) ) ok = 0;
+			if( afd->memoire > memoire_max ) ok = 0;
+			if(
+				afd->memoire <
+				(size_t) afd->capacite * afd->nb_classes * sizeof(int32_t)
+			) ok = 0;
+		}
+		TEST( ok && afd->nb_vidages > 0, result );
+		liberer_afd_paresseux( afd );
+		liberer_automate( automate );
+	}
+
+	return result;
+}
+
+
+
+int main(){
+
+	if( ! test_afd_paresseux() ){ return 1; }
+
+	return 0;
+}
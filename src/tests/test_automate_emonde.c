@@ -0,0 +1,139 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "automate.h"
+#include "outils.h"
+
+
+int test_automate_emonde(){
+
+	int result = 1;
+
+	// 1 -a-> 2 -b-> 3 (final), 2 -a-> 4 (puits), 5 -a-> 3 (non accessible)
+	Automate * automate = creer_automate();
+	ajouter_etat_initial( automate, 1 );
+	ajouter_etat_final( automate, 3 );
+	ajouter_transition( automate, 1, 'a', 2 );
+	ajouter_transition( automate, 2, 'b', 3 );
+	ajouter_transition( automate, 2, 'a', 4 );
+	ajouter_transition( automate, 4, 'a', 4 );
+	ajouter_transition( automate, 5, 'a', 3 );
+	ajouter_etat( automate, 6 );
+
+	{
+		Ensemble * access = accessibles( automate );
+		Ensemble * co_access = co_accessibles( automate );
+		Ensemble * depuis_2 = etats_accessibles( automate, 2 );
+		TEST(
+			1
+			&& taille_ensemble( access ) == 4
+			&& est_dans_l_ensemble( access, 1 )
+			&& est_dans_l_ensemble( access, 4 )
+			&& ! est_dans_l_ensemble( access, 5 )
+			&& taille_ensemble( co_access ) == 4
+			&& est_dans_l_ensemble( co_access, 5 )
+			&& ! est_dans_l_ensemble( co_access, 4 )
+			&& taille_ensemble( depuis_2 ) == 3
+			&& ! est_dans_l_ensemble( depuis_2, 1 )
+			, result
+		);
+		liberer_ensemble( access );
+		liberer_ensemble( co_access );
+		liberer_ensemble( depuis_2 );
+	}
+
+	{
+		Automate * emonde = automate_emonde( automate );
+		TEST(
+			1
+			&& emonde
+			&& taille_ensemble( get_etats( emonde ) ) == 3
+			&& nombre_de_transitions( emonde ) == 2
+			&& est_une_transition_de_l_automate( emonde, 1, 'a', 2 )
+			&& est_une_transition_de_l_automate( emonde, 2, 'b', 3 )
+			&& est_un_etat_initial_de_l_automate( emonde, 1 )
+			&& est_un_etat_final_de_l_automate( emonde, 3 )
+			&& le_mot_est_reconnu( emonde, "ab" )
+			&& ! le_mot_est_reconnu( emonde, "aa" )
+			, result
+		);
+		liberer_automate( emonde );
+	}
+
+	{
+		Automate * access = automate_accessible( automate );
+		Automate * co_access = automate_co_accessible( automate );
+		TEST(
+			1
+			&& taille_ensemble( get_etats( access ) ) == 4
+			&& est_une_transition_de_l_automate( access, 4, 'a', 4 )
+			&& ! est_un_etat_de_l_automate( access, 5 )
+			&& taille_ensemble( get_etats( co_access ) ) == 4
+			&& est_une_transition_de_l_automate( co_access, 5, 'a', 3 )
+			&& ! est_un_etat_de_l_automate( co_access, 4 )
+			&& est_un_etat_initial_de_l_automate( co_access, 1 )
+			, result
+		);
+		liberer_automate( access );
+		liberer_automate( co_access );
+	}
+
+	liberer_automate( automate );
+
+	// États négatifs, et un état initial et final sans transition
+	{
+		Automate * automate = creer_automate();
+		ajouter_etat_initial( automate, -3 );
+		ajouter_etat_final( automate, -1 );
+		ajouter_transition( automate, -3, 'a', -2 );
+		ajouter_transition( automate, -2, 'a', -1 );
+		ajouter_transition( automate, -2, 'b', -5 );
+		ajouter_etat_initial( automate, 7 );
+		ajouter_etat_final( automate, 7 );
+		Automate * emonde = automate_emonde( automate );
+		Ensemble * depuis_moins_2 = etats_accessibles( automate, -2 );
+		TEST(
+			1
+			&& taille_ensemble( get_etats( emonde ) ) == 4
+			&& est_un_etat_initial_de_l_automate( emonde, 7 )
+			&& est_un_etat_final_de_l_automate( emonde, 7 )
+			&& est_une_transition_de_l_automate( emonde, -2, 'a', -1 )
+			&& ! est_un_etat_de_l_automate( emonde, -5 )
+			&& le_mot_est_reconnu( emonde, "" )
+			&& le_mot_est_reconnu( emonde, "aa" )
+			&& taille_ensemble( depuis_moins_2 ) == 3
+			&& est_dans_l_ensemble( depuis_moins_2, -5 )
+			, result
+		);
+		liberer_ensemble( depuis_moins_2 );
+		liberer_automate( emonde );
+		liberer_automate( automate );
+	}
+
+	return result;
+}
+
+
+
+int main(){
+
+	if( ! test_automate_emonde() ){ return 1; }
+
+	return 0;
+}
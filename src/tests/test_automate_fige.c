@@ -0,0 +1,157 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "automate_fige.h"
+#include "bitset.h"
+#include "outils.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+
+int test_automate_fige(){
+
+	int result = 1;
+
+	// Mots sur {a, b} dont l'avant-dernière lettre est un 'a'
+	Automate * automate = creer_automate();
+	ajouter_etat_initial( automate, -3 );
+	ajouter_etat_final( automate, 7 );
+	ajouter_transition( automate, -3, 'a', -3 );
+	ajouter_transition( automate, -3, 'b', -3 );
+	ajouter_transition( automate, -3, 'a', 4 );
+	ajouter_transition( automate, 4, 'a', 7 );
+	ajouter_transition( automate, 4, 'b', 7 );
+	ajouter_etat( automate, 10 );
+
+	Automate_fige * fige = figer_automate( automate );
+	liberer_automate( automate );
+
+	TEST(
+		1
+		&& fige
+		&& fige->nb_etats == 4
+		&& fige->nb_transitions == 5
+		&& numero_etat_fige( fige, -3 ) == 0
+		&& numero_etat_fige( fige, 10 ) == 3
+		&& numero_etat_fige( fige, 5 ) == -1
+		&& le_mot_est_reconnu_fige( fige, "ab" )
+		&& le_mot_est_reconnu_fige( fige, "bbaa" )
+		&& ! le_mot_est_reconnu_fige( fige, "" )
+		&& ! le_mot_est_reconnu_fige( fige, "aba" )
+		&& ! le_mot_est_reconnu_fige( fige, "abc" )
+		&& est_une_transition_de_l_automate_fige( fige, -3, 'a', 4 )
+		&& est_une_transition_de_l_automate_fige( fige, 4, 'b', 7 )
+		&& ! est_une_transition_de_l_automate_fige( fige, -3, 'b', 4 )
+		&& ! est_une_transition_de_l_automate_fige( fige, 10, 'a', 4 )
+		, result
+	);
+
+	{
+		size_t nb_mots = nombre_de_mots_fige( fige );
+		uint64_t * depart = xmalloc( nb_mots * sizeof(uint64_t) );
+		uint64_t * arrivee = xmalloc( nb_mots * sizeof(uint64_t) );
+		memset( depart, 0, nb_mots * sizeof(uint64_t) );
+		BITSET_AJOUTER( depart, numero_etat_fige( fige, -3 ) );
+
+		delta_fige( fige, depart, 'a', arrivee );
+		int apres_a = 
+			bitset_cardinal( arrivee, nb_mots ) == 2 &&
+			BITSET_TEST( arrivee, numero_etat_fige( fige, 4 ) );
+
+		delta_star_fige( fige, depart, "aa", arrivee );
+		int apres_aa = 
+			bitset_cardinal( arrivee, nb_mots ) == 3 &&
+			BITSET_TEST( arrivee, numero_etat_fige( fige, 7 ) );
+
+		delta_fige( fige, depart, 'c', arrivee );
+		int apres_c = bitset_est_vide( arrivee, nb_mots );
+
+		TEST( 1 && fige->masques && apres_a && apres_aa && apres_c, result );
+		xfree( depart );
+		xfree( arrivee );
+	}
+
+	liberer_automate_fige( fige );
+
+	// Trop d'états pour les masques : delta_fige() utilise les entrées
+	{
+		Automate * chaine = creer_automate();
+		int i;
+		ajouter_etat_initial( chaine, 0 );
+		ajouter_etat_final( chaine, 1000 );
+		for( i = 0; i < 1000; i++ ){
+			ajouter_transition( chaine, i, 'a', i + 1 );
+			ajouter_transition( chaine, i, 'b', 0 );
+		}
+		Automate_fige * grand = figer_automate( chaine );
+		char * mot = xmalloc( 1002 );
+		memset( mot, 'a', 1001 );
+		mot[1001] = '\0';
+		TEST(
+			1
+			&& grand->masques == NULL
+			&& ! le_mot_est_reconnu_fige( grand, mot )
+			&& le_mot_est_reconnu_fige( grand, mot + 1 )
+			, result
+		);
+		mot[0] = 'b';
+		TEST( le_mot_est_reconnu_fige( grand, mot ), result );
+		xfree( mot );
+		liberer_automate_fige( grand );
+		liberer_automate( chaine );
+	}
+
+	// Les classes de lettres de l'automate figé sont celles de l'automate
+	{
+		srand( 7 );
+		int essai, ok = 1;
+		for( essai = 0; essai < 200; essai++ ){
+			Automate * automate = creer_automate();
+			int n = 1 + rand() % 6, k;
+			for( k = 0; k < 3 * n; k++ ){
+				ajouter_transition(
+					automate, rand() % n - 2, 'a' + rand() % 5, rand() % n - 2
+				);
+			}
+			ajouter_lettre( automate, 'z' );
+			int classes[256], i;
+			int nb_classes = classes_de_lettres( automate, classes );
+			Automate_fige * fige = figer_automate( automate );
+			if( fige->nb_classes != nb_classes ) ok = 0;
+			for( i = 0; i < 256; i++ ){
+				if( fige->classe[i] != classes[i] ) ok = 0;
+			}
+			liberer_automate_fige( fige );
+			liberer_automate( automate );
+		}
+		TEST( ok, result );
+	}
+
+	return result;
+}
+
+
+
+int main(){
+
+	if( ! test_automate_fige() ){ return 1; }
+
+	return 0;
+}
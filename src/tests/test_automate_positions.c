@@ -0,0 +1,117 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "positions.h"
+#include "rationnel.h"
+#include "outils.h"
+#include "parse.h"
+#include "scan.h"
+
+#include <string.h>
+
+
+int test_automate_positions(){
+
+	int result = 1;
+
+	{
+		Rationnel * rat = expression_to_rationnel( "(a.a)*.(b*.c)*" );
+		numeroter_rationnel( rat );
+		Automate * automate = Glushkov( rat );
+		Automate_positions * positions = creer_automate_positions( automate );
+
+		TEST(
+			1
+			&& positions
+			&& positions->nb_mots == 1
+			&& ! positions_reconnait( positions, "ab" )
+			&& ! positions_reconnait( positions, "a" )
+			&& positions_reconnait( positions, "aa" )
+			&& positions_reconnait( positions, "" )
+			&& positions_reconnait( positions, "aaaabccbbbc" )
+			&& ! positions_reconnait( positions, "aaaaabccbbbc" )
+			&& ! positions_reconnait( positions, "aaaabccbbb" )
+			&& positions_reconnait_tampon( positions, "aaaabccbbbc", 10 ) == 0
+			&& positions_reconnait_tampon( positions, "aacd", 3 )
+			, result
+		);
+
+		liberer_automate_positions( positions );
+		liberer_automate( automate );
+	}
+
+	// 73 positions, donc plusieurs mots de 64 bits : on compare la
+	// simulation à le_mot_est_reconnu()
+	{
+		char expression[256] = "(a+b)*.a";
+		int i;
+		for( i = 0; i < 35; i++ ) strcat( expression, ".(a+b)" );
+		Rationnel * rat = expression_to_rationnel( expression );
+		numeroter_rationnel( rat );
+		Automate * automate = Glushkov( rat );
+		Automate_positions * positions = creer_automate_positions( automate );
+
+		char mot[64];
+		memset( mot, 'a', 40 );
+		mot[40] = '\0';
+		int ok = positions && positions->nb_mots == 2;
+		ok = ok && positions_reconnait( positions, mot );
+		ok = ok && ! positions_reconnait( positions, mot + 5 );
+		memset( mot, 'b', 40 );
+		ok = ok && ! positions_reconnait( positions, mot );
+		for( i = 0; i < 40; i += 3 ) mot[i] = 'a';
+		for( i = 0; i < 8; i++ ){
+			ok = ok && positions_reconnait( positions, mot + i )
+				== le_mot_est_reconnu( automate, mot + i );
+		}
+		char prefixe[64];
+		memcpy( prefixe, mot, 37 );
+		prefixe[37] = '\0';
+		ok = ok && positions_reconnait_tampon( positions, mot, 37 )
+			== le_mot_est_reconnu( automate, prefixe );
+		TEST( ok, result );
+
+		liberer_automate_positions( positions );
+		liberer_automate( automate );
+	}
+
+	// Deux lettres différentes arrivent dans l'état 2 : pas homogène
+	{
+		Automate * automate = creer_automate();
+		ajouter_etat_initial( automate, 0 );
+		ajouter_etat_final( automate, 2 );
+		ajouter_transition( automate, 0, 'a', 1 );
+		ajouter_transition( automate, 0, 'a', 2 );
+		ajouter_transition( automate, 1, 'b', 2 );
+
+		TEST( creer_automate_positions( automate ) == NULL, result );
+
+		liberer_automate( automate );
+	}
+
+	return result;
+}
+
+
+
+int main(){
+
+	if( ! test_automate_positions() ){ return 1; }
+
+	return 0;
+}
@@ -0,0 +1,312 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "automates_expression.h"
+#include "derivees.h"
+#include "equivalence.h"
+#include "outils.h"
+
+#include <stdlib.h>
+
+int nb_etats( const Automate * automate ){
+	return taille_ensemble( get_etats( automate ) );
+}
+
+/*
+ * Expression aléatoire sur {a, b, c} avec 'taille' lettres au plus.
+ */
+Rationnel * expression_aleatoire( int taille ){
+	if( taille <= 1 ){
+		return rand() % 8 ? Lettre( 'a' + rand() % 3 ) : Epsilon();
+	}
+	int gauche = 1 + rand() % ( taille - 1 );
+	switch( rand() % 5 ){
+		case 0:
+			return Star( expression_aleatoire( taille - 1 ) );
+		case 1:
+		case 2:
+			return Union(
+				expression_aleatoire( gauche ),
+				expression_aleatoire( taille - gauche )
+			);
+		default:
+			return Concat(
+				expression_aleatoire( gauche ),
+				expression_aleatoire( taille - gauche )
+			);
+	}
+}
+
+#define LONGUEUR_MAX 5
+
+/*
+ * correspond[ i * ( n + 1 ) + j ] vaut 1 si le facteur mot[i..j[ est dans
+ * le langage de l'expression.
+ */
+char * correspondances( const Rationnel * rat, const char * mot, int n ){
+	int m = n + 1, i, j, k;
+	char * c = xmalloc( m * m );
+	for( i = 0; i < m * m; i++ ) c[i] = 0;
+	char * g, * d;
+	switch( rat->etiquette ){
+		case EPSILON:
+			for( i = 0; i < m; i++ ) c[ i * m + i ] = 1;
+			break;
+		case LETTRE:
+			for( i = 0; i < n; i++ ) c[ i * m + i + 1 ] = mot[i] == rat->lettre;
+			break;
+		case UNION:
+			g = correspondances( rat->gauche, mot, n );
+			d = correspondances( rat->droit, mot, n );
+			for( i = 0; i < m * m; i++ ) c[i] = g[i] || d[i];
+			xfree( g );
+			xfree( d );
+			break;
+		case CONCAT:
+			g = correspondances( rat->gauche, mot, n );
+			d = correspondances( rat->droit, mot, n );
+			for( i = 0; i < m; i++ )
+				for( j = i; j < m; j++ )
+					for( k = i; k <= j; k++ )
+						if( g[ i * m + k ] && d[ k * m + j ] ) c[ i * m + j ] = 1;
+			xfree( g );
+			xfree( d );
+			break;
+		case STAR:
+			g = correspondances( rat->gauche, mot, n );
+			// Par longueur croissante
+			for( j = 0; j < m; j++ ){
+				c[ j * m + j ] = 1;
+				for( i = j - 1; i >= 0; i-- )
+					for( k = i + 1; k <= j; k++ )
+						if( g[ i * m + k ] && c[ k * m + j ] ) c[ i * m + j ] = 1;
+			}
+			xfree( g );
+			break;
+	}
+	return c;
+}
+
+int expression_reconnait( const Rationnel * rat, const char * mot, int n ){
+	char * c = correspondances( rat, mot, n );
+	int res = c[n];
+	xfree( c );
+	return res;
+}
+
+/*
+ * Compare l'automate à l'expression sur tous les mots de {a, b, c} de
+ * longueur au plus LONGUEUR_MAX.
+ */
+int meme_langage_que( const Automate * automate, const Rationnel * rat ){
+	char mot[ LONGUEUR_MAX + 1 ];
+	int n, i;
+	for( n = 0; n <= LONGUEUR_MAX; n++ ){
+		int nb_mots = 1;
+		for( i = 0; i < n; i++ ) nb_mots *= 3;
+		int code;
+		for( code = 0; code < nb_mots; code++ ){
+			int x = code;
+			for( i = 0; i < n; i++ ){
+				mot[i] = 'a' + x % 3;
+				x /= 3;
+			}
+			mot[n] = '\0';
+			if( le_mot_est_reconnu( automate, mot ) != expression_reconnait( rat, mot, n ) ){
+				return 0;
+			}
+		}
+	}
+	return 1;
+}
+
+int nb_lettres( const Rationnel * rat ){
+	switch( rat->etiquette ){
+		case LETTRE: return 1;
+		case STAR: return nb_lettres( rat->gauche );
+		case UNION:
+		case CONCAT: return nb_lettres( rat->gauche ) + nb_lettres( rat->droit );
+		default: return 0;
+	}
+}
+
+/*
+ * Vérifie que les deux constructions et le choix reconnaissent le langage
+ * de l'expression, sans avoir plus d'états que l'automate des positions.
+ */
+int verifier_constructions( Rationnel * rat ){
+	Automate * antimirov = Antimirov( rat );
+	Automate * suivants = automate_des_suivants( rat );
+	Construction construction;
+	Automate * choisi = plus_petit_automate( rat, &construction );
+	const Automate * attendu =
+		construction == CONSTRUCTION_ANTIMIROV ? antimirov : suivants;
+	int n = nb_lettres( rat ) + 1;
+	int ok = 1
+		&& meme_langage_que( antimirov, rat )
+		&& automates_equivalents( antimirov, suivants, NULL )
+		&& automates_equivalents( antimirov, choisi, NULL )
+		&& nb_etats( antimirov ) <= n
+		&& nb_etats( suivants ) <= n
+		&& nb_etats( choisi ) == nb_etats( attendu )
+		&& nb_etats( choisi ) <= nb_etats( antimirov )
+		&& nb_etats( choisi ) <= nb_etats( suivants );
+	liberer_automate( antimirov );
+	liberer_automate( suivants );
+	liberer_automate( choisi );
+	return ok;
+}
+
+/*
+ * Sans mot vide dans l'expression, les deux constructions n'ont pas plus
+ * de transitions que l'automate de Glushkov.
+ */
+int moins_de_transitions_que_glushkov( Rationnel * rat ){
+	numeroter_rationnel( rat );
+	Automate * glushkov = Glushkov( rat );
+	Automate * antimirov = Antimirov( rat );
+	Automate * suivants = automate_des_suivants( rat );
+	int ok = 1
+		&& automates_equivalents( glushkov, antimirov, NULL )
+		&& nombre_de_transitions( antimirov ) <= nombre_de_transitions( glushkov )
+		&& nombre_de_transitions( suivants ) <= nombre_de_transitions( glushkov );
+	liberer_automate( glushkov );
+	liberer_automate( antimirov );
+	liberer_automate( suivants );
+	return ok;
+}
+
+/*
+ * L'automate des dérivées (voir derivees.h) est déterministe et reconnaît
+ * le langage de l'expression.
+ */
+int verifier_derivees( Rationnel * rat ){
+	Automate * brzozowski = Brzozowski( rat );
+	int ok = est_deterministe( brzozowski ) && meme_langage_que( brzozowski, rat );
+	liberer_automate( brzozowski );
+	return ok;
+}
+
+int test_automates_expression(){
+
+	int result = 1;
+
+	{
+		Rationnel * rat = expression_to_rationnel( "a*" );
+		Automate * antimirov = Antimirov( rat );
+		TEST(
+			1
+			&& nb_etats( antimirov ) == 1
+			&& le_mot_est_reconnu( antimirov, "" )
+			&& le_mot_est_reconnu( antimirov, "aaa" )
+			&& ! le_mot_est_reconnu( antimirov, "b" )
+			, result
+		);
+		liberer_automate( antimirov );
+	}
+
+	// Les dérivées par a et par c sont toutes deux b
+	{
+		Rationnel * rat = expression_to_rationnel( "a.b+c.b" );
+		Automate * antimirov = Antimirov( rat );
+		Automate * suivants = automate_des_suivants( rat );
+		Construction construction;
+		Automate * choisi = plus_petit_automate( rat, &construction );
+		TEST(
+			1
+			&& nb_etats( antimirov ) == 3
+			&& nb_etats( suivants ) == 4
+			&& construction == CONSTRUCTION_ANTIMIROV
+			&& nb_etats( choisi ) == 3
+			&& le_mot_est_reconnu( antimirov, "cb" )
+			&& le_mot_est_reconnu( antimirov, "ab" )
+			&& ! le_mot_est_reconnu( antimirov, "b" )
+			, result
+		);
+		liberer_automate( antimirov );
+		liberer_automate( suivants );
+		liberer_automate( choisi );
+	}
+
+	// Toutes les positions ont les mêmes suivants : un seul état
+	{
+		Rationnel * rat = expression_to_rationnel( "(a*.b*)*" );
+		Automate * antimirov = Antimirov( rat );
+		Automate * suivants = automate_des_suivants( rat );
+		Construction construction;
+		Automate * choisi = plus_petit_automate( rat, &construction );
+		TEST(
+			1
+			&& nb_etats( antimirov ) == 3
+			&& nb_etats( suivants ) == 1
+			&& construction == CONSTRUCTION_SUIVANTS
+			&& nb_etats( choisi ) == 1
+			&& le_mot_est_reconnu( suivants, "abba" )
+			, result
+		);
+		liberer_automate( antimirov );
+		liberer_automate( suivants );
+		liberer_automate( choisi );
+	}
+
+	{
+		Rationnel * rat = expression_to_rationnel( "(a+b)*.a.(a+b).(a+b)" );
+		TEST( verifier_constructions( rat ), result );
+		TEST( moins_de_transitions_que_glushkov( rat ), result );
+		Automate * antimirov = Antimirov( rat );
+		TEST( nb_etats( antimirov ) == 4, result );
+		liberer_automate( antimirov );
+	}
+
+	// Le mot vide et les concaténations avec le mot vide
+	{
+		TEST( verifier_constructions( Epsilon() ), result );
+		TEST( verifier_constructions( Star( Epsilon() ) ), result );
+		TEST(
+			verifier_constructions(
+				Concat( Star( Lettre( 'a' ) ), Union( Epsilon(), Lettre( 'b' ) ) )
+			), result
+		);
+	}
+
+	{
+		srand( 4 );
+		int i, ok = 1;
+		for( i = 0; i < 300; i++ ){
+			Rationnel * rat = expression_aleatoire( 1 + i % 12 );
+			if( ! verifier_constructions( rat ) || ! verifier_derivees( rat ) ){
+				ok = 0;
+			}
+		}
+		TEST( ok, result );
+	}
+
+	TEST( meme_langage( "(a*.b*)*", "(a+b)*" ), result );
+	TEST( ! meme_langage( "(a.b)*", "(a+b)*" ), result );
+
+	return result;
+}
+
+
+
+int main(){
+
+	if( ! test_automates_expression() ){ return 1; }
+
+	return 0;
+}
@@ -0,0 +1,222 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define _GNU_SOURCE
+
+#include "cache_expressions.h"
+#include "outils.h"
+
+#include <pthread.h>
+#include <string.h>
+
+#define NB_FILS 8
+
+int reconnait( const Expression_compilee * e, const char * mot ){
+	return afd_reconnait_tampon( e->afd, mot, strlen( mot ) );
+}
+
+/*
+ * Tous les fils demandent la même expression en même temps.
+ */
+typedef struct {
+	Cache_expressions * cache;
+	pthread_barrier_t * barriere;
+	const char * expression;
+	int numero;
+	Expression_compilee * resultat;
+} Donnees_fil;
+
+void * demander_expression( void * arg ){
+	Donnees_fil * d = arg;
+	pthread_barrier_wait( d->barriere );
+	d->resultat = obtenir_expression( d->cache, d->expression );
+	return NULL;
+}
+
+/*
+ * Les fils demandent tour à tour des expressions différentes, dans un cache
+ * trop petit pour les garder toutes.
+ */
+const char * expressions_melangees[] = {
+	"a.b", "b.c", "c.d", "d.e", "(a+b)*.c", "a*.b*", "(a.b)*", "e.(d+c)"
+};
+const char * mots_melanges[] = {
+	"ab", "bc", "cd", "de", "ababc", "aabbb", "abab", "ec"
+};
+
+void * melanger_expressions( void * arg ){
+	Donnees_fil * d = arg;
+	long ok = 1;
+	int i;
+	for( i = 0; i < 2000; i++ ){
+		int k = ( i * 5 + d->numero ) % 8;
+		Expression_compilee * e =
+			obtenir_expression( d->cache, expressions_melangees[k] );
+		if( ! e || ! reconnait( e, mots_melanges[k] ) ) ok = 0;
+		if( e ) rendre_expression( e );
+	}
+	return (void *) ok;
+}
+
+int test_cache_expressions(){
+
+	int result = 1;
+	Statistiques_cache s;
+
+	// Succès, échecs, normalisation
+	{
+		Cache_expressions * cache = creer_cache_expressions( 1 << 20 );
+		Expression_compilee * e1 = obtenir_expression( cache, "(a+b)*.c" );
+		Expression_compilee * e2 = obtenir_expression( cache, " ( a + b ) * . c" );
+		TEST( e1 && e1 == e2, result );
+		TEST( e1 && reconnait( e1, "abbac" ) && ! reconnait( e1, "cab" ), result );
+		statistiques_cache_expressions( cache, &s );
+		TEST(
+			s.nb_succes == 1 && s.nb_echecs == 1 && s.nb_evictions == 0
+			&& s.nb_entrees == 1 && s.memoire == e1->taille
+			, result
+		);
+
+		Expression_compilee * mal_formee = obtenir_expression( cache, "a.(b" );
+		TEST( mal_formee == NULL, result );
+		statistiques_cache_expressions( cache, &s );
+		TEST( s.nb_echecs == 2 && s.nb_entrees == 1, result );
+
+		// Une poignée tenue survit au cache
+		rendre_expression( e2 );
+		liberer_cache_expressions( cache );
+		TEST( reconnait( e1, "c" ), result );
+		rendre_expression( e1 );
+	}
+
+	// Éviction de l'entrée utilisée le moins récemment
+	{
+		Cache_expressions * cache = creer_cache_expressions( SIZE_MAX );
+		Expression_compilee * a = obtenir_expression( cache, "(a+b)*" );
+		Expression_compilee * b = obtenir_expression( cache, "b.a" );
+		size_t budget = a->taille + b->taille;
+		rendre_expression( a );
+		rendre_expression( b );
+		liberer_cache_expressions( cache );
+
+		cache = creer_cache_expressions( budget );
+		a = obtenir_expression( cache, "(a+b)*" );
+		b = obtenir_expression( cache, "b.a" );
+		rendre_expression( a );
+		a = obtenir_expression( cache, "(a+b)*" );
+		// Même taille que "b.a"
+		Expression_compilee * c = obtenir_expression( cache, "c.a" );
+		statistiques_cache_expressions( cache, &s );
+		TEST(
+			s.nb_evictions == 1 && s.nb_entrees == 2 && s.memoire <= budget
+			, result
+		);
+		// "b.a" a été évincée, mais la poignée reste valide
+		TEST( reconnait( b, "ba" ), result );
+		rendre_expression( b );
+
+		Expression_compilee * a2 = obtenir_expression( cache, "(a+b)*" );
+		TEST( a2 == a, result );
+		rendre_expression( a2 );
+		statistiques_cache_expressions( cache, &s );
+		uint64_t echecs = s.nb_echecs;
+		b = obtenir_expression( cache, "b.a" );
+		statistiques_cache_expressions( cache, &s );
+		TEST( s.nb_echecs == echecs + 1 && reconnait( b, "ba" ), result );
+
+		rendre_expression( a );
+		rendre_expression( b );
+		rendre_expression( c );
+		liberer_cache_expressions( cache );
+	}
+
+	// Une seule compilation quand plusieurs fils demandent la même expression
+	{
+		Cache_expressions * cache = creer_cache_expressions( 1 << 20 );
+		pthread_barrier_t barriere;
+		pthread_barrier_init( &barriere, NULL, NB_FILS );
+		pthread_t fils[ NB_FILS ];
+		Donnees_fil donnees[ NB_FILS ];
+		int i;
+		for( i = 0; i < NB_FILS; i++ ){
+			donnees[i].cache = cache;
+			donnees[i].barriere = &barriere;
+			donnees[i].expression =
+				"(a+b)*.a.(a+b).(a+b).(a+b).(a+b).(a+b).(a+b).(a+b)";
+			pthread_create( fils + i, NULL, demander_expression, donnees + i );
+		}
+		for( i = 0; i < NB_FILS; i++ ) pthread_join( fils[i], NULL );
+		int memes = 1;
+		for( i = 0; i < NB_FILS; i++ ){
+			if( donnees[i].resultat != donnees[0].resultat ) memes = 0;
+		}
+		statistiques_cache_expressions( cache, &s );
+		TEST( memes && donnees[0].resultat, result );
+		TEST( s.nb_echecs == 1 && s.nb_succes == NB_FILS - 1, result );
+		for( i = 0; i < NB_FILS; i++ ) rendre_expression( donnees[i].resultat );
+		pthread_barrier_destroy( &barriere );
+		liberer_cache_expressions( cache );
+	}
+
+	// Fils concurrents dans un cache trop petit
+	{
+		Cache_expressions * cache = creer_cache_expressions( 3000 );
+		pthread_t fils[ 4 ];
+		Donnees_fil donnees[ 4 ];
+		int i;
+		for( i = 0; i < 4; i++ ){
+			donnees[i].cache = cache;
+			donnees[i].numero = i;
+			pthread_create( fils + i, NULL, melanger_expressions, donnees + i );
+		}
+		int ok = 1;
+		for( i = 0; i < 4; i++ ){
+			void * r;
+			pthread_join( fils[i], &r );
+			if( ! r ) ok = 0;
+		}
+		statistiques_cache_expressions( cache, &s );
+		TEST( ok, result );
+		TEST(
+			s.nb_succes + s.nb_echecs == 4 * 2000 && s.nb_evictions > 0
+			&& s.memoire <= 3000
+			, result
+		);
+		liberer_cache_expressions( cache );
+	}
+
+	// Le cache global
+	{
+		Cache_expressions * cache = cache_expressions_global();
+		TEST( cache == cache_expressions_global(), result );
+		Expression_compilee * e = obtenir_expression( cache, "a*" );
+		TEST( e && reconnait( e, "aaa" ), result );
+		rendre_expression( e );
+	}
+
+	return result;
+}
+
+
+
+int main(){
+
+	if( ! test_cache_expressions() ){ return 1; }
+
+	return 0;
+}
@@ -0,0 +1,107 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "automate.h"
+#include "outils.h"
+
+
+int test_classes_de_lettres(){
+
+	int result = 1;
+
+	// [abc]* d [abc] : a, b et c sont équivalentes, d est à part
+	Automate * automate = creer_automate();
+	ajouter_etat_initial( automate, 0 );
+	ajouter_etat_final( automate, 2 );
+	ajouter_transition( automate, 0, 'a', 0 );
+	ajouter_transition( automate, 0, 'b', 0 );
+	ajouter_transition( automate, 0, 'c', 0 );
+	ajouter_transition( automate, 0, 'd', 1 );
+	ajouter_transition( automate, 1, 'a', 2 );
+	ajouter_transition( automate, 1, 'b', 2 );
+	ajouter_transition( automate, 1, 'c', 2 );
+	ajouter_lettre( automate, 'e' );
+
+	{
+		int classes[256];
+		int nb = classes_de_lettres( automate, classes );
+		TEST(
+			1
+			&& nb == 3
+			&& classes['a'] == 0
+			&& classes['b'] == 0
+			&& classes['c'] == 0
+			&& classes['d'] == 1
+			&& classes['e'] == 2
+			&& classes['z'] == -1
+			, result
+		);
+	}
+
+	{
+		// Le déterminisé garde une transition par lettre
+		Automate * deterministe = creer_automate_deterministe( automate );
+		TEST(
+			1
+			&& le_mot_est_reconnu( deterministe, "abdc" )
+			&& le_mot_est_reconnu( deterministe, "da" )
+			&& ! le_mot_est_reconnu( deterministe, "dd" )
+			&& ! le_mot_est_reconnu( deterministe, "de" )
+			&& est_une_transition_de_l_automate( deterministe, 0, 'c', 0 )
+			&& est_une_transition_de_l_automate( deterministe, 0, 'b', 0 )
+			, result
+		);
+		liberer_automate( deterministe );
+	}
+
+	{
+		// b et c sont séparées par le second automate
+		Automate * automate_2 = creer_automate();
+		ajouter_etat_initial( automate_2, 0 );
+		ajouter_etat_final( automate_2, 0 );
+		ajouter_transition( automate_2, 0, 'a', 0 );
+		ajouter_transition( automate_2, 0, 'b', 0 );
+		ajouter_transition( automate_2, 0, 'd', 0 );
+		Automate * inter = creer_intersection_des_automates(
+			automate, automate_2
+		);
+		TEST(
+			1
+			&& le_mot_est_reconnu( inter, "abdb" )
+			&& ! le_mot_est_reconnu( inter, "acda" )
+			&& ! le_mot_est_reconnu( inter, "adc" )
+			, result
+		);
+		liberer_automate( inter );
+		liberer_automate( automate_2 );
+	}
+
+	liberer_automate( automate );
+
+	return result;
+}
+
+
+
+int main(){
+
+	if( ! test_classes_de_lettres() ){ return 1; }
+
+	return 0;
+}
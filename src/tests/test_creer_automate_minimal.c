@@ -154,6 +154,107 @@ int test_creer_automate_minimal(){
 		liberer_automate( automate );
 	}
 
+	{
+		Automate* automate = creer_automate();
+		Automate* minimal;		
+
+		ajouter_etat_initial( automate, 0 );
+		ajouter_etat_final( automate, 1 );
+		ajouter_transition( automate, 0, 'a', 1 );
+		ajouter_transition( automate, 0, 'b', 2 );
+		ajouter_transition( automate, 1, 'a', 1 );
+		ajouter_transition( automate, 1, 'b', 3 );
+		ajouter_transition( automate, 2, 'a', 1 );
+		ajouter_transition( automate, 2, 'b', 2 );
+		ajouter_transition( automate, 3, 'a', 1 );
+		ajouter_transition( automate, 3, 'b', 3 );
+
+		minimal = creer_automate_minimal( automate );
+
+		TEST(
+			1
+			&& est_deterministe( automate )
+			&& l_ensemble_est_egal( 2, get_etats( minimal ), 0, 1 )
+			&& l_ensemble_est_egal( 1, get_initiaux( minimal ), 0 )
+			&& l_ensemble_est_egal( 1, get_finaux( minimal ), 1 )
+			&& test_transitions_automate( 
+				4, minimal,
+				0, 'a', 1, 
+				0, 'b', 0, 
+				1, 'a', 1, 
+				1, 'b', 0 
+			),
+			resultat
+		);	
+
+		liberer_automate( minimal );
+		liberer_automate( automate );
+	}
+
+	{
+		Automate* automate = creer_automate();
+		Automate* minimal;		
+
+		ajouter_etat_initial( automate, 0 );
+		ajouter_etat_final( automate, 2 );
+		ajouter_transition( automate, 0, 'a', 1 );
+		ajouter_transition( automate, 1, 'b', 2 );
+
+		minimal = creer_automate_minimal( automate );
+
+		TEST(
+			1
+			&& l_ensemble_est_egal( 4, get_etats( minimal ), 0, 1, 2, 3 )
+			&& l_ensemble_est_egal( 1, get_initiaux( minimal ), 0 )
+			&& l_ensemble_est_egal( 1, get_finaux( minimal ), 3 )
+			&& test_transitions_automate( 
+				8, minimal,
+				0, 'a', 1, 
+				0, 'b', 2, 
+				1, 'a', 2, 
+				1, 'b', 3, 
+				2, 'a', 2, 
+				2, 'b', 2, 
+				3, 'a', 2, 
+				3, 'b', 2 
+			),
+			resultat
+		);	
+
+		liberer_automate( minimal );
+		liberer_automate( automate );
+	}
+
+	// Même langage, automate non déterministe : le résultat a la même forme
+	{
+		Automate* automate = creer_automate();
+		Automate* minimal;
+
+		ajouter_etat_initial( automate, 0 );
+		ajouter_etat_final( automate, 2 );
+		ajouter_transition( automate, 0, 'a', 1 );
+		ajouter_transition( automate, 0, 'a', 4 );
+		ajouter_transition( automate, 1, 'b', 2 );
+
+		minimal = creer_automate_minimal( automate );
+
+		TEST(
+			1
+			&& ! est_deterministe( automate )
+			&& est_deterministe( minimal )
+			&& l_ensemble_est_egal( 4, get_etats( minimal ), 0, 1, 2, 3 )
+			&& l_ensemble_est_egal( 1, get_initiaux( minimal ), 0 )
+			&& taille_ensemble( get_finaux( minimal ) ) == 1
+			&& nombre_de_transitions( minimal ) == 8
+			&& le_mot_est_reconnu( minimal, "ab" )
+			&& ! le_mot_est_reconnu( minimal, "a" ),
+			resultat
+		);
+
+		liberer_automate( minimal );
+		liberer_automate( automate );
+	}
+
 	return resultat;
 }
 
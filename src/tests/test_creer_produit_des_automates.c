@@ -0,0 +1,131 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "automate.h"
+#include "outils.h"
+
+
+int test_creer_produit_des_automates(){
+
+	int result = 1;
+
+	// automate_1 : mots contenant un 'a'
+	Automate * automate_1 = creer_automate();
+	ajouter_etat_initial( automate_1, 0 );
+	ajouter_etat_final( automate_1, 1 );
+	ajouter_transition( automate_1, 0, 'a', 0 );
+	ajouter_transition( automate_1, 0, 'b', 0 );
+	ajouter_transition( automate_1, 0, 'a', 1 );
+	ajouter_transition( automate_1, 1, 'a', 1 );
+	ajouter_transition( automate_1, 1, 'b', 1 );
+
+	// automate_2 : mots de longueur paire sur {a, b}
+	Automate * automate_2 = creer_automate();
+	ajouter_etat_initial( automate_2, 10 );
+	ajouter_etat_final( automate_2, 10 );
+	ajouter_transition( automate_2, 10, 'a', 11 );
+	ajouter_transition( automate_2, 10, 'b', 11 );
+	ajouter_transition( automate_2, 11, 'a', 10 );
+	ajouter_transition( automate_2, 11, 'b', 10 );
+
+	{
+		Automate * inter = creer_intersection_des_automates(
+			automate_1, automate_2
+		);
+		TEST(
+			1
+			&& inter
+			&& le_mot_est_reconnu( inter, "ab" )
+			&& le_mot_est_reconnu( inter, "bbba" )
+			&& ! le_mot_est_reconnu( inter, "" )
+			&& ! le_mot_est_reconnu( inter, "a" )
+			&& ! le_mot_est_reconnu( inter, "bb" )
+			&& get_min_etat( inter ) == 0
+			&& est_un_etat_initial_de_l_automate( inter, 0 )
+			, result
+		);
+		liberer_automate( inter );
+	}
+
+	{
+		Automate * u = creer_produit_des_automates(
+			automate_1, automate_2, PRODUIT_UNION
+		);
+		TEST(
+			1
+			&& u
+			&& le_mot_est_reconnu( u, "" )
+			&& le_mot_est_reconnu( u, "a" )
+			&& le_mot_est_reconnu( u, "bb" )
+			&& le_mot_est_reconnu( u, "ab" )
+			&& ! le_mot_est_reconnu( u, "b" )
+			&& ! le_mot_est_reconnu( u, "bbb" )
+			, result
+		);
+		liberer_automate( u );
+	}
+
+	{
+		Automate * diff = creer_produit_des_automates(
+			automate_1, automate_2, PRODUIT_DIFFERENCE
+		);
+		TEST(
+			1
+			&& diff
+			&& le_mot_est_reconnu( diff, "a" )
+			&& le_mot_est_reconnu( diff, "bba" )
+			&& ! le_mot_est_reconnu( diff, "ab" )
+			&& ! le_mot_est_reconnu( diff, "b" )
+			&& ! le_mot_est_reconnu( diff, "" )
+			, result
+		);
+		liberer_automate( diff );
+	}
+
+	{
+		Automate * xor = creer_produit_des_automates(
+			automate_1, automate_2, PRODUIT_DIFFERENCE_SYMETRIQUE
+		);
+		TEST(
+			1
+			&& xor
+			&& le_mot_est_reconnu( xor, "" )
+			&& le_mot_est_reconnu( xor, "a" )
+			&& le_mot_est_reconnu( xor, "bb" )
+			&& ! le_mot_est_reconnu( xor, "ab" )
+			&& ! le_mot_est_reconnu( xor, "b" )
+			, result
+		);
+		liberer_automate( xor );
+	}
+
+	liberer_automate( automate_1 );
+	liberer_automate( automate_2 );
+
+	return result;
+}
+
+
+
+int main(){
+
+	if( ! test_creer_produit_des_automates() ){ return 1; }
+
+	return 0;
+}
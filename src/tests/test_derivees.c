@@ -0,0 +1,143 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "derivees.h"
+#include "automates_expression.h"
+#include "equivalence.h"
+#include "outils.h"
+
+/*
+ * L'automate des dérivées doit être déterministe, complet sur l'alphabet
+ * de l'expression, et reconnaître le même langage que l'automate
+ * d'Antimirov.
+ */
+int verifier_brzozowski( Rationnel * rat ){
+	Automate * antimirov = Antimirov( rat );
+	Automate * brzozowski = Brzozowski( rat );
+	int ok = est_deterministe( brzozowski )
+		&& automates_equivalents( antimirov, brzozowski, NULL );
+	Ensemble_iterateur e, l;
+	for(
+		e = premier_iterateur_ensemble( get_etats( brzozowski ) );
+		! iterateur_ensemble_est_vide( e );
+		e = iterateur_suivant_ensemble( e )
+	){
+		for(
+			l = premier_iterateur_ensemble( get_alphabet( antimirov ) );
+			! iterateur_ensemble_est_vide( l );
+			l = iterateur_suivant_ensemble( l )
+		){
+			const Ensemble * v = voisins(
+				brzozowski, get_element( e ), (char) get_element( l )
+			);
+			if( ! v || taille_ensemble( v ) != 1 ) ok = 0;
+		}
+	}
+	liberer_automate( antimirov );
+	liberer_automate( brzozowski );
+	return ok;
+}
+
+int test_derivees(){
+
+	int result = 1;
+
+	// Les états sont créés à la lecture
+	{
+		Rationnel * rat = expression_to_rationnel( "(a+b)*.a.(a+b).(a+b).(a+b).(a+b)" );
+		Afd_derivees * afd = creer_afd_derivees( rat );
+		TEST( afd->nb_etats == 1, result );
+		int reconnu = afd_derivees_reconnait( afd, "bbbbbbb" );
+		TEST( ! reconnu && afd->nb_etats <= 8, result );
+		reconnu = afd_derivees_reconnait( afd, "babbbb" );
+		TEST( reconnu, result );
+		reconnu = afd_derivees_reconnait( afd, "babbbb" );
+		TEST( reconnu && afd->nb_succes >= 6, result );
+		// Un octet hors de l'alphabet mène à ∅
+		reconnu = afd_derivees_reconnait_tampon( afd, "ba\0bbb", 6 );
+		TEST( ! reconnu, result );
+
+		// L'exploration complète donne les 2^5 états du déterministe minimal,
+		// plus l'état ∅ atteint par l'octet '\0'
+		Automate * automate = automate_des_derivees( afd );
+		Automate * minimal = creer_automate_minimal( automate );
+		TEST(
+			1
+			&& afd->nb_etats == 33
+			&& taille_ensemble( get_etats( minimal ) ) == 32
+			&& le_mot_est_reconnu( automate, "babbbb" )
+			&& ! le_mot_est_reconnu( automate, "bbbbbbb" )
+			, result
+		);
+		liberer_automate( minimal );
+		liberer_automate( automate );
+		liberer_afd_derivees( afd );
+	}
+
+	// Les dérivées de (a*.b*)* se ramènent à un petit nombre de termes
+	{
+		Rationnel * rat = expression_to_rationnel( "((a*.b*)*.(a+b)*)*" );
+		Afd_derivees * afd = creer_afd_derivees( rat );
+		Automate * automate = automate_des_derivees( afd );
+		TEST(
+			1
+			&& afd->nb_etats <= 4
+			&& le_mot_est_reconnu( automate, "" )
+			&& le_mot_est_reconnu( automate, "abbab" )
+			, result
+		);
+		liberer_automate( automate );
+		liberer_afd_derivees( afd );
+	}
+
+	// ∅ et ε
+	{
+		Afd_derivees * afd = creer_afd_derivees( NULL );
+		int reconnu = afd_derivees_reconnait( afd, "" );
+		TEST( ! reconnu && afd->nb_etats == 1, result );
+		liberer_afd_derivees( afd );
+
+		afd = creer_afd_derivees( Star( Epsilon() ) );
+		reconnu = afd_derivees_reconnait( afd, "" );
+		TEST( reconnu, result );
+		reconnu = afd_derivees_reconnait( afd, "a" );
+		TEST( ! reconnu, result );
+		liberer_afd_derivees( afd );
+	}
+
+	{
+		const char * expressions[] = {
+			"a.b+c.b", "(a.a)*.(b*.c)*", "(a+b)*.c", "(a.b+a.c)*", "a*.b*.a*"
+		};
+		int i;
+		for( i = 0; i < 5; i++ ){
+			TEST( verifier_brzozowski( expression_to_rationnel( expressions[i] ) ), result );
+		}
+	}
+
+	return result;
+}
+
+
+
+int main(){
+
+	if( ! test_derivees() ){ return 1; }
+
+	return 0;
+}
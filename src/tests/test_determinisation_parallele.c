@@ -0,0 +1,91 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "determinisation_parallele.h"
+#include "equivalence.h"
+#include "outils.h"
+
+
+int test_determinisation_parallele(){
+
+	int result = 1;
+
+	// Mots sur {a, b} dont la sixième lettre avant la fin est un 'a' : 2^6
+	// sous-ensembles atteignables
+	Automate * automate = creer_automate();
+	int i;
+	ajouter_etat_initial( automate, 0 );
+	ajouter_etat_final( automate, 6 );
+	ajouter_transition( automate, 0, 'a', 0 );
+	ajouter_transition( automate, 0, 'b', 0 );
+	ajouter_transition( automate, 0, 'a', 1 );
+	for( i = 1; i < 6; i++ ){
+		ajouter_transition( automate, i, 'a', i + 1 );
+		ajouter_transition( automate, i, 'b', i + 1 );
+	}
+
+	Automate * sequentiel = creer_automate_deterministe( automate );
+	int nb_fils;
+	for( nb_fils = 1; nb_fils <= 4; nb_fils++ ){
+		Automate * parallele =
+			creer_automate_deterministe_parallele( automate, nb_fils );
+		TEST(
+			1
+			&& est_deterministe( parallele )
+			&& taille_ensemble( get_etats( parallele ) ) == 64
+			&& taille_ensemble( get_etats( parallele ) ) ==
+				taille_ensemble( get_etats( sequentiel ) )
+			&& taille_ensemble( get_finaux( parallele ) ) ==
+				taille_ensemble( get_finaux( sequentiel ) )
+			&& automates_equivalents( parallele, automate, NULL )
+			, result
+		);
+		liberer_automate( parallele );
+	}
+	liberer_automate( sequentiel );
+
+	// Sans état initial : le seul état est le puits
+	{
+		Automate * sans_initial = creer_automate();
+		ajouter_transition( sans_initial, 1, 'a', 2 );
+		Automate * parallele =
+			creer_automate_deterministe_parallele( sans_initial, 2 );
+		TEST(
+			1
+			&& taille_ensemble( get_etats( parallele ) ) == 1
+			&& taille_ensemble( get_finaux( parallele ) ) == 0
+			&& le_mot_est_reconnu( parallele, "" ) == 0
+			, result
+		);
+		liberer_automate( parallele );
+		liberer_automate( sans_initial );
+	}
+
+	liberer_automate( automate );
+
+	return result;
+}
+
+
+
+int main(){
+
+	if( ! test_determinisation_parallele() ){ return 1; }
+
+	return 0;
+}
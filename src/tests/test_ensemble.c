@@ -0,0 +1,71 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "ensemble.h"
+#include "outils.h"
+
+int test_ensemble(){
+	int result = 1;
+
+	{
+		Ensemble * a = creer_ensemble( NULL, NULL, NULL );
+		Ensemble * b = creer_ensemble( NULL, NULL, NULL );
+		int i;
+		for( i=0; i<300; i+=2 ) ajouter_element( a, i );
+		for( i=0; i<300; i+=3 ) ajouter_element( b, i );
+
+		Ensemble * u = creer_union_ensemble( a, b );
+		Ensemble * inter = creer_intersection_ensemble( a, b );
+		Ensemble * diff = creer_difference_ensemble( a, b );
+
+		int ok = 1;
+		for( i=0; i<600; i++ ){
+			int dans_a = ( i < 300 && i%2 == 0 );
+			int dans_b = ( i < 300 && i%3 == 0 );
+			ok &= est_dans_l_ensemble( u, i ) == ( dans_a || dans_b );
+			ok &= est_dans_l_ensemble( inter, i ) == ( dans_a && dans_b );
+			ok &= est_dans_l_ensemble( diff, i ) == ( dans_a && ! dans_b );
+		}
+
+		TEST(
+			1
+			&& ok
+			&& taille_ensemble( inter ) == 50
+			&& taille_ensemble( u ) == 200
+			&& comparer_ensemble( a, b ) == -1
+			&& comparer_ensemble( b, a ) == 1
+			, result
+		);
+
+		liberer_ensemble( u );
+		liberer_ensemble( inter );
+		liberer_ensemble( diff );
+		liberer_ensemble( a );
+		liberer_ensemble( b );
+	}
+
+	return result;
+}
+
+int main(){
+
+	if( ! test_ensemble() ){ return 1; }
+
+	return 0;
+}
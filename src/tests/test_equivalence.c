@@ -0,0 +1,137 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "equivalence.h"
+#include "outils.h"
+
+#include <string.h>
+
+
+int test_equivalence(){
+
+	int result = 1;
+
+	// Mots sur {a, b} qui finissent par un 'a'
+	Automate * finit_par_a = creer_automate();
+	ajouter_etat_initial( finit_par_a, 0 );
+	ajouter_etat_final( finit_par_a, 1 );
+	ajouter_transition( finit_par_a, 0, 'a', 0 );
+	ajouter_transition( finit_par_a, 0, 'b', 0 );
+	ajouter_transition( finit_par_a, 0, 'a', 1 );
+
+	// Le même langage, reconnu par un automate déterministe
+	Automate * deterministe = creer_automate();
+	ajouter_etat_initial( deterministe, 5 );
+	ajouter_etat_final( deterministe, 6 );
+	ajouter_transition( deterministe, 5, 'a', 6 );
+	ajouter_transition( deterministe, 5, 'b', 5 );
+	ajouter_transition( deterministe, 6, 'a', 6 );
+	ajouter_transition( deterministe, 6, 'b', 5 );
+
+	// Mots sur {a, b} qui contiennent un 'a'
+	Automate * contient_a = creer_automate();
+	ajouter_etat_initial( contient_a, 0 );
+	ajouter_etat_final( contient_a, 1 );
+	ajouter_transition( contient_a, 0, 'b', 0 );
+	ajouter_transition( contient_a, 0, 'a', 1 );
+	ajouter_transition( contient_a, 1, 'a', 1 );
+	ajouter_transition( contient_a, 1, 'b', 1 );
+
+	{
+		char * contre_exemple = NULL;
+		int equivalents = automates_equivalents(
+			finit_par_a, deterministe, &contre_exemple
+		);
+		TEST( equivalents && contre_exemple == NULL, result );
+	}
+
+	{
+		char * contre_exemple = NULL;
+		int equivalents = automates_equivalents(
+			finit_par_a, contient_a, &contre_exemple
+		);
+		TEST(
+			1
+			&& ! equivalents
+			&& contre_exemple
+			&& strcmp( contre_exemple, "ab" ) == 0
+			, result
+		);
+		xfree( contre_exemple );
+	}
+
+	// Un langage vide et le langage { epsilon }, puis une lettre hors de
+	// l'alphabet de l'autre automate
+	{
+		Automate * vide = creer_automate();
+		Automate * epsilon = creer_automate();
+		ajouter_etat_initial( epsilon, 0 );
+		ajouter_etat_final( epsilon, 0 );
+		char * contre_exemple = NULL;
+		int equivalents = automates_equivalents( vide, epsilon, &contre_exemple );
+		TEST(
+			1
+			&& ! equivalents
+			&& contre_exemple
+			&& strcmp( contre_exemple, "" ) == 0
+			, result
+		);
+		xfree( contre_exemple );
+
+		Automate * a_ou_c = creer_automate();
+		ajouter_etat_initial( a_ou_c, 0 );
+		ajouter_etat_final( a_ou_c, 1 );
+		ajouter_transition( a_ou_c, 0, 'a', 1 );
+		ajouter_transition( a_ou_c, 0, 'c', 1 );
+		Automate * a = creer_automate();
+		ajouter_etat_initial( a, 0 );
+		ajouter_etat_final( a, 1 );
+		ajouter_transition( a, 0, 'a', 1 );
+		contre_exemple = NULL;
+		equivalents = automates_equivalents( a, a_ou_c, &contre_exemple );
+		TEST(
+			1
+			&& ! equivalents
+			&& contre_exemple
+			&& strcmp( contre_exemple, "c" ) == 0
+			&& ! automates_equivalents( a_ou_c, a, NULL )
+			, result
+		);
+		xfree( contre_exemple );
+
+		liberer_automate( vide );
+		liberer_automate( epsilon );
+		liberer_automate( a_ou_c );
+		liberer_automate( a );
+	}
+
+	liberer_automate( finit_par_a );
+	liberer_automate( deterministe );
+	liberer_automate( contient_a );
+
+	return result;
+}
+
+
+
+int main(){
+
+	if( ! test_equivalence() ){ return 1; }
+
+	return 0;
+}
@@ -0,0 +1,125 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "filtrage.h"
+#include "outils.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Compare filtrer_lignes() à un découpage naïf du texte en lignes.
+ */
+int verifier_filtrage(
+	const Afd * afd, const Automate * automate, const char * texte,
+	size_t longueur, int inverser, int nb_fils, size_t taille_morceau
+){
+	Occurrence * lignes;
+	size_t nb = filtrer_lignes(
+		afd, texte, longueur, inverser, nb_fils, taille_morceau, &lignes
+	);
+	size_t nb_comptees = filtrer_lignes(
+		afd, texte, longueur, inverser, nb_fils, taille_morceau, NULL
+	);
+	int ok = ( nb == nb_comptees );
+	size_t debut = 0, k = 0;
+	char ligne[256];
+	while( debut < longueur && ok ){
+		size_t fin = debut;
+		while( fin < longueur && texte[fin] != '\n' ) fin++;
+		memcpy( ligne, texte + debut, fin - debut );
+		ligne[ fin - debut ] = '\0';
+		if( le_mot_est_reconnu( automate, ligne ) != inverser ){
+			if(
+				k >= nb || lignes[k].debut != debut || lignes[k].fin != fin
+			) ok = 0;
+			k++;
+		}
+		debut = fin + 1;
+	}
+	if( k != nb ) ok = 0;
+	xfree( lignes );
+	return ok;
+}
+
+int test_filtrage(){
+
+	int result = 1;
+
+	// ab*
+	Automate * automate = creer_automate();
+	ajouter_etat_initial( automate, 0 );
+	ajouter_transition( automate, 0, 'a', 1 );
+	ajouter_transition( automate, 1, 'b', 1 );
+	ajouter_etat_final( automate, 1 );
+	Afd * afd = creer_afd( automate );
+
+	// Lignes aléatoires, dont des lignes vides
+	size_t longueur = 5000, i;
+	char * texte = xmalloc( longueur );
+	srand( 19 );
+	for( i = 0; i < longueur; i++ ){
+		int r = rand() % 10;
+		texte[i] = r < 3 ? '\n' : r < 5 ? 'a' : r < 9 ? 'b' : 'c';
+	}
+
+	size_t tailles[4] = { 1, 7, 256, 0 };
+	int nb_fils, t, inverser;
+	for( t = 0; t < 4; t++ ){
+		for( nb_fils = 1; nb_fils <= 3; nb_fils++ ){
+			for( inverser = 0; inverser <= 1; inverser++ ){
+				int ok = verifier_filtrage(
+					afd, automate, texte, longueur, inverser, nb_fils, tailles[t]
+				);
+				TEST( ok, result );
+			}
+		}
+	}
+
+	// Dernière ligne sans '\n', texte vide
+	{
+		Occurrence * lignes;
+		size_t nb = filtrer_lignes( afd, "c\nab", 4, 0, 2, 1, &lignes );
+		TEST(
+			1
+			&& nb == 1
+			&& lignes[0].debut == 2
+			&& lignes[0].fin == 4
+			, result
+		);
+		xfree( lignes );
+		nb = filtrer_lignes( afd, "", 0, 1, 4, 0, &lignes );
+		TEST( nb == 0, result );
+		xfree( lignes );
+	}
+
+	xfree( texte );
+	liberer_afd( afd );
+	liberer_automate( automate );
+
+	return result;
+}
+
+
+
+int main(){
+
+	if( ! test_filtrage() ){ return 1; }
+
+	return 0;
+}
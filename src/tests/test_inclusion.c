@@ -0,0 +1,128 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "inclusion.h"
+#include "outils.h"
+
+#include <string.h>
+
+
+int test_inclusion(){
+
+	int result = 1;
+
+	// Mots sur {a, b} dont la troisième lettre avant la fin est un 'a'
+	Automate * troisieme = creer_automate();
+	ajouter_etat_initial( troisieme, 0 );
+	ajouter_etat_final( troisieme, 3 );
+	ajouter_transition( troisieme, 0, 'a', 0 );
+	ajouter_transition( troisieme, 0, 'b', 0 );
+	ajouter_transition( troisieme, 0, 'a', 1 );
+	ajouter_transition( troisieme, 1, 'a', 2 );
+	ajouter_transition( troisieme, 1, 'b', 2 );
+	ajouter_transition( troisieme, 2, 'a', 3 );
+	ajouter_transition( troisieme, 2, 'b', 3 );
+
+	// Mots sur {a, b} qui contiennent un 'a'
+	Automate * contient_a = creer_automate();
+	ajouter_etat_initial( contient_a, 0 );
+	ajouter_etat_final( contient_a, 1 );
+	ajouter_transition( contient_a, 0, 'b', 0 );
+	ajouter_transition( contient_a, 0, 'a', 1 );
+	ajouter_transition( contient_a, 1, 'a', 1 );
+	ajouter_transition( contient_a, 1, 'b', 1 );
+
+	{
+		char * temoin = NULL;
+		int inclus = automate_est_inclus( troisieme, contient_a, &temoin );
+		TEST( inclus && temoin == NULL, result );
+	}
+
+	{
+		char * temoin = NULL;
+		int inclus = automate_est_inclus( contient_a, troisieme, &temoin );
+		TEST(
+			1
+			&& ! inclus
+			&& temoin
+			&& le_mot_est_reconnu( contient_a, temoin )
+			&& ! le_mot_est_reconnu( troisieme, temoin )
+			, result
+		);
+		xfree( temoin );
+	}
+
+	{
+		char * temoin = NULL;
+		int universel = automate_est_universel( contient_a, &temoin );
+		TEST(
+			1
+			&& ! universel
+			&& temoin
+			&& strcmp( temoin, "" ) == 0
+			, result
+		);
+		xfree( temoin );
+
+		// (a + b)* reconnu par un automate non déterministe
+		Automate * tous = creer_automate();
+		ajouter_etat_initial( tous, 0 );
+		ajouter_etat_initial( tous, 1 );
+		ajouter_etat_final( tous, 0 );
+		ajouter_transition( tous, 0, 'a', 0 );
+		ajouter_transition( tous, 0, 'a', 1 );
+		ajouter_transition( tous, 0, 'b', 1 );
+		ajouter_transition( tous, 1, 'b', 0 );
+		TEST( automate_est_universel( tous, NULL ), result );
+
+		// Sans la transition ( 0, 'b', 1 ), "bb" n'est plus reconnu
+		Automate * presque = creer_automate();
+		ajouter_etat_initial( presque, 0 );
+		ajouter_etat_initial( presque, 1 );
+		ajouter_etat_final( presque, 0 );
+		ajouter_transition( presque, 0, 'a', 0 );
+		ajouter_transition( presque, 0, 'a', 1 );
+		ajouter_transition( presque, 1, 'b', 0 );
+		temoin = NULL;
+		universel = automate_est_universel( presque, &temoin );
+		TEST(
+			1
+			&& ! universel
+			&& temoin
+			&& strcmp( temoin, "bb" ) == 0
+			, result
+		);
+		xfree( temoin );
+		liberer_automate( presque );
+		liberer_automate( tous );
+	}
+
+	liberer_automate( troisieme );
+	liberer_automate( contient_a );
+
+	return result;
+}
+
+
+
+int main(){
+
+	if( ! test_inclusion() ){ return 1; }
+
+	return 0;
+}
@@ -0,0 +1,144 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "lecteur.h"
+#include "outils.h"
+
+#include <string.h>
+
+/*
+ * Lit le mot par morceaux de tailles 1, 2, 3, ... et compare, après chaque
+ * morceau, la réponse du lecteur à celle de le_mot_est_reconnu() sur le
+ * préfixe lu.
+ */
+int lire_par_morceaux( Lecteur * lecteur, const Automate * automate, const char * mot ){
+	char prefixe[64];
+	size_t n = strlen( mot ), lu = 0, taille = 1;
+	remettre_a_zero_lecteur( lecteur );
+	while( lu < n ){
+		if( lu + taille > n ) taille = n - lu;
+		lecteur_lire( lecteur, mot + lu, taille );
+		lu += taille;
+		taille++;
+		memcpy( prefixe, mot, lu );
+		prefixe[lu] = '\0';
+		if( lecteur_accepte( lecteur ) != le_mot_est_reconnu( automate, prefixe ) ){
+			return 0;
+		}
+	}
+	return lecteur->nb_octets == n;
+}
+
+int test_lecteur(){
+
+	int result = 1;
+
+	// Mots sur {a, b} dont l'avant-dernière lettre est un 'a'
+	Automate * automate = creer_automate();
+	ajouter_etat_initial( automate, 0 );
+	ajouter_transition( automate, 0, 'a', 0 );
+	ajouter_transition( automate, 0, 'b', 0 );
+	ajouter_transition( automate, 0, 'a', 1 );
+	ajouter_transition( automate, 1, 'a', 2 );
+	ajouter_transition( automate, 1, 'b', 2 );
+	ajouter_etat_final( automate, 2 );
+
+	Automate * deterministe = creer_automate_deterministe( automate );
+
+	const char * mots[] = {
+		"", "a", "ab", "ba", "aab", "abbbab", "babababbbaaab", "bbbbbbbbbbbbba"
+	};
+	int i;
+	Lecteur * non_deterministe = creer_lecteur( automate );
+	Lecteur * lecteur_afd = creer_lecteur( deterministe );
+	TEST(
+		1
+		&& non_deterministe->afd == NULL
+		&& lecteur_afd->afd != NULL
+		, result
+	);
+	for( i = 0; i < 8; i++ ){
+		int ok = lire_par_morceaux( non_deterministe, automate, mots[i] );
+		TEST( ok, result );
+		ok = lire_par_morceaux( lecteur_afd, deterministe, mots[i] );
+		TEST( ok, result );
+	}
+
+	// Une copie reprend la lecture là où en était le lecteur, puis les deux
+	// avancent indépendamment
+	{
+		remettre_a_zero_lecteur( non_deterministe );
+		lecteur_lire( non_deterministe, "bba", 3 );
+		Lecteur * copie = copier_lecteur( non_deterministe );
+		lecteur_lire( copie, "b", 1 );
+		lecteur_lire( non_deterministe, "a", 1 );
+		lecteur_lire( non_deterministe, "", 0 );
+		int ok_copie = lecteur_accepte( copie );
+		int ok_lecteur = lecteur_accepte( non_deterministe );
+		liberer_lecteur( non_deterministe );
+		lecteur_lire( copie, "ab", 2 );
+		TEST(
+			1
+			&& ok_copie
+			&& ok_lecteur
+			&& lecteur_accepte( copie )
+			&& copie->nb_octets == 6
+			, result
+		);
+		non_deterministe = copie;
+	}
+
+	// Un '\0' est un octet comme un autre : il n'est pas dans l'alphabet
+	{
+		remettre_a_zero_lecteur( lecteur_afd );
+		remettre_a_zero_lecteur( non_deterministe );
+		lecteur_lire( lecteur_afd, "ab\0", 3 );
+		lecteur_lire( non_deterministe, "ab\0", 3 );
+		TEST(
+			1
+			&& lecteur_est_bloque( lecteur_afd )
+			&& lecteur_est_bloque( non_deterministe )
+			&& ! lecteur_accepte( lecteur_afd )
+			&& ! lecteur_accepte( non_deterministe )
+			, result
+		);
+		remettre_a_zero_lecteur( non_deterministe );
+		lecteur_lire( non_deterministe, "ab", 2 );
+		TEST(
+			! lecteur_est_bloque( non_deterministe )
+			&& lecteur_accepte( non_deterministe )
+			, result
+		);
+	}
+
+	liberer_lecteur( non_deterministe );
+	liberer_lecteur( lecteur_afd );
+	liberer_automate( deterministe );
+	liberer_automate( automate );
+
+	return result;
+}
+
+
+
+int main(){
+
+	if( ! test_lecteur() ){ return 1; }
+
+	return 0;
+}
@@ -0,0 +1,165 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "motifs.h"
+#include "rationnel.h"
+#include "outils.h"
+
+#include <string.h>
+
+#define NB_MOTIFS 6
+
+/*
+ * Vérifie, pour tous les mots de longueur au plus 'longueur_max' sur
+ * l'alphabet, que le jeu de motifs renvoie exactement les motifs dont
+ * l'automate reconnaît le mot.
+ */
+int verifier_motifs(
+	const Jeu_de_motifs * jeu, Automate ** automates, int nb_motifs,
+	const char * alphabet, int longueur_max
+){
+	int k = strlen( alphabet );
+	char mot[16];
+	int indices[16];
+	int longueur, i;
+	for( longueur = 0; longueur <= longueur_max; longueur++ ){
+		for( i = 0; i < longueur; i++ ) indices[i] = 0;
+		while( 1 ){
+			for( i = 0; i < longueur; i++ ) mot[i] = alphabet[ indices[i] ];
+			mot[ longueur ] = '\0';
+
+			int nb, nb_tampon, j = 0;
+			const int * motifs = motifs_reconnus( jeu, mot, &nb );
+			motifs_reconnus_tampon( jeu, mot, longueur, &nb_tampon );
+			if( nb != nb_tampon ) return 0;
+			for( i = 0; i < nb_motifs; i++ ){
+				int reconnu = le_mot_est_reconnu( automates[i], mot );
+				int trouve = j < nb && motifs[j] == i;
+				if( reconnu != trouve ) return 0;
+				if( trouve ) j++;
+			}
+			if( j != nb ) return 0;
+
+			for( i = longueur - 1; i >= 0 && indices[i] == k - 1; i-- ){
+				indices[i] = 0;
+			}
+			if( i < 0 ) break;
+			indices[i]++;
+		}
+	}
+	return 1;
+}
+
+int test_motifs(){
+
+	int result = 1;
+
+	const char * expressions[NB_MOTIFS] = {
+		"a.b*",
+		"(a+b)*.b",
+		"b.b",
+		"c*",
+		"(a+c)*.a.(a+c)",
+		"a.b*"
+	};
+	Automate * automates[NB_MOTIFS];
+	int i;
+	for( i = 0; i < NB_MOTIFS; i++ ){
+		Rationnel * rat = expression_to_rationnel( expressions[i] );
+		numeroter_rationnel( rat );
+		automates[i] = Glushkov( rat );
+	}
+
+	Jeu_de_motifs * jeu = compiler_motifs( expressions, NB_MOTIFS );
+	{
+		int ok = verifier_motifs( jeu, automates, NB_MOTIFS, "abcd", 6 );
+		TEST( ok && jeu->nb_motifs == NB_MOTIFS, result );
+	}
+
+	// Les motifs 0 et 5 sont identiques : ils sont toujours reconnus ensemble
+	{
+		int nb;
+		const int * motifs = motifs_reconnus( jeu, "a", &nb );
+		int ok = 0;
+		for( i = 0; i + 1 < nb; i++ ){
+			if( motifs[i] == 0 && motifs[nb-1] == 5 ) ok = 1;
+		}
+		TEST( ok, result );
+	}
+
+	// Une lettre hors de tous les alphabets mène à l'état mort
+	{
+		int nb;
+		motifs_reconnus_tampon( jeu, "d", 1, &nb );
+		TEST(
+			1
+			&& motifs_suivant( jeu, jeu->initial, 'd' ) == MOTIFS_MORT
+			&& nb == 0
+			, result
+		);
+	}
+
+	// Le tampon peut contenir des '\0'
+	{
+		int nb;
+		motifs_reconnus_tampon( jeu, "c\0c", 3, &nb );
+		TEST( nb == 0, result );
+	}
+	liberer_jeu_de_motifs( jeu );
+
+	// La minimisation fusionne les copies d'un même motif : le nombre
+	// d'états ne dépend pas du nombre de copies.
+	{
+		Automate * copies[20];
+		for( i = 0; i < 20; i++ ) copies[i] = automates[4];
+		Jeu_de_motifs * un = creer_jeu_de_motifs( copies, 1 );
+		Jeu_de_motifs * vingt = creer_jeu_de_motifs( copies, 20 );
+		int nb;
+		motifs_reconnus( vingt, "aa", &nb );
+		TEST(
+			1
+			&& un->nb_etats == vingt->nb_etats
+			&& nb == 20
+			, result
+		);
+		liberer_jeu_de_motifs( un );
+		liberer_jeu_de_motifs( vingt );
+	}
+
+	// Aucun motif
+	{
+		Jeu_de_motifs * vide = creer_jeu_de_motifs( NULL, 0 );
+		int nb;
+		motifs_reconnus( vide, "ab", &nb );
+		TEST( nb == 0 && vide->nb_etats == 1, result );
+		liberer_jeu_de_motifs( vide );
+	}
+
+	for( i = 0; i < NB_MOTIFS; i++ ) liberer_automate( automates[i] );
+
+	return result;
+}
+
+
+
+int main(){
+
+	if( ! test_motifs() ){ return 1; }
+
+	return 0;
+}
@@ -0,0 +1,103 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "automate.h"
+#include "outils.h"
+
+void action_noter_origine( int origine, char lettre, int fin, void* data ){
+	int * origines = (int*) data;
+	origines[ ++origines[0] ] = origine;
+}
+
+int test_predecesseurs(){
+
+	int result = 1;
+
+	Automate * automate = creer_automate();
+	ajouter_etat_initial( automate, 1 );
+	ajouter_transition( automate, 1, 'b', 2 );
+	ajouter_transition( automate, 1, 'a', 2 );
+	ajouter_transition( automate, 3, 'a', 2 );
+	ajouter_transition( automate, 2, 'c', 1 );
+
+	{
+		const Ensemble * ens = voisins( automate, 1, 'a' );
+		TEST(
+			1
+			&& taille_ensemble( ens ) == 1
+			&& est_dans_l_ensemble( ens, 2 )
+			&& taille_ensemble( voisins( automate, 1, 'c' ) ) == 0
+			&& taille_ensemble( voisins( automate, 42, 'a' ) ) == 0
+			, result
+		);
+	}
+
+	activer_index_inverse( automate );
+	ajouter_transition( automate, 4, 'a', 2 );
+
+	{
+		const Ensemble * ens = predecesseurs( automate, 2, 'a' );
+		TEST(
+			1
+			&& taille_ensemble( ens ) == 3
+			&& est_dans_l_ensemble( ens, 1 )
+			&& est_dans_l_ensemble( ens, 3 )
+			&& est_dans_l_ensemble( ens, 4 )
+			&& taille_ensemble( predecesseurs( automate, 2, 'b' ) ) == 1
+			&& taille_ensemble( predecesseurs( automate, 1, 'c' ) ) == 1
+			&& taille_ensemble( predecesseurs( automate, 3, 'a' ) ) == 0
+			, result
+		);
+	}
+
+	liberer_automate( automate );
+
+	// Les transitions sont parcourues par origine croissante, y compris pour
+	// des états négatifs créés dans le désordre
+	{
+		Automate * automate = creer_automate();
+		ajouter_transition( automate, 5, 'a', 0 );
+		ajouter_transition( automate, -7, 'a', 0 );
+		ajouter_transition( automate, 0, 'a', 5 );
+		ajouter_transition( automate, -1, 'a', 0 );
+		int origines[5] = { 0 };
+		pour_toute_transition( automate, action_noter_origine, origines );
+		TEST(
+			1
+			&& origines[0] == 4
+			&& origines[1] == -7
+			&& origines[2] == -1
+			&& origines[3] == 0
+			&& origines[4] == 5
+			, result
+		);
+		liberer_automate( automate );
+	}
+
+	return result;
+}
+
+
+
+int main(){
+
+	if( ! test_predecesseurs() ){ return 1; }
+
+	return 0;
+}
@@ -0,0 +1,264 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "rationnel_interne.h"
+#include "automates_expression.h"
+#include "equivalence.h"
+#include "outils.h"
+
+/*
+ * Taille de l'arbre développé d'une expression, où chaque occurrence d'un
+ * noeud partagé compte.
+ */
+double taille_developpee( const Rationnel * rat ){
+	if( ! rat ) return 0;
+	switch( rat->etiquette ){
+		case STAR: return 1 + taille_developpee( rat->gauche );
+		case UNION:
+		case CONCAT:
+			return 1 + taille_developpee( rat->gauche )
+				+ taille_developpee( rat->droit );
+		default: return 1;
+	}
+}
+
+/*
+ * Nombre de noeuds distincts d'une expression.
+ */
+void noter_noeuds_distincts( const Rationnel * rat, Ensemble * vus ){
+	if( ! rat || est_dans_l_ensemble( vus, (intptr_t) rat ) ) return;
+	ajouter_element( vus, (intptr_t) rat );
+	noter_noeuds_distincts( rat->gauche, vus );
+	noter_noeuds_distincts( rat->droit, vus );
+}
+
+int nombre_de_noeuds( const Rationnel * rat ){
+	Ensemble * vus = creer_ensemble( NULL, NULL, NULL );
+	noter_noeuds_distincts( rat, vus );
+	int res = taille_ensemble( vus );
+	liberer_ensemble( vus );
+	return res;
+}
+
+/*
+ * Automate à n états où tout état va vers tout autre, par a ou par b selon
+ * la parité de l'écart ; seul le dernier état est final.
+ */
+Automate * automate_complet( int n ){
+	Automate * automate = creer_automate();
+	int i, j;
+	for( i = 0; i < n; i++ ){
+		ajouter_etat( automate, i );
+		for( j = 0; j < n; j++ ){
+			ajouter_transition( automate, i, ( i + j ) % 2 ? 'a' : 'b', j );
+		}
+	}
+	ajouter_etat_initial( automate, 0 );
+	ajouter_etat_final( automate, n - 1 );
+	return automate;
+}
+
+int meme_langage_que_automate( const Rationnel * rat, const Automate * automate ){
+	Automate * a = plus_petit_automate( (Rationnel *) rat, NULL );
+	int res = automates_equivalents( a, automate, NULL );
+	liberer_automate( a );
+	return res;
+}
+
+int test_rationnel_interne(){
+
+	int result = 1;
+
+	// Partage et simplifications
+	{
+		Table_rationnels * table = creer_table_rationnels();
+		Rationnel * eps = epsilon_interne( table );
+		Rationnel * a = lettre_interne( table, 'a' );
+		Rationnel * b = lettre_interne( table, 'b' );
+		Rationnel * c = lettre_interne( table, 'c' );
+		Rationnel * etoile_a = etoile_interne( table, a );
+
+		TEST( a == lettre_interne( table, 'a' ), result );
+		TEST(
+			concat_interne( table, a, b ) == concat_interne( table, a, b ),
+			result
+		);
+		TEST( union_interne( table, a, b ) == union_interne( table, b, a ), result );
+		TEST( union_interne( table, a, a ) == a, result );
+		TEST(
+			union_interne( table, union_interne( table, a, b ), c )
+			== union_interne( table, a, union_interne( table, c, b ) ),
+			result
+		);
+		TEST(
+			union_interne( table, union_interne( table, a, b ), a )
+			== union_interne( table, a, b ),
+			result
+		);
+
+		TEST( union_interne( table, NULL, a ) == a, result );
+		TEST( concat_interne( table, NULL, a ) == NULL, result );
+		TEST( concat_interne( table, a, NULL ) == NULL, result );
+		TEST( etoile_interne( table, NULL ) == eps, result );
+		TEST( concat_interne( table, eps, a ) == a, result );
+		TEST( concat_interne( table, a, eps ) == a, result );
+		TEST( etoile_interne( table, eps ) == eps, result );
+
+		TEST( etoile_interne( table, etoile_a ) == etoile_a, result );
+		TEST( etoile_interne( table, union_interne( table, eps, a ) ) == etoile_a, result );
+		TEST( union_interne( table, eps, etoile_a ) == etoile_a, result );
+		TEST(
+			etoile_interne( table, union_interne( table, eps, union_interne( table, a, b ) ) )
+			== etoile_interne( table, union_interne( table, b, a ) ),
+			result
+		);
+
+		// Seuls ε, a, b, c, a*, a.b, a+b, b+c, a+b+c, ε+a, ε+a+b et (a+b)* ont
+		// été créés
+		TEST( nombre_de_rationnels_internes( table ) == 12, result );
+		liberer_table_rationnels( table, 1 );
+	}
+
+	// Internement d'une expression : les sous-expressions égales sont partagées
+	{
+		Table_rationnels * table = creer_table_rationnels();
+		Rationnel * rat = expression_to_rationnel( "(a+b)*.a.(a+b)*.(b+a)" );
+		Rationnel * interne = interner_rationnel( table, rat );
+		TEST( interne == interner_rationnel( table, rat ), result );
+		TEST( nombre_de_rationnels_internes( table ) == 7, result );
+		Automate * automate = plus_petit_automate( rat, NULL );
+		TEST( meme_langage_que_automate( interne, automate ), result );
+		liberer_automate( automate );
+		liberer_table_rationnels( table, 1 );
+	}
+
+	// Arden
+	{
+		Rationnel * rat = expression_to_rationnel( "(a+b)*.a.(a+b)" );
+		numeroter_rationnel( rat );
+		Automate * glushkov = Glushkov( rat );
+		Table_rationnels * table = creer_table_rationnels();
+		Rationnel * interne = Arden_interne( table, glushkov );
+		TEST( meme_langage_que_automate( interne, glushkov ), result );
+		Rationnel * arden = Arden( glushkov );
+		TEST( meme_langage_que_automate( arden, glushkov ), result );
+		// Aller-retour : Glushkov() numérote chaque occurrence d'un noeud
+		// partagé de l'expression renvoyée
+		Automate * retour = Glushkov( arden );
+		TEST(
+			1
+			&& le_mot_est_reconnu( retour, "aa" )
+			&& le_mot_est_reconnu( retour, "bbab" )
+			&& ! le_mot_est_reconnu( retour, "b" )
+			&& le_mot_est_reconnu( retour, "aab" )
+			&& ! le_mot_est_reconnu( retour, "abba" )
+			&& automates_equivalents( retour, glushkov, NULL )
+			, result
+		);
+		liberer_automate( retour );
+		liberer_rationnel_partage( arden );
+		liberer_table_rationnels( table, 1 );
+		liberer_automate( glushkov );
+	}
+
+	// Plusieurs lettres entre deux mêmes états
+	{
+		Automate * automate = creer_automate();
+		ajouter_etat_initial( automate, 0 );
+		ajouter_etat_final( automate, 1 );
+		ajouter_transition( automate, 0, 'a', 1 );
+		ajouter_transition( automate, 0, 'b', 1 );
+		ajouter_transition( automate, 1, 'c', 1 );
+		Table_rationnels * table = creer_table_rationnels();
+		Rationnel * interne = Arden_interne( table, automate );
+		TEST( meme_langage_que_automate( interne, automate ), result );
+		liberer_table_rationnels( table, 1 );
+		liberer_automate( automate );
+	}
+
+	// Aller-retour sur un automate où les sous-expressions sont très partagées
+	{
+		Automate * automate = automate_complet( 4 );
+		Rationnel * arden = Arden( automate );
+		Automate * retour = Glushkov( arden );
+		Rationnel * arbre = developper_rationnel( arden );
+		numeroter_rationnel( arbre );
+		Automate * retour_arbre = Glushkov( arbre );
+		TEST(
+			1
+			&& rationnel_est_partage( arden )
+			&& ! rationnel_est_partage( arbre )
+			&& automates_equivalents( retour, automate, NULL )
+			&& automates_equivalents( retour_arbre, automate, NULL )
+			, result
+		);
+		liberer_automate( retour );
+		liberer_automate( retour_arbre );
+		liberer_rationnel_partage( arbre );
+		liberer_rationnel_partage( arden );
+		liberer_automate( automate );
+	}
+
+	// Langage vide
+	{
+		Automate * automate = creer_automate();
+		ajouter_etat_initial( automate, 0 );
+		ajouter_etat( automate, 1 );
+		ajouter_transition( automate, 0, 'a', 0 );
+		ajouter_etat_final( automate, 1 );
+		Table_rationnels * table = creer_table_rationnels();
+		TEST( Arden_interne( table, automate ) == NULL, result );
+		TEST( Arden( automate ) == NULL, result );
+		liberer_table_rationnels( table, 1 );
+		liberer_automate( automate );
+	}
+
+	// Le nombre de noeuds internés, et celui des noeuds de l'expression
+	// renvoyée par Arden(), croissent comme le nombre de transitions, alors
+	// que l'arbre développé croît exponentiellement.
+	{
+		int n, ok = 1;
+		for( n = 2; n <= 16; n++ ){
+			Automate * automate = automate_complet( n );
+			Table_rationnels * table = creer_table_rationnels();
+			Rationnel * interne = Arden_interne( table, automate );
+			if( nombre_de_rationnels_internes( table ) > 4 * n * n ) ok = 0;
+			Rationnel * arden = Arden( automate );
+			int noeuds = nombre_de_noeuds( arden );
+			if( noeuds > 4 * n * n ) ok = 0;
+			if( n <= 7 && ! meme_langage_que_automate( interne, automate ) ) ok = 0;
+			if( n <= 7 && ! meme_langage_que_automate( arden, automate ) ) ok = 0;
+			if( n == 7 && taille_developpee( arden ) < 100 * noeuds ) ok = 0;
+			liberer_rationnel_partage( arden );
+			liberer_table_rationnels( table, 1 );
+			liberer_automate( automate );
+		}
+		TEST( ok, result );
+	}
+
+	return result;
+}
+
+
+
+int main(){
+
+	if( ! test_rationnel_interne() ){ return 1; }
+
+	return 0;
+}
@@ -0,0 +1,198 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "recherche.h"
+#include "outils.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define LONGUEUR_TEXTE 40
+
+int est_occurrence(
+	const Automate * automate, const char * texte, size_t debut, size_t fin
+){
+	char mot[ LONGUEUR_TEXTE + 1 ];
+	memcpy( mot, texte + debut, fin - debut );
+	mot[ fin - debut ] = '\0';
+	return le_mot_est_reconnu( automate, mot );
+}
+
+/*
+ * Compare le moteur de recherche à une recherche naïve qui essaie tous les
+ * facteurs du texte.
+ */
+int verifier_recherche(
+	const Automate * automate, const Recherche * recherche, const char * texte
+){
+	size_t n = strlen( texte ), debut, fin, k;
+	Occurrence * occurrences;
+	Occurrence premiere;
+
+	// Occurrences disjointes, la plus à gauche puis la plus longue
+	size_t nb = rechercher_toutes(
+		recherche, texte, n, RECHERCHE_DISJOINTES, &occurrences
+	);
+	size_t position = 0;
+	k = 0;
+	int ok = 1;
+	while( position <= n && ok ){
+		int trouve = 0;
+		for( debut = position; debut <= n && ! trouve; debut++ ){
+			for( fin = n + 1; fin > debut && ! trouve; fin-- ){
+				if( est_occurrence( automate, texte, debut, fin - 1 ) ){
+					trouve = 1;
+					if(
+						k >= nb || occurrences[k].debut != debut ||
+						occurrences[k].fin != fin - 1
+					) ok = 0;
+					if( k == 0 ){
+						int p = rechercher_premiere( recherche, texte, n, &premiere );
+						if(
+							! p || premiere.debut != debut ||
+							premiere.fin != fin - 1
+						) ok = 0;
+					}
+					k++;
+					position = ( fin - 1 > debut ) ? fin - 1 : fin;
+				}
+			}
+		}
+		if( ! trouve ) break;
+	}
+	if( k != nb ) ok = 0;
+	if( nb == 0 && rechercher_premiere( recherche, texte, n, &premiere ) ) ok = 0;
+	xfree( occurrences );
+
+	// Pour chaque fin, l'occurrence la plus longue
+	nb = rechercher_toutes(
+		recherche, texte, n, RECHERCHE_CHEVAUCHANTES, &occurrences
+	);
+	k = 0;
+	for( fin = 0; fin <= n; fin++ ){
+		for( debut = 0; debut <= fin; debut++ ){
+			if( est_occurrence( automate, texte, debut, fin ) ){
+				if(
+					k >= nb || occurrences[k].debut != debut ||
+					occurrences[k].fin != fin
+				) ok = 0;
+				k++;
+				break;
+			}
+		}
+	}
+	if( k != nb ) ok = 0;
+	xfree( occurrences );
+	return ok;
+}
+
+int test_recherche(){
+
+	int result = 1;
+	int i, j;
+
+	Automate * automates[3];
+
+	// ab*c + b
+	automates[0] = creer_automate();
+	ajouter_etat_initial( automates[0], 0 );
+	ajouter_transition( automates[0], 0, 'a', 1 );
+	ajouter_transition( automates[0], 1, 'b', 1 );
+	ajouter_transition( automates[0], 1, 'c', 2 );
+	ajouter_transition( automates[0], 0, 'b', 3 );
+	ajouter_etat_final( automates[0], 2 );
+	ajouter_etat_final( automates[0], 3 );
+
+	// (a+b)*a(a+b), non déterministe
+	automates[1] = creer_automate();
+	ajouter_etat_initial( automates[1], 0 );
+	ajouter_transition( automates[1], 0, 'a', 0 );
+	ajouter_transition( automates[1], 0, 'b', 0 );
+	ajouter_transition( automates[1], 0, 'a', 1 );
+	ajouter_transition( automates[1], 1, 'a', 2 );
+	ajouter_transition( automates[1], 1, 'b', 2 );
+	ajouter_etat_final( automates[1], 2 );
+
+	// c*, qui contient le mot vide
+	automates[2] = creer_automate();
+	ajouter_etat_initial( automates[2], 0 );
+	ajouter_etat_final( automates[2], 0 );
+	ajouter_transition( automates[2], 0, 'c', 0 );
+
+	srand( 17 );
+	for( i = 0; i < 3; i++ ){
+		Recherche * recherche = creer_recherche( automates[i] );
+		int ok = 1;
+		ok = ok && verifier_recherche( automates[i], recherche, "" );
+		ok = ok && verifier_recherche( automates[i], recherche, "xabbcxbab" );
+		for( j = 0; j < 50 && ok; j++ ){
+			char texte[ LONGUEUR_TEXTE + 1 ];
+			int n = rand() % LONGUEUR_TEXTE, k;
+			for( k = 0; k < n; k++ ) texte[k] = "abcx"[ rand() % 4 ];
+			texte[n] = '\0';
+			ok = verifier_recherche( automates[i], recherche, texte );
+		}
+		TEST( ok, result );
+		liberer_recherche( recherche );
+	}
+
+	// Les '\0' du texte sont des octets comme les autres
+	{
+		Recherche * recherche = creer_recherche( automates[0] );
+		Occurrence occurrence;
+		int ok = rechercher_premiere( recherche, "\0\0abbc", 6, &occurrence );
+		TEST(
+			1
+			&& ok
+			&& occurrence.debut == 2
+			&& occurrence.fin == 6
+			, result
+		);
+		liberer_recherche( recherche );
+	}
+
+	// Langage vide : aucune occurrence
+	{
+		Automate * vide = creer_automate();
+		ajouter_etat_initial( vide, 0 );
+		ajouter_transition( vide, 0, 'a', 1 );
+		Recherche * recherche = creer_recherche( vide );
+		Occurrence occurrence, * occurrences;
+		int trouve = rechercher_premiere( recherche, "aaa", 3, &occurrence );
+		size_t nb = rechercher_toutes(
+			recherche, "aaa", 3, RECHERCHE_CHEVAUCHANTES, &occurrences
+		);
+		TEST( ! trouve && nb == 0, result );
+		xfree( occurrences );
+		liberer_recherche( recherche );
+		liberer_automate( vide );
+	}
+
+	for( i = 0; i < 3; i++ ) liberer_automate( automates[i] );
+
+	return result;
+}
+
+
+
+int main(){
+
+	if( ! test_recherche() ){ return 1; }
+
+	return 0;
+}
@@ -0,0 +1,163 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "sauvegarde.h"
+#include "equivalence.h"
+#include "outils.h"
+
+#include <stdio.h>
+
+#define FICHIER_AUTOMATE "test_sauvegarde_automate.bin"
+#define FICHIER_AFD "test_sauvegarde_afd.bin"
+
+/*
+ * Modifie l'octet à la position donnée d'un fichier, ou le tronque à cette
+ * position si 'tronquer' vaut 1.
+ */
+int alterer_fichier( const char * chemin, long position, int tronquer ){
+	FILE * f = fopen( chemin, "rb" );
+	if( ! f ) return 0;
+	char contenu[1 << 16];
+	size_t taille = fread( contenu, 1, sizeof(contenu), f );
+	fclose( f );
+	if( position >= (long) taille ) return 0;
+	if( tronquer ){
+		taille = position;
+	}else{
+		contenu[ position ] ^= 0x01;
+	}
+	f = fopen( chemin, "wb" );
+	if( ! f ) return 0;
+	fwrite( contenu, 1, taille, f );
+	fclose( f );
+	return 1;
+}
+
+int test_sauvegarde(){
+
+	int result = 1;
+
+	// Mots sur {a, b, é} dont l'avant-dernière lettre est un 'a', avec un
+	// état isolé, un état négatif et une lettre sans transition
+	Automate * automate = creer_automate();
+	ajouter_etat_initial( automate, -1 );
+	ajouter_etat_final( automate, 2 );
+	ajouter_transition( automate, -1, 'a', -1 );
+	ajouter_transition( automate, -1, 'b', -1 );
+	ajouter_transition( automate, -1, (char) 0xe9, -1 );
+	ajouter_transition( automate, -1, 'a', 1 );
+	ajouter_transition( automate, 1, 'a', 2 );
+	ajouter_transition( automate, 1, 'b', 2 );
+	ajouter_etat( automate, 7 );
+	ajouter_lettre( automate, 'z' );
+
+	TEST( sauvegarder_automate( automate, FICHIER_AUTOMATE ), result );
+	Automate * charge = charger_automate( FICHIER_AUTOMATE );
+	TEST(
+		1
+		&& charge
+		&& comparer_ensemble( get_etats( charge ), get_etats( automate ) ) == 0
+		&& comparer_ensemble( get_initiaux( charge ), get_initiaux( automate ) ) == 0
+		&& comparer_ensemble( get_finaux( charge ), get_finaux( automate ) ) == 0
+		&& comparer_ensemble( get_alphabet( charge ), get_alphabet( automate ) ) == 0
+		&& nombre_de_transitions( charge ) == nombre_de_transitions( automate )
+		&& automates_equivalents( charge, automate, NULL )
+		, result
+	);
+	if( charge ) liberer_automate( charge );
+
+	// Un fichier d'Automate n'est pas un fichier d'Afd
+	TEST( projeter_afd( FICHIER_AUTOMATE, 1 ) == NULL, result );
+
+	// Fichier corrompu, puis tronqué
+	{
+		int altere = alterer_fichier( FICHIER_AUTOMATE, 150, 0 );
+		Automate * corrompu = charger_automate( FICHIER_AUTOMATE );
+		int tronque = alterer_fichier( FICHIER_AUTOMATE, 70, 1 );
+		Automate * incomplet = charger_automate( FICHIER_AUTOMATE );
+		remove( FICHIER_AUTOMATE );
+		Automate * absent = charger_automate( FICHIER_AUTOMATE );
+		TEST(
+			1
+			&& altere && corrompu == NULL
+			&& tronque && incomplet == NULL
+			&& absent == NULL
+			, result
+		);
+	}
+
+	// Afd projeté en mémoire
+	Automate * deterministe = creer_automate_deterministe( automate );
+	Afd * afd = creer_afd( deterministe );
+	TEST( sauvegarder_afd( afd, FICHIER_AFD ), result );
+	int verifier;
+	for( verifier = 0; verifier <= 1; verifier++ ){
+		Afd * projete = projeter_afd( FICHIER_AFD, verifier );
+		TEST(
+			1
+			&& projete
+			&& projete->projection != NULL
+			&& projete->nb_etats == afd->nb_etats
+			&& projete->nb_classes == afd->nb_classes
+			&& afd_reconnait( projete, "ab" )
+			&& afd_reconnait( projete, "\xe9" "aa" )
+			&& ! afd_reconnait( projete, "aba" )
+			&& ! afd_reconnait( projete, "az" )
+			, result
+		);
+		if( projete ) liberer_afd( projete );
+	}
+
+	// Une transition hors de la table est détectée par la vérification,
+	// comme la somme de contrôle fausse ; sans vérification, seul l'entête
+	// est lu.
+	{
+		FILE * f = fopen( FICHIER_AFD, "rb" );
+		unsigned char entete[ 64 + 16 * 5 ];
+		int lu = f && fread( entete, 1, sizeof(entete), f ) == sizeof(entete);
+		if( f ) fclose( f );
+		long suivant = lu ? entete[ 64 + 16*2 ] | ( entete[ 64 + 16*2 + 1 ] << 8 ) : 0;
+		int altere = lu && alterer_fichier( FICHIER_AFD, suivant + 2, 0 );
+		Afd * sans_verification = projeter_afd( FICHIER_AFD, 0 );
+		Afd * avec_verification = projeter_afd( FICHIER_AFD, 1 );
+		TEST(
+			1
+			&& altere
+			&& sans_verification != NULL
+			&& avec_verification == NULL
+			, result
+		);
+		if( sans_verification ) liberer_afd( sans_verification );
+	}
+	remove( FICHIER_AFD );
+
+	liberer_afd( afd );
+	liberer_automate( deterministe );
+	liberer_automate( automate );
+
+	return result;
+}
+
+
+
+int main(){
+
+	if( ! test_sauvegarde() ){ return 1; }
+
+	return 0;
+}